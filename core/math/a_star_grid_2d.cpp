@@ -30,6 +30,7 @@
 
 #include "a_star_grid_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
@@ -107,18 +108,19 @@ Size2 AStarGrid2D::get_cell_size() const {
 }
 
 void AStarGrid2D::update() {
-	points.clear();
+	const uint32_t cell_count = region.size.x * region.size.y;
 
-	const int32_t end_x = region.get_end().x;
-	const int32_t end_y = region.get_end().y;
-
-	for (int32_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
-		for (int32_t x = region.position.x; x < end_x; x++) {
-			line.push_back(Point(Vector2i(x, y), offset + Vector2(x, y) * cell_size));
-		}
-		points.push_back(line);
+	solid_mask.clear();
+	solid_mask.resize((cell_count + 63) / 64);
+	if (solid_mask.size()) {
+		memset(solid_mask.ptr(), 0, solid_mask.size() * sizeof(uint64_t));
 	}
+	weight_scales.clear();
+
+	jump_distances.clear();
+	jump_distances_dirty = true;
+
+	search_state = SearchState();
 
 	dirty = false;
 }
@@ -145,7 +147,10 @@ bool AStarGrid2D::is_jumping_enabled() const {
 
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
-	diagonal_mode = p_diagonal_mode;
+	if (diagonal_mode != p_diagonal_mode) {
+		diagonal_mode = p_diagonal_mode;
+		jump_distances_dirty = true;
+	}
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -173,26 +178,33 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_estimate_heuristic() const {
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
-	_get_point_unchecked(p_id)->solid = p_solid;
+	_set_cell_solid(_get_cell(p_id.x, p_id.y), p_solid);
+	jump_distances_dirty = true;
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is disabled. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->solid;
+	return _is_cell_solid(_get_cell(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point %s out of bounds %s.", p_id, region));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
-	_get_point_unchecked(p_id)->weight_scale = p_weight_scale;
+	if (weight_scales.is_empty()) {
+		if (p_weight_scale == 1.0) {
+			return;
+		}
+		_allocate_weight_scales();
+	}
+	weight_scales[_get_cell(p_id.x, p_id.y)] = p_weight_scale;
 }
 
 real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, 0, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), 0, vformat("Can't get point's weight scale. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->weight_scale;
+	return _get_cell_weight_scale(_get_cell(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
@@ -204,9 +216,10 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->solid = p_solid;
+			_set_cell_solid(_get_cell(x, y), p_solid);
 		}
 	}
+	jump_distances_dirty = true;
 }
 
 void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weight_scale) {
@@ -217,163 +230,200 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	const int32_t end_x = safe_region.get_end().x;
 	const int32_t end_y = safe_region.get_end().y;
 
+	if (weight_scales.is_empty()) {
+		if (p_weight_scale == 1.0 || !safe_region.has_area()) {
+			return;
+		}
+		_allocate_weight_scales();
+	}
+
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->weight_scale = p_weight_scale;
+			weight_scales[_get_cell(x, y)] = p_weight_scale;
 		}
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	if (!p_to || p_to->solid) {
-		return nullptr;
+void AStarGrid2D::_allocate_weight_scales() {
+	weight_scales.resize(region.size.x * region.size.y);
+	for (real_t &weight_scale : weight_scales) {
+		weight_scale = 1.0;
 	}
-	if (p_to == end) {
-		return p_to;
+}
+
+// Straight directions are indexed as +x, -x, +y, -y in the jump distance table.
+static _FORCE_INLINE_ uint32_t get_straight_direction(int32_t p_dx, int32_t p_dy) {
+	if (p_dx != 0) {
+		return p_dx > 0 ? 0 : 1;
 	}
+	return p_dy > 0 ? 2 : 3;
+}
 
-	int32_t from_x = p_from->id.x;
-	int32_t from_y = p_from->id.y;
+bool AStarGrid2D::_is_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+		if (p_dx != 0) {
+			return (_is_walkable(p_x + p_dx, p_y + 1) && !_is_walkable(p_x, p_y + 1)) || (_is_walkable(p_x + p_dx, p_y - 1) && !_is_walkable(p_x, p_y - 1));
+		}
+		return (_is_walkable(p_x + 1, p_y + p_dy) && !_is_walkable(p_x + 1, p_y)) || (_is_walkable(p_x - 1, p_y + p_dy) && !_is_walkable(p_x - 1, p_y));
+	}
 
-	int32_t to_x = p_to->id.x;
-	int32_t to_y = p_to->id.y;
+	// DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES and DIAGONAL_MODE_NEVER look behind for the obstacles that were passed.
+	if (p_dx != 0) {
+		return (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1)) || (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1));
+	}
+	return (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy)) || (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy));
+}
 
-	int32_t dx = to_x - from_x;
-	int32_t dy = to_y - from_y;
+void AStarGrid2D::_update_jump_distances() {
+	const int32_t end_x = region.get_end().x;
+	const int32_t end_y = region.get_end().y;
 
-	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
-					return p_to;
-				}
-			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+	jump_distances.resize(region.size.x * region.size.y * 4);
+
+	// Each entry continues the one of the next cell in the same direction, past the region edge counts as solid.
+	for (int32_t y = region.position.y; y < end_y; y++) {
+		uint32_t distance = 0;
+		for (int32_t x = end_x - 1; x >= region.position.x; x--) {
+			const uint32_t cell = _get_cell(x, y);
+			distance = _is_cell_solid(cell) ? 0 : (_is_jump_point(x, y, 1, 0) ? 1 : distance + 2);
+			jump_distances[cell * 4 + 0] = distance;
 		}
-	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
-					return p_to;
-				}
-			}
+		distance = 0;
+		for (int32_t x = region.position.x; x < end_x; x++) {
+			const uint32_t cell = _get_cell(x, y);
+			distance = _is_cell_solid(cell) ? 0 : (_is_jump_point(x, y, -1, 0) ? 1 : distance + 2);
+			jump_distances[cell * 4 + 1] = distance;
 		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+	}
+	for (int32_t x = region.position.x; x < end_x; x++) {
+		uint32_t distance = 0;
+		for (int32_t y = end_y - 1; y >= region.position.y; y--) {
+			const uint32_t cell = _get_cell(x, y);
+			distance = _is_cell_solid(cell) ? 0 : (_is_jump_point(x, y, 0, 1) ? 1 : distance + 2);
+			jump_distances[cell * 4 + 2] = distance;
 		}
-	} else { // DIAGONAL_MODE_NEVER
-		if (dx != 0) {
-			if ((_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1)) || (_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1))) {
-				return p_to;
-			}
-		} else if (dy != 0) {
-			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
-				return p_to;
-			}
+		distance = 0;
+		for (int32_t y = region.position.y; y < end_y; y++) {
+			const uint32_t cell = _get_cell(x, y);
+			distance = _is_cell_solid(cell) ? 0 : (_is_jump_point(x, y, 0, -1) ? 1 : distance + 2);
+			jump_distances[cell * 4 + 3] = distance;
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
 	}
-	return nullptr;
+
+	jump_distances_dirty = false;
 }
 
-void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
-	bool ts0 = false, td0 = false,
-		 ts1 = false, td1 = false,
-		 ts2 = false, td2 = false,
-		 ts3 = false, td3 = false;
+void AStarGrid2D::_prepare_solve() {
+	if (jumping_enabled && jump_distances_dirty) {
+		_update_jump_distances();
+	}
+}
 
-	Point *left = nullptr;
-	Point *right = nullptr;
-	Point *top = nullptr;
-	Point *bottom = nullptr;
+uint32_t AStarGrid2D::_jump_straight(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, const Vector2i &p_end) const {
+	if (!_is_walkable(p_x, p_y)) {
+		return UINT32_MAX;
+	}
 
-	Point *top_left = nullptr;
-	Point *top_right = nullptr;
-	Point *bottom_left = nullptr;
-	Point *bottom_right = nullptr;
+	const uint32_t entry = jump_distances[_get_cell(p_x, p_y) * 4 + get_straight_direction(p_dx, p_dy)];
+	const int32_t distance = entry >> 1;
 
-	{
-		bool has_left = false;
-		bool has_right = false;
+	// The end point is found before the jump points past it.
+	int32_t end_distance = -1;
+	if (p_dx != 0 && p_end.y == p_y) {
+		end_distance = (p_end.x - p_x) * p_dx;
+	} else if (p_dy != 0 && p_end.x == p_x) {
+		end_distance = (p_end.y - p_y) * p_dy;
+	}
+	if (end_distance >= 0 && end_distance <= distance) {
+		return _get_cell(p_end.x, p_end.y);
+	}
 
-		if (p_point->id.x - 1 >= region.position.x) {
-			left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y);
-			has_left = true;
+	if (entry & 1) {
+		return _get_cell(p_x + p_dx * distance, p_y + p_dy * distance);
+	}
+	return UINT32_MAX;
+}
+
+uint32_t AStarGrid2D::_jump(const Vector2i &p_from, const Vector2i &p_to, const Vector2i &p_end) const {
+	int32_t to_x = p_to.x;
+	int32_t to_y = p_to.y;
+
+	const int32_t dx = to_x - p_from.x;
+	const int32_t dy = to_y - p_from.y;
+
+	if (dy == 0 || (dx == 0 && diagonal_mode != DIAGONAL_MODE_NEVER)) {
+		return _jump_straight(to_x, to_y, dx, dy, p_end);
+	}
+
+	while (true) {
+		if (!_is_walkable(to_x, to_y)) {
+			return UINT32_MAX;
 		}
-		if (p_point->id.x + 1 < region.position.x + region.size.width) {
-			right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y);
-			has_right = true;
+
+		const uint32_t cell = _get_cell(to_x, to_y);
+		if (to_x == p_end.x && to_y == p_end.y) {
+			return cell;
 		}
-		if (p_point->id.y - 1 >= region.position.y) {
-			top = _get_point_unchecked(p_point->id.x, p_point->id.y - 1);
-			if (has_left) {
-				top_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y - 1);
+
+		if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
+				return cell;
 			}
-			if (has_right) {
-				top_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y - 1);
+			if (_jump_straight(to_x + dx, to_y, dx, 0, p_end) != UINT32_MAX || _jump_straight(to_x, to_y + dy, 0, dy, p_end) != UINT32_MAX) {
+				return cell;
 			}
-		}
-		if (p_point->id.y + 1 < region.position.y + region.size.height) {
-			bottom = _get_point_unchecked(p_point->id.x, p_point->id.y + 1);
-			if (has_left) {
-				bottom_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y + 1);
+			if (!_is_walkable(to_x + dx, to_y + dy) || (diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE && !_is_walkable(to_x + dx, to_y) && !_is_walkable(to_x, to_y + dy))) {
+				return UINT32_MAX;
+			}
+		} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
+			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
+				return cell;
+			}
+			if (_jump_straight(to_x + dx, to_y, dx, 0, p_end) != UINT32_MAX || _jump_straight(to_x, to_y + dy, 0, dy, p_end) != UINT32_MAX) {
+				return cell;
+			}
+			if (!_is_walkable(to_x + dx, to_y + dy) || !_is_walkable(to_x + dx, to_y) || !_is_walkable(to_x, to_y + dy)) {
+				return UINT32_MAX;
+			}
+		} else { // DIAGONAL_MODE_NEVER, only vertical moves get here as they also look for jump points on both sides.
+			if (_is_jump_point(to_x, to_y, 0, dy)) {
+				return cell;
 			}
-			if (has_right) {
-				bottom_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y + 1);
+			if (_jump_straight(to_x + 1, to_y, 1, 0, p_end) != UINT32_MAX || _jump_straight(to_x - 1, to_y, -1, 0, p_end) != UINT32_MAX) {
+				return cell;
 			}
 		}
+
+		to_x += dx;
+		to_y += dy;
 	}
+}
+
+void AStarGrid2D::_get_nbors(const Vector2i &p_id, LocalVector<Vector2i> &r_nbors) const {
+	bool ts0 = false, td0 = false,
+		 ts1 = false, td1 = false,
+		 ts2 = false, td2 = false,
+		 ts3 = false, td3 = false;
+
+	const bool has_left = p_id.x - 1 >= region.position.x;
+	const bool has_right = p_id.x + 1 < region.position.x + region.size.width;
+	const bool has_top = p_id.y - 1 >= region.position.y;
+	const bool has_bottom = p_id.y + 1 < region.position.y + region.size.height;
 
-	if (top && !top->solid) {
-		r_nbors.push_back(top);
+	if (has_top && !_is_cell_solid(_get_cell(p_id.x, p_id.y - 1))) {
+		r_nbors.push_back(Vector2i(p_id.x, p_id.y - 1));
 		ts0 = true;
 	}
-	if (right && !right->solid) {
-		r_nbors.push_back(right);
+	if (has_right && !_is_cell_solid(_get_cell(p_id.x + 1, p_id.y))) {
+		r_nbors.push_back(Vector2i(p_id.x + 1, p_id.y));
 		ts1 = true;
 	}
-	if (bottom && !bottom->solid) {
-		r_nbors.push_back(bottom);
+	if (has_bottom && !_is_cell_solid(_get_cell(p_id.x, p_id.y + 1))) {
+		r_nbors.push_back(Vector2i(p_id.x, p_id.y + 1));
 		ts2 = true;
 	}
-	if (left && !left->solid) {
-		r_nbors.push_back(left);
+	if (has_left && !_is_cell_solid(_get_cell(p_id.x - 1, p_id.y))) {
+		r_nbors.push_back(Vector2i(p_id.x - 1, p_id.y));
 		ts3 = true;
 	}
 
@@ -402,84 +452,109 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !top_left->solid)) {
-		r_nbors.push_back(top_left);
+	if (td0 && has_top && has_left && !_is_cell_solid(_get_cell(p_id.x - 1, p_id.y - 1))) {
+		r_nbors.push_back(Vector2i(p_id.x - 1, p_id.y - 1));
 	}
-	if (td1 && (top_right && !top_right->solid)) {
-		r_nbors.push_back(top_right);
+	if (td1 && has_top && has_right && !_is_cell_solid(_get_cell(p_id.x + 1, p_id.y - 1))) {
+		r_nbors.push_back(Vector2i(p_id.x + 1, p_id.y - 1));
 	}
-	if (td2 && (bottom_right && !bottom_right->solid)) {
-		r_nbors.push_back(bottom_right);
+	if (td2 && has_bottom && has_right && !_is_cell_solid(_get_cell(p_id.x + 1, p_id.y + 1))) {
+		r_nbors.push_back(Vector2i(p_id.x + 1, p_id.y + 1));
 	}
-	if (td3 && (bottom_left && !bottom_left->solid)) {
-		r_nbors.push_back(bottom_left);
+	if (td3 && has_bottom && has_left && !_is_cell_solid(_get_cell(p_id.x - 1, p_id.y + 1))) {
+		r_nbors.push_back(Vector2i(p_id.x - 1, p_id.y + 1));
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
-	pass++;
+bool AStarGrid2D::_solve(SearchState &r_state, const Vector2i &p_begin, const Vector2i &p_end) {
+	const uint32_t cell_count = region.size.x * region.size.y;
+	if (r_state.cells.size() != cell_count) {
+		r_state.cells.clear();
+		r_state.cells.resize(cell_count);
+		r_state.pass = 0;
+	}
+
+	r_state.pass++;
+	if (r_state.pass == 0) { // Wrapped around, the old passes could be taken for the current one.
+		for (SearchCell &search_cell : r_state.cells) {
+			search_cell.open_pass = 0;
+			search_cell.closed_pass = 0;
+		}
+		r_state.pass = 1;
+	}
+	const uint32_t pass = r_state.pass;
 
-	if (p_end_point->solid) {
+	const uint32_t begin_cell = _get_cell(p_begin.x, p_begin.y);
+	const uint32_t end_cell = _get_cell(p_end.x, p_end.y);
+
+	if (_is_cell_solid(end_cell)) {
 		return false;
 	}
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	SearchCell *cells = r_state.cells.ptr();
+	LocalVector<uint32_t> &open_list = r_state.open_list;
+	SortArray<uint32_t, SortCells> sorter;
+	sorter.compare.cells = cells;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	open_list.clear();
+	cells[begin_cell].g_score = 0;
+	cells[begin_cell].f_score = _estimate_cost(p_begin, p_end);
+	open_list.push_back(begin_cell);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const uint32_t p = open_list[0]; // The currently processed cell.
 
-		if (p == p_end_point) {
+		if (p == end_cell) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current cell from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		cells[p].closed_pass = pass; // Mark the cell as closed.
 
-		LocalVector<Point *> nbors;
-		_get_nbors(p, nbors);
+		const Vector2i p_id = _get_cell_id(p);
+		r_state.nbors.clear();
+		_get_nbors(p_id, r_state.nbors);
 
-		for (Point *e : nbors) {
+		for (const Vector2i &nbor_id : r_state.nbors) {
+			Vector2i e_id = nbor_id;
+			uint32_t e;
 			real_t weight_scale = 1.0;
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(p_id, nbor_id, p_end);
+				if (e == UINT32_MAX || cells[e].closed_pass == pass) {
 					continue;
 				}
+				e_id = _get_cell_id(e);
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				e = _get_cell(nbor_id.x, nbor_id.y);
+				if (cells[e].closed_pass == pass) {
 					continue;
 				}
-				weight_scale = e->weight_scale;
+				weight_scale = _get_cell_weight_scale(e);
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			real_t tentative_g_score = cells[p].g_score + _compute_cost(p_id, e_id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (cells[e].open_pass != pass) { // The cell wasn't inside the open list.
+				cells[e].open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= cells[e].g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			cells[e].prev_cell = p;
+			cells[e].g_score = tentative_g_score;
+			cells[e].f_score = tentative_g_score + _estimate_cost(e_id, p_end);
 
-			if (new_point) { // The position of the new points is already known.
+			if (new_point) { // The position of the new cells is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
 			} else {
 				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
@@ -490,6 +565,33 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 	return found_route;
 }
 
+void AStarGrid2D::_get_solved_id_path(const SearchState &p_state, const Vector2i &p_begin, const Vector2i &p_end, LocalVector<Vector2i> &r_path) const {
+	const uint32_t begin_cell = _get_cell(p_begin.x, p_begin.y);
+
+	uint32_t cell = _get_cell(p_end.x, p_end.y);
+	while (cell != begin_cell) {
+		r_path.push_back(_get_cell_id(cell));
+		cell = p_state.cells[cell].prev_cell;
+	}
+	r_path.push_back(p_begin);
+	r_path.invert();
+}
+
+void AStarGrid2D::_solve_batch(uint32_t p_index, SearchBatch *p_batch) {
+	SearchState &state = p_index == 0 ? search_state : p_batch->states[p_index - 1];
+
+	for (uint32_t i = p_index; i < p_batch->from_ids.size(); i += p_batch->task_count) {
+		const Vector2i &from_id = p_batch->from_ids[i];
+		const Vector2i &to_id = p_batch->to_ids[i];
+
+		if (from_id == to_id) {
+			p_batch->paths[i].push_back(from_id);
+		} else if (_solve(state, from_id, to_id)) {
+			_get_solved_id_path(state, from_id, to_id, p_batch->paths[i]);
+		}
+	}
+}
+
 real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
@@ -507,14 +609,18 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 }
 
 void AStarGrid2D::clear() {
-	points.clear();
+	solid_mask.clear();
+	weight_scales.clear();
+	jump_distances.clear();
+	jump_distances_dirty = true;
+	search_state = SearchState();
 	region = Rect2i();
 }
 
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, Vector2(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->pos;
+	return offset + Vector2(p_id) * cell_size;
 }
 
 Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
@@ -522,44 +628,30 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
+	if (p_from_id == p_to_id) {
 		Vector<Vector2> ret;
-		ret.push_back(a->pos);
+		ret.push_back(get_point_position(p_from_id));
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	_prepare_solve();
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(search_state, p_from_id, p_to_id);
 	if (!found_route) {
 		return Vector<Vector2>();
 	}
 
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
+	LocalVector<Vector2i> id_path;
+	_get_solved_id_path(search_state, p_from_id, p_to_id, id_path);
 
 	Vector<Vector2> path;
-	path.resize(pc);
+	path.resize(id_path.size());
 
 	{
 		Vector2 *w = path.ptrw();
-
-		p = end_point;
-		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		for (uint32_t i = 0; i < id_path.size(); i++) {
+			w[i] = offset + Vector2(id_path[i]) * cell_size;
 		}
-
-		w[0] = p->pos;
 	}
 
 	return path;
@@ -570,45 +662,77 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
+	if (p_from_id == p_to_id) {
 		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
+		ret.push_back(p_from_id);
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	_prepare_solve();
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(search_state, p_from_id, p_to_id);
 	if (!found_route) {
 		return TypedArray<Vector2i>();
 	}
 
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
+	LocalVector<Vector2i> id_path;
+	_get_solved_id_path(search_state, p_from_id, p_to_id, id_path);
 
 	TypedArray<Vector2i> path;
-	path.resize(pc);
+	path.resize(id_path.size());
+	for (uint32_t i = 0; i < id_path.size(); i++) {
+		path[i] = id_path[i];
+	}
 
-	{
-		p = end_point;
-		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
-		}
+	return path;
+}
 
-		path[0] = p->id;
+TypedArray<Array> AStarGrid2D::get_id_paths_batch(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids) {
+	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Array>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<Array>(), vformat("Can't get id paths. There are %d starting points for %d ending points.", p_from_ids.size(), p_to_ids.size()));
+
+	SearchBatch batch;
+	batch.from_ids.resize(p_from_ids.size());
+	batch.to_ids.resize(p_to_ids.size());
+	batch.paths.resize(p_from_ids.size());
+	for (uint32_t i = 0; i < batch.from_ids.size(); i++) {
+		batch.from_ids[i] = p_from_ids[i];
+		batch.to_ids[i] = p_to_ids[i];
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(batch.from_ids[i]), TypedArray<Array>(), vformat("Can't get id paths. Point %s out of bounds %s.", batch.from_ids[i], region));
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(batch.to_ids[i]), TypedArray<Array>(), vformat("Can't get id paths. Point %s out of bounds %s.", batch.to_ids[i], region));
 	}
 
-	return path;
+	_prepare_solve();
+
+	// Scripted costs have to be computed on the calling thread.
+	const bool use_threads = !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost);
+	if (use_threads) {
+		batch.task_count = CLAMP(batch.from_ids.size(), 1u, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+	}
+
+	// Each task solves its share of the paths with its own search state. The first task reuses the one
+	// of the single path queries, the others only live for this call as they are as large as the grid.
+	batch.states.resize(batch.task_count - 1);
+
+	if (batch.task_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStarGrid2D::_solve_batch, &batch, batch.task_count, -1, true, SNAME("AStarGrid2DSolveBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_solve_batch(0, &batch);
+	}
+
+	TypedArray<Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		TypedArray<Vector2i> path;
+		path.resize(batch.paths[i].size());
+		for (uint32_t j = 0; j < batch.paths[i].size(); j++) {
+			path[j] = batch.paths[i][j];
+		}
+		paths[i] = path;
+	}
+
+	return paths;
 }
 
 void AStarGrid2D::_bind_methods() {
@@ -643,6 +767,7 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths_batch", "from_ids", "to_ids"), &AStarGrid2D::get_id_paths_batch);
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
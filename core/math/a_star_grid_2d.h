@@ -67,73 +67,99 @@ private:
 	Heuristic default_compute_heuristic = HEURISTIC_EUCLIDEAN;
 	Heuristic default_estimate_heuristic = HEURISTIC_EUCLIDEAN;
 
-	struct Point {
-		Vector2i id;
+	/// One bit per cell, set when the cell is solid.
+	LocalVector<uint64_t> solid_mask;
+	/// Empty as long as every cell has the default weight scale of 1.0.
+	LocalVector<real_t> weight_scales;
 
-		bool solid = false;
-		Vector2 pos;
-		real_t weight_scale = 1.0;
+	/// JPS+ table, for each cell and straight direction: the number of steps to the next jump point or solid cell,
+	/// shifted left by one, with the lowest bit set when it is a jump point.
+	LocalVector<uint32_t> jump_distances;
+	bool jump_distances_dirty = true;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+	struct SearchCell {
 		real_t g_score = 0;
 		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
-
-		Point() {}
+		uint32_t prev_cell = 0;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
+	};
 
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
+	// Everything a single search writes to, so several searches can run on the same grid at once.
+	struct SearchState {
+		LocalVector<SearchCell> cells;
+		LocalVector<uint32_t> open_list;
+		LocalVector<Vector2i> nbors;
+		uint32_t pass = 0;
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+	struct SortCells {
+		const SearchCell *cells = nullptr;
+
+		_FORCE_INLINE_ bool operator()(uint32_t A, uint32_t B) const { // Returns true when the cell A is worse than cell B.
+			if (cells[A].f_score > cells[B].f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (cells[A].f_score < cells[B].f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return cells[A].g_score < cells[B].g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
-	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
+	struct SearchBatch {
+		LocalVector<Vector2i> from_ids;
+		LocalVector<Vector2i> to_ids;
+		LocalVector<LocalVector<Vector2i>> paths;
+		LocalVector<SearchState> states; // For the tasks after the first one, released with the batch.
+		uint32_t task_count = 1;
+	};
 
-	uint64_t pass = 1;
+	SearchState search_state;
 
 private: // Internal routines.
-	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return !points[p_y - region.position.y][p_x - region.position.x].solid;
-		}
-		return false;
+	_FORCE_INLINE_ uint32_t _get_cell(int32_t p_x, int32_t p_y) const {
+		return (p_y - region.position.y) * region.size.x + (p_x - region.position.x);
 	}
 
-	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
-		}
-		return nullptr;
+	_FORCE_INLINE_ Vector2i _get_cell_id(uint32_t p_cell) const {
+		return Vector2i(region.position.x + p_cell % region.size.x, region.position.y + p_cell / region.size.x);
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
+	_FORCE_INLINE_ bool _is_cell_solid(uint32_t p_cell) const {
+		return (solid_mask[p_cell >> 6] >> (p_cell & 63)) & 1;
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(const Vector2i &p_id) {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+	_FORCE_INLINE_ void _set_cell_solid(uint32_t p_cell, bool p_solid) {
+		if (p_solid) {
+			solid_mask[p_cell >> 6] |= uint64_t(1) << (p_cell & 63);
+		} else {
+			solid_mask[p_cell >> 6] &= ~(uint64_t(1) << (p_cell & 63));
+		}
 	}
 
-	_FORCE_INLINE_ const Point *_get_point_unchecked(const Vector2i &p_id) const {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+	_FORCE_INLINE_ real_t _get_cell_weight_scale(uint32_t p_cell) const {
+		return weight_scales.is_empty() ? 1.0 : weight_scales[p_cell];
 	}
 
-	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point);
+	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
+		if (region.has_point(Vector2i(p_x, p_y))) {
+			return !_is_cell_solid(_get_cell(p_x, p_y));
+		}
+		return false;
+	}
+
+	void _allocate_weight_scales();
+	bool _is_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	void _update_jump_distances();
+	void _prepare_solve();
+
+	void _get_nbors(const Vector2i &p_id, LocalVector<Vector2i> &r_nbors) const;
+	uint32_t _jump_straight(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, const Vector2i &p_end) const;
+	uint32_t _jump(const Vector2i &p_from, const Vector2i &p_to, const Vector2i &p_end) const;
+	bool _solve(SearchState &r_state, const Vector2i &p_begin, const Vector2i &p_end);
+	void _get_solved_id_path(const SearchState &p_state, const Vector2i &p_begin, const Vector2i &p_end, LocalVector<Vector2i> &r_path) const;
+	void _solve_batch(uint32_t p_index, SearchBatch *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -189,6 +215,7 @@ public:
 	Vector2 get_point_position(const Vector2i &p_id) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to);
+	TypedArray<Array> get_id_paths_batch(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids);
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
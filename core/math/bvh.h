@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -71,6 +72,12 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// When at least this many items changed since the last collision check, the culling part of
+	// pairing is spread over the WorkerThreadPool. 0 (default) always checks on the calling thread.
+	void params_set_pairing_thread_threshold(uint32_t p_threshold) {
+		_pairing_thread_threshold = p_threshold;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -435,6 +442,11 @@ private:
 			return;
 		}
 
+		if (_pairing_thread_threshold && changed_items.size() >= _pairing_thread_threshold && WorkerThreadPool::get_singleton()) {
+			_check_for_collisions_threaded(p_full_check);
+			return;
+		}
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -480,6 +492,82 @@ private:
 		_reset();
 	}
 
+	// Culling the changed items against the tree doesn't modify anything, so it's done in parallel.
+	// Pairs are then created and removed on the calling thread, in the same order as
+	// _check_for_collisions(), so callbacks are identical whether threaded or not.
+	void _check_for_collisions_threaded(bool p_full_check) {
+		const uint32_t item_count = changed_items.size();
+		const uint32_t chunk_count = MIN(item_count, MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4u);
+
+		_pair_cull_chunks.resize(chunk_count);
+		uint32_t first_item = 0;
+		for (uint32_t c = 0; c < chunk_count; c++) {
+			PairCullChunk &chunk = _pair_cull_chunks[c];
+			chunk.first_item = first_item;
+			chunk.item_count = (item_count - first_item) / (chunk_count - c);
+			first_item += chunk.item_count;
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&BVH_Manager::_pair_cull_chunk_task, this, chunk_count, -1, true, "BVHPairCull");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (const PairCullChunk &chunk : _pair_cull_chunks) {
+			uint32_t hit_from = 0;
+			for (uint32_t n = 0; n < chunk.item_count; n++) {
+				const BVHHandle &h = changed_items[chunk.first_item + n];
+
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+				_find_leavers(h, abb, p_full_check);
+
+				const uint32_t hit_to = chunk.hit_ends[n];
+				for (uint32_t i = hit_from; i < hit_to; i++) {
+					BVHHandle h_collidee;
+					h_collidee.set_id(chunk.hits[i]);
+					_collide(h, h_collidee);
+				}
+				hit_from = hit_to;
+			}
+		}
+		_reset();
+	}
+
+	static void _pair_cull_chunk_task(void *p_self, uint32_t p_chunk) {
+		BVH_Manager *self = static_cast<BVH_Manager *>(p_self);
+		PairCullChunk &chunk = self->_pair_cull_chunks[p_chunk];
+		chunk.hits.clear();
+		chunk.hit_ends.clear();
+
+		LocalVector<uint32_t, uint32_t, true> item_hits;
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &item_hits;
+
+		for (uint32_t n = 0; n < chunk.item_count; n++) {
+			const BVHHandle &h = self->changed_items[chunk.first_item + n];
+
+			BVHABB_CLASS abb;
+			abb.from(self->tree._pairs[h.id()].expanded_aabb);
+
+			self->tree.item_fill_cullparams(h, params);
+			params.abb = abb;
+			params.result_count_overall = 0;
+			self->tree.cull_aabb(params, false);
+
+			for (const uint32_t ref_id : item_hits) {
+				// don't collide against ourself
+				if (ref_id != h.id()) {
+					chunk.hits.push_back(ref_id);
+				}
+			}
+			chunk.hit_ends.push_back(chunk.hits.size());
+		}
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +861,16 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Cull results of a contiguous range of changed items, when pairing on several threads.
+	struct PairCullChunk {
+		uint32_t first_item = 0;
+		uint32_t item_count = 0;
+		LocalVector<uint32_t, uint32_t, true> hits;
+		LocalVector<uint32_t, uint32_t, true> hit_ends; // End of each item's hits.
+	};
+	LocalVector<PairCullChunk> _pair_cull_chunks;
+	uint32_t _pairing_thread_threshold = 0;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
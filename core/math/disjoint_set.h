@@ -31,7 +31,9 @@
 #ifndef DISJOINT_SET_H
 #define DISJOINT_SET_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/vector.h"
 
 /* This DisjointSet class uses Find with path compression and Union by rank */
@@ -147,4 +149,53 @@ void DisjointSet<T, H, C, AL>::get_members(Vector<T> &out_members, T representat
 	}
 }
 
+/* Index based DisjointSet over [0, size) which can be united from several threads at once.
+ * Roots are only ever linked to smaller roots, so every set is represented by its smallest index
+ * no matter in which order the unions happen. */
+class ConcurrentDisjointSet {
+	LocalVector<SafeNumeric<uint32_t>> parents;
+
+public:
+	void reset(uint32_t p_size) {
+		parents.resize(p_size);
+		for (uint32_t i = 0; i < p_size; i++) {
+			parents[i].set(i);
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t size() const { return parents.size(); }
+
+	uint32_t find(uint32_t p_index) {
+		while (true) {
+			uint32_t parent = parents[p_index].get();
+			if (parent == p_index) {
+				return p_index;
+			}
+			// Path halving, losing the race to another thread is harmless.
+			uint32_t grandparent = parents[parent].get();
+			if (grandparent != parent) {
+				parents[p_index].exchange_if_equal(parent, grandparent);
+			}
+			p_index = grandparent;
+		}
+	}
+
+	void create_union(uint32_t p_a, uint32_t p_b) {
+		while (true) {
+			uint32_t a_root = find(p_a);
+			uint32_t b_root = find(p_b);
+			if (a_root == b_root) {
+				return;
+			}
+			if (a_root < b_root) {
+				SWAP(a_root, b_root);
+			}
+			// Fails if another thread linked a_root meanwhile, just try again from the new roots.
+			if (parents[a_root].exchange_if_equal(a_root, b_root)) {
+				return;
+			}
+		}
+	}
+};
+
 #endif // DISJOINT_SET_H
@@ -77,6 +77,23 @@ public:
 	virtual uint32_t hash() const;
 };
 
+// Native calls, the arguments point to const values of the decayed parameter types.
+
+template <class T, class R, class... P, size_t... Is>
+void call_with_native_args_helper(T *p_instance, R (T::*p_method)(P...), const void **p_args, IndexSequence<Is...>) {
+	(p_instance->*p_method)(*(const typename std::decay<P>::type *)p_args[Is]...);
+}
+
+template <class T, class R, class... P, size_t... Is>
+void call_with_native_args_helper(T *p_instance, R (T::*p_method)(P...) const, const void **p_args, IndexSequence<Is...>) {
+	(p_instance->*p_method)(*(const typename std::decay<P>::type *)p_args[Is]...);
+}
+
+template <class R, class... P, size_t... Is>
+void call_with_native_args_static_helper(R (*p_method)(P...), const void **p_args, IndexSequence<Is...>) {
+	(p_method)(*(const typename std::decay<P>::type *)p_args[Is]...);
+}
+
 template <class T, class... P>
 class CallableCustomMethodPointer : public CallableCustomMethodPointerBase {
 	struct Data {
@@ -98,6 +115,14 @@ public:
 		call_with_variant_args(data.instance, data.method, p_arguments, p_argcount, r_call_error);
 	}
 
+	virtual bool native_call(const void *p_signature, const void **p_arguments) const {
+		if (p_signature != callable_native_signature<typename std::decay<P>::type...>() || ObjectDB::get_instance(ObjectID(data.object_id)) == nullptr) {
+			return false; // Let the regular call report the error.
+		}
+		call_with_native_args_helper(data.instance, data.method, p_arguments, BuildIndexSequence<sizeof...(P)>{});
+		return true;
+	}
+
 	CallableCustomMethodPointer(T *p_instance, void (T::*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -145,6 +170,14 @@ public:
 		call_with_variant_args_ret(data.instance, data.method, p_arguments, p_argcount, r_return_value, r_call_error);
 	}
 
+	virtual bool native_call(const void *p_signature, const void **p_arguments) const {
+		if (p_signature != callable_native_signature<typename std::decay<P>::type...>() || ObjectDB::get_instance(ObjectID(data.object_id)) == nullptr) {
+			return false; // Let the regular call report the error.
+		}
+		call_with_native_args_helper(data.instance, data.method, p_arguments, BuildIndexSequence<sizeof...(P)>{});
+		return true;
+	}
+
 	CallableCustomMethodPointerRet(T *p_instance, R (T::*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -192,6 +225,14 @@ public:
 		call_with_variant_args_retc(data.instance, data.method, p_arguments, p_argcount, r_return_value, r_call_error);
 	}
 
+	virtual bool native_call(const void *p_signature, const void **p_arguments) const override {
+		if (p_signature != callable_native_signature<typename std::decay<P>::type...>() || ObjectDB::get_instance(ObjectID(data.object_id)) == nullptr) {
+			return false; // Let the regular call report the error.
+		}
+		call_with_native_args_helper(data.instance, data.method, p_arguments, BuildIndexSequence<sizeof...(P)>{});
+		return true;
+	}
+
 	CallableCustomMethodPointerRetC(T *p_instance, R (T::*p_method)(P...) const) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -243,6 +284,14 @@ public:
 		r_return_value = Variant();
 	}
 
+	virtual bool native_call(const void *p_signature, const void **p_arguments) const override {
+		if (p_signature != callable_native_signature<typename std::decay<P>::type...>()) {
+			return false;
+		}
+		call_with_native_args_static_helper(data.method, p_arguments, BuildIndexSequence<sizeof...(P)>{});
+		return true;
+	}
+
 	CallableCustomStaticMethodPointer(void (*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.method = p_method;
@@ -284,6 +333,14 @@ public:
 		call_with_variant_args_static_ret(data.method, p_arguments, p_argcount, r_return_value, r_call_error);
 	}
 
+	virtual bool native_call(const void *p_signature, const void **p_arguments) const override {
+		if (p_signature != callable_native_signature<typename std::decay<P>::type...>()) {
+			return false;
+		}
+		call_with_native_args_static_helper(data.method, p_arguments, BuildIndexSequence<sizeof...(P)>{});
+		return true;
+	}
+
 	CallableCustomStaticMethodPointerRet(R (*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.method = p_method;
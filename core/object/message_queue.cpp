@@ -84,7 +84,15 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 	return push_set(p_object->get_instance_id(), p_prop, p_value);
 }
 
+bool CallQueue::_is_pushed_from_other_thread() const {
+	return this == MessageQueue::main_singleton && !Thread::is_main_thread();
+}
+
 Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	if (unlikely(_is_pushed_from_other_thread())) {
+		return MessageQueue::_get_thread_producer()->push_callablep(p_callable, p_args, p_argcount, p_show_error);
+	}
+
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
@@ -135,6 +143,10 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	if (unlikely(_is_pushed_from_other_thread())) {
+		return MessageQueue::_get_thread_producer()->push_set(p_id, p_prop, p_value);
+	}
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
@@ -176,6 +188,10 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
+	if (unlikely(_is_pushed_from_other_thread())) {
+		return MessageQueue::_get_thread_producer()->push_notification(p_id, p_notification);
+	}
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
@@ -281,6 +297,9 @@ Error CallQueue::flush() {
 	if (unlikely(this == MessageQueue::thread_singleton)) {
 		return _transfer_messages_to_main_queue();
 	}
+	if (this == MessageQueue::main_singleton) {
+		static_cast<MessageQueue *>(this)->_merge_thread_producers();
+	}
 
 	LOCK_MUTEX;
 
@@ -299,6 +318,8 @@ Error CallQueue::flush() {
 
 	uint32_t i = 0;
 	uint32_t offset = 0;
+	uint32_t flushed_messages = 0;
+	uint64_t flushed_bytes = 0;
 
 	while (i < pages_used && offset < page_bytes[i]) {
 		Page *page = pages[i];
@@ -314,6 +335,8 @@ Error CallQueue::flush() {
 
 		//pre-advance so this function is reentrant
 		offset += advance;
+		flushed_messages++;
+		flushed_bytes += advance;
 
 		Object *target = message->callable.get_object();
 
@@ -358,6 +381,9 @@ Error CallQueue::flush() {
 	page_bytes[0] = 0;
 	pages_used = 1;
 
+	last_flush_message_count = flushed_messages;
+	last_flush_bytes = flushed_bytes;
+
 	flushing = false;
 	UNLOCK_MUTEX;
 	return OK;
@@ -518,6 +544,14 @@ int CallQueue::get_max_buffer_usage() const {
 	return pages.size() * PAGE_SIZE_BYTES;
 }
 
+uint32_t CallQueue::get_last_flush_message_count() const {
+	return last_flush_message_count;
+}
+
+uint64_t CallQueue::get_last_flush_bytes() const {
+	return last_flush_bytes;
+}
+
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
@@ -549,6 +583,77 @@ CallQueue::~CallQueue() {
 
 CallQueue *MessageQueue::main_singleton = nullptr;
 thread_local CallQueue *MessageQueue::thread_singleton = nullptr;
+thread_local CallQueue *MessageQueue::thread_producer = nullptr;
+thread_local uint32_t MessageQueue::thread_producer_epoch = 0;
+SafeNumeric<uint32_t> MessageQueue::epoch;
+Mutex MessageQueue::producers_mutex;
+
+// Hands the producer queue of a thread back to the main queue when the thread exits.
+struct MessageQueueThreadProducerOwner {
+	~MessageQueueThreadProducerOwner() {
+		MessageQueue::_release_thread_producer();
+	}
+};
+
+static thread_local MessageQueueThreadProducerOwner thread_producer_owner;
+
+CallQueue *MessageQueue::_get_thread_producer() {
+	if (likely(thread_producer && thread_producer_epoch == epoch.get())) {
+		return thread_producer;
+	}
+
+	MutexLock lock(producers_mutex);
+	MessageQueue *mq = static_cast<MessageQueue *>(main_singleton);
+	CallQueue *queue = memnew(CallQueue(nullptr, mq->max_pages, mq->error_text));
+
+	Producer producer;
+	producer.queue = queue;
+	producer.thread_id = Thread::get_caller_id();
+	uint32_t idx = 0;
+	while (idx < mq->producers.size() && mq->producers[idx].thread_id < producer.thread_id) {
+		idx++;
+	}
+	mq->producers.insert(idx, producer);
+
+	thread_producer = queue;
+	thread_producer_epoch = epoch.get();
+	(void)&thread_producer_owner; // Make sure it's constructed for this thread, so it's destructed on exit.
+	return queue;
+}
+
+void MessageQueue::_release_thread_producer() {
+	if (!thread_producer) {
+		return;
+	}
+	// The main queue may be getting destroyed meanwhile, which happens with this lock held.
+	MutexLock lock(producers_mutex);
+	MessageQueue *mq = static_cast<MessageQueue *>(main_singleton);
+	if (mq && thread_producer_epoch == epoch.get()) {
+		for (Producer &producer : mq->producers) {
+			if (producer.queue == thread_producer) {
+				producer.orphaned = true;
+				break;
+			}
+		}
+	}
+	thread_producer = nullptr;
+}
+
+void MessageQueue::_merge_thread_producers() {
+	MutexLock lock(producers_mutex);
+	for (uint32_t i = 0; i < producers.size(); i++) {
+		CallQueue *queue = producers[i].queue;
+		{
+			MutexLock producer_lock(queue->mutex);
+			queue->_transfer_messages_to_main_queue();
+		}
+		if (producers[i].orphaned && !queue->has_messages()) {
+			memdelete(queue);
+			producers.remove_at(i);
+			i--;
+		}
+	}
+}
 
 void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton) {
 	DEV_ASSERT(p_thread_singleton); // To unset the thread singleton, don't call this with nullptr, but just memfree() it.
@@ -569,10 +674,17 @@ MessageQueue::MessageQueue() :
 		CallQueue(nullptr,
 				int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_mb", PROPERTY_HINT_RANGE, "1,512,1,or_greater"), 32)) * 1024 * 1024 / PAGE_SIZE_BYTES,
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
+	MutexLock lock(producers_mutex);
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	epoch.increment(); // Invalidates producers left over from a previous singleton.
 }
 
 MessageQueue::~MessageQueue() {
+	MutexLock lock(producers_mutex);
+	for (const Producer &producer : producers) {
+		memdelete(producer.queue);
+	}
+	producers.clear();
 	main_singleton = nullptr;
 }
@@ -32,9 +32,11 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/object_id.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -77,6 +79,9 @@ private:
 	uint32_t pages_used = 0;
 	bool flushing = false;
 
+	uint32_t last_flush_message_count = 0;
+	uint64_t last_flush_bytes = 0;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -99,6 +104,7 @@ private:
 	}
 
 	Error _transfer_messages_to_main_queue();
+	bool _is_pushed_from_other_thread() const;
 
 	void _add_page();
 
@@ -154,6 +160,8 @@ public:
 
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
+	uint32_t get_last_flush_message_count() const;
+	uint64_t get_last_flush_bytes() const;
 
 	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
@@ -164,8 +172,33 @@ class MessageQueue : public CallQueue {
 	static thread_local CallQueue *thread_singleton;
 	friend class CallQueue;
 
+	// Threads other than the main one push into their own producer queue when pushing to the
+	// main queue, so they don't contend on its lock. Producers are merged into the main queue when
+	// it's flushed, ordered by thread ID so the resulting message order doesn't depend on timing.
+	struct Producer {
+		CallQueue *queue = nullptr;
+		Thread::ID thread_id = 0;
+		bool orphaned = false; // Its thread exited, free it once its messages are merged.
+	};
+
+	static thread_local CallQueue *thread_producer;
+	static thread_local uint32_t thread_producer_epoch;
+	static SafeNumeric<uint32_t> epoch;
+
+	// Static so that exiting threads can lock it before reading main_singleton.
+	static Mutex producers_mutex;
+	LocalVector<Producer> producers;
+
+	static CallQueue *_get_thread_producer();
+	static void _release_thread_producer();
+	void _merge_thread_producers();
+
+	friend struct MessageQueueThreadProducerOwner;
+
 public:
-	_FORCE_INLINE_ static CallQueue *get_singleton() { return thread_singleton ? thread_singleton : main_singleton; }
+	_FORCE_INLINE_ static CallQueue *get_singleton() {
+		return thread_singleton ? thread_singleton : main_singleton;
+	}
 
 	static void set_thread_singleton_override(CallQueue *p_thread_singleton);
 
@@ -1087,6 +1087,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
+	const uint32_t slot_count = s->slot_map.size();
+	if (slot_count == 0) {
+		// User signals keep their entry when everything gets disconnected, nothing to call.
+		return OK;
+	}
+
 	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
 	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
 	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
@@ -1095,21 +1101,31 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	// Ensure that disconnecting the signal or even deleting the object
 	// will not affect the signal calling.
-	LocalVector<Connection> slot_conns;
-	slot_conns.resize(s->slot_map.size());
+	// Only the callable and flags are needed, and most signals have few connections,
+	// so those are snapshotted on the stack, only falling back to the heap for large lists.
+	EmitSlot stack_slots[EMIT_STACK_SLOTS];
+	LocalVector<EmitSlot> heap_slots;
+	EmitSlot *slots = stack_slots;
+	if (unlikely(slot_count > EMIT_STACK_SLOTS)) {
+		heap_slots.resize(slot_count);
+		slots = heap_slots.ptr();
+	}
 	{
 		uint32_t idx = 0;
 		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			slot_conns[idx++] = slot_kv.value.conn;
+			slots[idx].callable = slot_kv.value.conn.callable;
+			slots[idx].flags = slot_kv.value.conn.flags;
+			idx++;
 		}
-		DEV_ASSERT(idx == s->slot_map.size());
+		DEV_ASSERT(idx == slot_count);
 	}
 
 	OBJ_DEBUG_LOCK
 
 	Error err = OK;
 
-	for (const Connection &c : slot_conns) {
+	for (uint32_t i = 0; i < slot_count; i++) {
+		const EmitSlot &c = slots[i];
 		if (!c.callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
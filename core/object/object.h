@@ -617,6 +617,13 @@ private:
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
 	};
 
+	// Snapshot of a connection taken by emit_signalp().
+	struct EmitSlot {
+		Callable callable;
+		uint32_t flags = 0;
+	};
+	static constexpr uint32_t EMIT_STACK_SLOTS = 8;
+
 	HashMap<StringName, SignalData> signal_map;
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
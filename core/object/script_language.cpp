@@ -303,14 +303,17 @@ void ScriptServer::thread_exit() {
 HashMap<StringName, ScriptServer::GlobalScriptClass> ScriptServer::global_classes;
 HashMap<StringName, Vector<StringName>> ScriptServer::inheriters_cache;
 bool ScriptServer::inheriters_cache_dirty = true;
+RWLock ScriptServer::global_classes_lock;
 
 void ScriptServer::global_classes_clear() {
+	RWLockWrite lock(global_classes_lock);
 	global_classes.clear();
 	inheriters_cache.clear();
 }
 
 void ScriptServer::add_global_class(const StringName &p_class, const StringName &p_base, const StringName &p_language, const String &p_path) {
-	ERR_FAIL_COND_MSG(p_class == p_base || (global_classes.has(p_base) && get_global_class_native_base(p_base) == p_class), "Cyclic inheritance in script class.");
+	RWLockWrite lock(global_classes_lock);
+	ERR_FAIL_COND_MSG(p_class == p_base || (global_classes.has(p_base) && _get_global_class_native_base(p_base) == p_class), "Cyclic inheritance in script class.");
 	GlobalScriptClass g;
 	g.language = p_language;
 	g.path = p_path;
@@ -320,11 +323,14 @@ void ScriptServer::add_global_class(const StringName &p_class, const StringName
 }
 
 void ScriptServer::remove_global_class(const StringName &p_class) {
+	RWLockWrite lock(global_classes_lock);
 	global_classes.erase(p_class);
 	inheriters_cache_dirty = true;
 }
 
 void ScriptServer::get_inheriters_list(const StringName &p_base_type, List<StringName> *r_classes) {
+	// Rebuilding the cache mutates shared state, so this needs exclusive access.
+	RWLockWrite lock(global_classes_lock);
 	if (inheriters_cache_dirty) {
 		inheriters_cache.clear();
 		for (const KeyValue<StringName, GlobalScriptClass> &K : global_classes) {
@@ -350,6 +356,7 @@ void ScriptServer::get_inheriters_list(const StringName &p_base_type, List<Strin
 }
 
 void ScriptServer::remove_global_class_by_path(const String &p_path) {
+	RWLockWrite lock(global_classes_lock);
 	for (const KeyValue<StringName, GlobalScriptClass> &kv : global_classes) {
 		if (kv.value.path == p_path) {
 			global_classes.erase(kv.key);
@@ -360,26 +367,32 @@ void ScriptServer::remove_global_class_by_path(const String &p_path) {
 }
 
 bool ScriptServer::is_global_class(const StringName &p_class) {
+	RWLockRead lock(global_classes_lock);
 	return global_classes.has(p_class);
 }
 
 StringName ScriptServer::get_global_class_language(const StringName &p_class) {
-	ERR_FAIL_COND_V(!global_classes.has(p_class), StringName());
-	return global_classes[p_class].language;
+	RWLockRead lock(global_classes_lock);
+	const GlobalScriptClass *g = global_classes.getptr(p_class);
+	ERR_FAIL_NULL_V(g, StringName());
+	return g->language;
 }
 
 String ScriptServer::get_global_class_path(const String &p_class) {
-	ERR_FAIL_COND_V(!global_classes.has(p_class), String());
-	return global_classes[p_class].path;
+	RWLockRead lock(global_classes_lock);
+	const GlobalScriptClass *g = global_classes.getptr(p_class);
+	ERR_FAIL_NULL_V(g, String());
+	return g->path;
 }
 
 StringName ScriptServer::get_global_class_base(const String &p_class) {
-	ERR_FAIL_COND_V(!global_classes.has(p_class), String());
-	return global_classes[p_class].base;
+	RWLockRead lock(global_classes_lock);
+	const GlobalScriptClass *g = global_classes.getptr(p_class);
+	ERR_FAIL_NULL_V(g, String());
+	return g->base;
 }
 
-StringName ScriptServer::get_global_class_native_base(const String &p_class) {
-	ERR_FAIL_COND_V(!global_classes.has(p_class), String());
+StringName ScriptServer::_get_global_class_native_base(const StringName &p_class) {
 	String base = global_classes[p_class].base;
 	while (global_classes.has(base)) {
 		base = global_classes[base].base;
@@ -387,10 +400,19 @@ StringName ScriptServer::get_global_class_native_base(const String &p_class) {
 	return base;
 }
 
+StringName ScriptServer::get_global_class_native_base(const String &p_class) {
+	RWLockRead lock(global_classes_lock);
+	ERR_FAIL_COND_V(!global_classes.has(p_class), String());
+	return _get_global_class_native_base(p_class);
+}
+
 void ScriptServer::get_global_class_list(List<StringName> *r_global_classes) {
 	List<StringName> classes;
-	for (const KeyValue<StringName, GlobalScriptClass> &E : global_classes) {
-		classes.push_back(E.key);
+	{
+		RWLockRead lock(global_classes_lock);
+		for (const KeyValue<StringName, GlobalScriptClass> &E : global_classes) {
+			classes.push_back(E.key);
+		}
 	}
 	classes.sort_custom<StringName::AlphCompare>();
 	for (const StringName &E : classes) {
@@ -413,14 +435,21 @@ void ScriptServer::save_global_classes() {
 	List<StringName> gc;
 	get_global_class_list(&gc);
 	Array gcarr;
-	for (const StringName &E : gc) {
-		Dictionary d;
-		d["class"] = E;
-		d["language"] = global_classes[E].language;
-		d["path"] = global_classes[E].path;
-		d["base"] = global_classes[E].base;
-		d["icon"] = class_icons.get(E, "");
-		gcarr.push_back(d);
+	{
+		RWLockRead lock(global_classes_lock);
+		for (const StringName &E : gc) {
+			const GlobalScriptClass *g = global_classes.getptr(E);
+			if (!g) {
+				continue; // Removed by another thread in the meantime.
+			}
+			Dictionary d;
+			d["class"] = E;
+			d["language"] = g->language;
+			d["path"] = g->path;
+			d["base"] = g->base;
+			d["icon"] = class_icons.get(E, "");
+			gcarr.push_back(d);
+		}
 	}
 	ProjectSettings::get_singleton()->store_global_class_list(gcarr);
 }
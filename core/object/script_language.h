@@ -34,6 +34,7 @@
 #include "core/doc_data.h"
 #include "core/io/resource.h"
 #include "core/object/script_instance.h"
+#include "core/os/rw_lock.h"
 #include "core/templates/pair.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
@@ -67,6 +68,11 @@ class ScriptServer {
 	static HashMap<StringName, GlobalScriptClass> global_classes;
 	static HashMap<StringName, Vector<StringName>> inheriters_cache;
 	static bool inheriters_cache_dirty;
+	// Guards the global class registry and the inheriters cache, which are
+	// queried by script parsers and analyzers running on loader threads.
+	static RWLock global_classes_lock;
+
+	static StringName _get_global_class_native_base(const StringName &p_class);
 
 public:
 	static ScriptEditRequestFunction edit_request_func;
@@ -95,7 +95,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				p_task->native_group_func(p_task->native_func_userdata, work_index);
 			} else if (p_task->template_userdata) {
 				p_task->template_userdata->callback_indexed(work_index);
-			} else {
+			} else if (!p_task->callable.try_native_call(work_index)) {
 				p_task->callable.call(work_index);
 			}
 
@@ -144,7 +144,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		} else if (p_task->template_userdata) {
 			p_task->template_userdata->callback();
 			memdelete(p_task->template_userdata);
-		} else {
+		} else if (!p_task->callable.try_native_call()) {
 			p_task->callable.call();
 		}
 
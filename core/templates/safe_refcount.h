@@ -134,6 +134,10 @@ public:
 		}
 	}
 
+	_ALWAYS_INLINE_ bool exchange_if_equal(T p_expected, T p_value) {
+		return value.compare_exchange_strong(p_expected, p_value, std::memory_order_acq_rel);
+	}
+
 	_ALWAYS_INLINE_ T conditional_increment() {
 		while (true) {
 			T c = value.load(std::memory_order_acquire);
@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  span.h                                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SPAN_H
+#define SPAN_H
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+
+#include <climits>
+
+// Read-only, non-owning view of a contiguous range of elements, such as a part of a Vector.
+// It doesn't keep the data alive, so the viewed container must not be modified or freed while
+// the span is in use.
+template <class T>
+class Span {
+	const T *_ptr = nullptr;
+	int _len = 0;
+
+public:
+	_FORCE_INLINE_ const T *ptr() const { return _ptr; }
+	_FORCE_INLINE_ int size() const { return _len; }
+	_FORCE_INLINE_ bool is_empty() const { return _len == 0; }
+
+	_FORCE_INLINE_ const T &operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, _len);
+		return _ptr[p_index];
+	}
+
+	_FORCE_INLINE_ const T *begin() const { return _ptr; }
+	_FORCE_INLINE_ const T *end() const { return _ptr + _len; }
+
+	Span<T> subspan(int p_begin, int p_end = INT_MAX) const {
+		const int begin = CLAMP(p_begin, 0, _len);
+		const int end = CLAMP(p_end, begin, _len);
+		return Span<T>(_ptr + begin, end - begin);
+	}
+
+	_FORCE_INLINE_ Span() {}
+	_FORCE_INLINE_ Span(const T *p_ptr, int p_len) :
+			_ptr(p_ptr), _len(p_len) {}
+};
+
+#endif // SPAN_H
@@ -41,6 +41,7 @@
 #include "core/templates/cowdata.h"
 #include "core/templates/search_array.h"
 #include "core/templates/sort_array.h"
+#include "core/templates/span.h"
 
 #include <climits>
 #include <initializer_list>
@@ -173,6 +174,10 @@ public:
 
 		ERR_FAIL_COND_V(begin > end, result);
 
+		if (begin == 0 && end == s) {
+			return *this; // Shares the data until either side is written to.
+		}
+
 		int result_size = end - begin;
 		result.resize(result_size);
 
@@ -185,6 +190,24 @@ public:
 		return result;
 	}
 
+	// Same range semantics as slice(), but returns a view into this vector instead of a copy.
+	Span<T> span(int p_begin = 0, int p_end = INT_MAX) const {
+		const int s = size();
+
+		int begin = CLAMP(p_begin, -s, s);
+		if (begin < 0) {
+			begin += s;
+		}
+		int end = CLAMP(p_end, -s, s);
+		if (end < 0) {
+			end += s;
+		}
+
+		ERR_FAIL_COND_V(begin > end, Span<T>());
+
+		return Span<T>(ptr() + begin, end - begin);
+	}
+
 	bool operator==(const Vector<T> &p_arr) const {
 		int s = size();
 		if (s != p_arr.size()) {
@@ -470,11 +470,20 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	ERR_FAIL_COND_V_MSG(p_step > 0 && begin > end, result, "Slice step is positive, but bounds are decreasing.");
 	ERR_FAIL_COND_V_MSG(p_step < 0 && begin < end, result, "Slice step is negative, but bounds are increasing.");
 
+	if (!p_deep && p_step == 1) {
+		// Contiguous shallow slices don't need per-element bookkeeping, and the full
+		// range shares the underlying data until either array is written to.
+		result._p->array = _p->array.slice(begin, end);
+		return result;
+	}
+
 	int result_size = (end - begin) / p_step + (((end - begin) % p_step != 0) ? 1 : 0);
 	result.resize(result_size);
 
+	const Variant *r = _p->array.ptr();
+	Variant *w = result._p->array.ptrw();
 	for (int src_idx = begin, dest_idx = 0; dest_idx < result_size; ++dest_idx) {
-		result[dest_idx] = p_deep ? get(src_idx).duplicate(true) : get(src_idx);
+		w[dest_idx] = p_deep ? r[src_idx].duplicate(true) : r[src_idx];
 		src_idx += p_step;
 	}
 
@@ -413,6 +413,10 @@ void CallableCustom::get_bound_arguments(Vector<Variant> &r_arguments, int &r_ar
 	r_argcount = 0;
 }
 
+bool CallableCustom::native_call(const void *p_signature, const void **p_arguments) const {
+	return false;
+}
+
 CallableCustom::CallableCustom() {
 	ref_count.init();
 }
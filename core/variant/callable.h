@@ -35,6 +35,8 @@
 #include "core/string/string_name.h"
 #include "core/templates/list.h"
 
+#include <type_traits>
+
 class Object;
 class Variant;
 class CallableCustom;
@@ -75,6 +77,12 @@ public:
 	void call_deferredp(const Variant **p_arguments, int p_argcount) const;
 	Variant callv(const Array &p_arguments) const;
 
+	// Calls a native method pointer callable without boxing the arguments into Variants.
+	// Only succeeds if the target's argument types match exactly (ignoring references and
+	// constness); returns false without calling anything otherwise, so callers can fall back to call().
+	template <typename... P>
+	bool try_native_call(const P &...p_args) const;
+
 	template <typename... VarArgs>
 	void call_deferred(VarArgs... p_args) const {
 		Variant args[sizeof...(p_args) + 1] = { p_args..., 0 }; // +1 makes sure zero sized arrays are also supported.
@@ -155,11 +163,29 @@ public:
 	virtual const Callable *get_base_comparator() const;
 	virtual int get_bound_arguments_count() const;
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments, int &r_argcount) const;
+	// See Callable::try_native_call(). p_arguments point to values of the types identified by p_signature.
+	virtual bool native_call(const void *p_signature, const void **p_arguments) const;
 
 	CallableCustom();
 	virtual ~CallableCustom() {}
 };
 
+// Unique tag for an argument list, used to match native calls to native targets without RTTI.
+template <typename... P>
+const void *callable_native_signature() {
+	static const char signature = 0;
+	return &signature;
+}
+
+template <typename... P>
+bool Callable::try_native_call(const P &...p_args) const {
+	if (!is_custom()) {
+		return false;
+	}
+	const void *args[sizeof...(P) + 1] = { &p_args..., nullptr }; // +1 makes sure zero sized arrays are also supported.
+	return custom->native_call(callable_native_signature<typename std::decay<P>::type...>(), args);
+}
+
 // This is just a proxy object to object signals, its only
 // allocated on demand by/for scripting languages so it can
 // be put inside a Variant, but it is not
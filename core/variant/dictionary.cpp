@@ -363,9 +363,7 @@ Dictionary Dictionary::recursive_duplicate(bool p_deep, int recursion_count) con
 			n[E.key.recursive_duplicate(true, recursion_count)] = E.value.recursive_duplicate(true, recursion_count);
 		}
 	} else {
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key] = E.value;
-		}
+		n._p->variant_map = _p->variant_map;
 	}
 
 	return n;
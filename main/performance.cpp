@@ -85,6 +85,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_LAST_FLUSH_MESSAGES);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_LAST_FLUSH_BYTES);
+	BIND_ENUM_CONSTANT(NAVIGATION_MAP_SYNC_TIME);
+	BIND_ENUM_CONSTANT(NAVIGATION_REGION_SYNC_COUNT);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -133,6 +137,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"message_queue/last_flush_messages",
+		"message_queue/last_flush_bytes",
+		"navigation/map_sync_time",
+		"navigation/regions_synced",
 
 	};
 
@@ -207,6 +215,14 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MESSAGE_QUEUE_LAST_FLUSH_MESSAGES:
+			return MessageQueue::get_singleton()->get_last_flush_message_count();
+		case MESSAGE_QUEUE_LAST_FLUSH_BYTES:
+			return MessageQueue::get_singleton()->get_last_flush_bytes();
+		case NAVIGATION_MAP_SYNC_TIME:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_MAP_SYNC_TIME) / 1000000.0;
+		case NAVIGATION_REGION_SYNC_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_REGION_SYNC_COUNT);
 
 		default: {
 		}
@@ -252,6 +268,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
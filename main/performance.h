@@ -100,6 +100,10 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MESSAGE_QUEUE_LAST_FLUSH_MESSAGES,
+		MESSAGE_QUEUE_LAST_FLUSH_BYTES,
+		NAVIGATION_MAP_SYNC_TIME,
+		NAVIGATION_REGION_SYNC_COUNT,
 		MONITOR_MAX
 	};
 
@@ -59,18 +59,38 @@ GDScriptAnalyzer *GDScriptParserRef::get_analyzer() {
 }
 
 Error GDScriptParserRef::raise_status(Status p_new_status) {
-	ERR_FAIL_NULL_V(parser, ERR_INVALID_DATA);
+	{
+		MutexLock parse_lock(mutex);
+		ERR_FAIL_NULL_V(parser, ERR_INVALID_DATA);
 
-	if (result != OK) {
-		return result;
+		if (result != OK) {
+			return result;
+		}
+
+		if (status == EMPTY && p_new_status > EMPTY) {
+			status = PARSED;
+			result = parser->parse(GDScriptCache::get_source_code(path), path, false);
+		}
+
+		if (result != OK || p_new_status <= status) {
+			return result;
+		}
+	}
+
+	// Resolving inheritance, interface and body pulls in other scripts, which may depend back on
+	// this one, so these steps are serialized by the cache lock to keep lock ordering simple.
+	// The status is raised before each step so cyclic dependencies on this thread don't recurse,
+	// the parser lock is held until the steps are done so other threads never see it half-resolved.
+	MutexLock lock(GDScriptCache::singleton->mutex);
+	MutexLock resolve_lock(mutex);
+
+	if (parser == nullptr) {
+		return ERR_INVALID_DATA;
 	}
 
 	while (p_new_status > status) {
 		switch (status) {
-			case EMPTY:
-				status = PARSED;
-				result = parser->parse(GDScriptCache::get_source_code(path), path, false);
-				break;
+			case EMPTY: // Handled above.
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
 				Error inheritance_result = get_analyzer()->resolve_inheritance();
@@ -105,6 +125,8 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 }
 
 void GDScriptParserRef::clear() {
+	MutexLock lock(mutex);
+
 	if (cleared) {
 		return;
 	}
@@ -112,10 +134,12 @@ void GDScriptParserRef::clear() {
 
 	if (parser != nullptr) {
 		memdelete(parser);
+		parser = nullptr;
 	}
 
 	if (analyzer != nullptr) {
 		memdelete(analyzer);
+		analyzer = nullptr;
 	}
 }
 
@@ -193,28 +217,31 @@ void GDScriptCache::remove_script(const String &p_path) {
 }
 
 Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptParserRef::Status p_status, Error &r_error, const String &p_owner) {
-	MutexLock lock(singleton->mutex);
 	Ref<GDScriptParserRef> ref;
-	if (!p_owner.is_empty()) {
-		singleton->dependencies[p_owner].insert(p_path);
-	}
-	if (singleton->parser_map.has(p_path)) {
-		ref = Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
-		if (ref.is_null()) {
-			r_error = ERR_INVALID_DATA;
-			return ref;
+	{
+		MutexLock lock(singleton->mutex);
+		if (!p_owner.is_empty()) {
+			singleton->dependencies[p_owner].insert(p_path);
 		}
-	} else {
-		if (!FileAccess::exists(p_path)) {
-			r_error = ERR_FILE_NOT_FOUND;
-			return ref;
+		if (singleton->parser_map.has(p_path)) {
+			ref = Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
+			if (ref.is_null()) {
+				r_error = ERR_INVALID_DATA;
+				return ref;
+			}
+		} else {
+			if (!FileAccess::exists(p_path)) {
+				r_error = ERR_FILE_NOT_FOUND;
+				return ref;
+			}
+			GDScriptParser *parser = memnew(GDScriptParser);
+			ref.instantiate();
+			ref->parser = parser;
+			ref->path = p_path;
+			singleton->parser_map[p_path] = ref.ptr();
 		}
-		GDScriptParser *parser = memnew(GDScriptParser);
-		ref.instantiate();
-		ref->parser = parser;
-		ref->path = p_path;
-		singleton->parser_map[p_path] = ref.ptr();
 	}
+	// Not holding the cache lock here, unless the caller does, so parsing can happen in parallel.
 	r_error = ref->raise_status(p_status);
 
 	return ref;
@@ -240,10 +267,27 @@ String GDScriptCache::get_source_code(const String &p_path) {
 }
 
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
-	MutexLock lock(singleton->mutex);
-	if (!p_owner.is_empty()) {
-		singleton->dependencies[p_owner].insert(p_path);
+	{
+		MutexLock lock(singleton->mutex);
+		if (!p_owner.is_empty()) {
+			singleton->dependencies[p_owner].insert(p_path);
+		}
+		if (singleton->full_gdscript_cache.has(p_path)) {
+			return singleton->full_gdscript_cache[p_path];
+		}
+		if (singleton->shallow_gdscript_cache.has(p_path)) {
+			return singleton->shallow_gdscript_cache[p_path];
+		}
 	}
+
+	// Parse before taking the cache lock, so independent scripts loaded from different threads
+	// don't wait on each other. The parser is cached and reused once the lock is acquired.
+	Error parse_error = OK;
+	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, parse_error);
+
+	MutexLock lock(singleton->mutex);
+
+	// Another thread may have finished the same script while this one was parsing.
 	if (singleton->full_gdscript_cache.has(p_path)) {
 		return singleton->full_gdscript_cache[p_path];
 	}
@@ -260,7 +304,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+	r_error = parse_error;
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
 	}
@@ -270,22 +314,25 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 }
 
 Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_error, const String &p_owner, bool p_update_from_disk) {
-	MutexLock lock(singleton->mutex);
-
-	if (!p_owner.is_empty()) {
-		singleton->dependencies[p_owner].insert(p_path);
-	}
-
 	Ref<GDScript> script;
 	r_error = OK;
-	if (singleton->full_gdscript_cache.has(p_path)) {
-		script = singleton->full_gdscript_cache[p_path];
-		if (!p_update_from_disk) {
-			return script;
+	{
+		MutexLock lock(singleton->mutex);
+
+		if (!p_owner.is_empty()) {
+			singleton->dependencies[p_owner].insert(p_path);
+		}
+
+		if (singleton->full_gdscript_cache.has(p_path)) {
+			script = singleton->full_gdscript_cache[p_path];
+			if (!p_update_from_disk) {
+				return script;
+			}
 		}
 	}
 
 	if (script.is_null()) {
+		// Parsing happens here, outside of the cache lock.
 		script = get_shallow_script(p_path, r_error);
 		// Only exit early if script failed to load, otherwise let reload report errors.
 		if (script.is_null()) {
@@ -293,6 +340,15 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Analysis and compilation may need other scripts, so they stay serialized.
+	MutexLock lock(singleton->mutex);
+
+	if (!p_update_from_disk && singleton->full_gdscript_cache.has(p_path)) {
+		// Compiled by another thread while this one was parsing.
+		r_error = OK;
+		return singleton->full_gdscript_cache[p_path];
+	}
+
 	if (p_update_from_disk) {
 		r_error = script->load_source_code(p_path);
 		if (r_error) {
@@ -59,6 +59,9 @@ private:
 	Error result = OK;
 	String path;
 	bool cleared = false;
+	// Serializes parsing of this script. Parsing only depends on the script's own
+	// source, so different scripts can be parsed concurrently on loader threads.
+	Mutex mutex;
 
 	friend class GDScriptCache;
 
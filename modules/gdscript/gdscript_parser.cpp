@@ -36,6 +36,8 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_defs.h"
+#include "core/os/mutex.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/multiplayer_api.h"
 
 #ifdef DEBUG_ENABLED
@@ -52,14 +54,21 @@
 // and custom classes. So `Variant::NIL` and `Variant::OBJECT` are excluded:
 // `Variant::NIL` - `null` is literal, not a type.
 // `Variant::OBJECT` - `Object` should be treated as a class, not as a built-in type.
+// Scripts can be parsed from several loader threads at once, so the lazy initialization is guarded.
 static HashMap<StringName, Variant::Type> builtin_types;
+static SafeFlag builtin_types_initialized;
+static Mutex builtin_types_mutex;
 Variant::Type GDScriptParser::get_builtin_type(const StringName &p_type) {
-	if (unlikely(builtin_types.is_empty())) {
-		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
-			Variant::Type type = (Variant::Type)i;
-			if (type != Variant::NIL && type != Variant::OBJECT) {
-				builtin_types[Variant::get_type_name(type)] = type;
+	if (unlikely(!builtin_types_initialized.is_set())) {
+		MutexLock lock(builtin_types_mutex);
+		if (!builtin_types_initialized.is_set()) {
+			for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+				Variant::Type type = (Variant::Type)i;
+				if (type != Variant::NIL && type != Variant::OBJECT) {
+					builtin_types[Variant::get_type_name(type)] = type;
+				}
 			}
+			builtin_types_initialized.set();
 		}
 	}
 
@@ -74,7 +83,9 @@ HashMap<String, String> GDScriptParser::theme_color_names;
 #endif
 
 void GDScriptParser::cleanup() {
+	MutexLock lock(builtin_types_mutex);
 	builtin_types.clear();
+	builtin_types_initialized.clear();
 }
 
 void GDScriptParser::get_annotation_list(List<MethodInfo> *r_annotations) const {
@@ -130,6 +141,8 @@ GDScriptParser::GDScriptParser() {
 #endif
 
 #ifdef TOOLS_ENABLED
+	static Mutex theme_color_names_mutex;
+	MutexLock lock(theme_color_names_mutex);
 	if (theme_color_names.is_empty()) {
 		theme_color_names.insert("x", "axis_x_color");
 		theme_color_names.insert("y", "axis_y_color");
@@ -33,6 +33,12 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -72,6 +78,89 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+static const int PARALLEL_LOAD_SCRIPT_COUNT = 256;
+
+static String _parallel_load_script_path(const String &p_dir, int p_index) {
+	return p_dir.path_join(vformat("script_%d.gd", p_index));
+}
+
+struct ParallelLoadData {
+	String dir;
+	Vector<Ref<GDScript>> scripts;
+	Vector<Error> errors;
+};
+
+static void _parallel_load_script(void *p_userdata, uint32_t p_index) {
+	ParallelLoadData *data = (ParallelLoadData *)p_userdata;
+	Error err = OK;
+	data->scripts.write[p_index] = GDScriptCache::get_full_script(_parallel_load_script_path(data->dir, p_index), err);
+	data->errors.write[p_index] = err;
+}
+
+TEST_CASE("[Modules][GDScript] Load interdependent scripts in parallel") {
+	ParallelLoadData data;
+	data.dir = OS::get_singleton()->get_cache_path().path_join("gdscript_parallel_load");
+	DirAccess::make_dir_recursive_absolute(data.dir);
+
+	// Each script preloads up to two others, forming a dependency graph that all tasks share.
+	for (int i = 0; i < PARALLEL_LOAD_SCRIPT_COUNT; i++) {
+		String source = "extends RefCounted\n\nconst ID = " + itos(i) + "\n";
+		int next = 0;
+		for (int dependency : { i + 1, i * 2 + 1 }) {
+			if (dependency < PARALLEL_LOAD_SCRIPT_COUNT) {
+				source += vformat("const DEP_%d = preload(\"script_%d.gd\")\n", next++, dependency);
+			}
+		}
+		source += "\nfunc get_dependency_ids() -> Array:\n\treturn [";
+		for (int j = 0; j < next; j++) {
+			source += vformat("%sDEP_%d.ID", j > 0 ? ", " : "", j);
+		}
+		source += "]\n";
+
+		Ref<FileAccess> f = FileAccess::open(_parallel_load_script_path(data.dir, i), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(source);
+	}
+
+	data.scripts.resize(PARALLEL_LOAD_SCRIPT_COUNT);
+	data.errors.resize(PARALLEL_LOAD_SCRIPT_COUNT);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(_parallel_load_script, &data, PARALLEL_LOAD_SCRIPT_COUNT, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_valid = true;
+	bool all_linked = true;
+	for (int i = 0; i < PARALLEL_LOAD_SCRIPT_COUNT; i++) {
+		const Ref<GDScript> &scr = data.scripts[i];
+		all_valid &= data.errors[i] == OK && scr.is_valid() && scr->is_valid();
+		if (!all_valid) {
+			break;
+		}
+
+		// The same script object must be handed out regardless of which thread compiled it.
+		all_valid &= GDScriptCache::get_cached_script(_parallel_load_script_path(data.dir, i)) == scr;
+
+		Ref<RefCounted> instance;
+		instance.instantiate();
+		instance->set_script(scr);
+		Array ids = instance->call("get_dependency_ids");
+		Array expected;
+		for (int dependency : { i + 1, i * 2 + 1 }) {
+			if (dependency < PARALLEL_LOAD_SCRIPT_COUNT) {
+				expected.push_back(dependency);
+			}
+		}
+		all_linked &= ids == expected;
+	}
+	CHECK_MESSAGE(all_valid, "All scripts should compile when loaded concurrently.");
+	CHECK_MESSAGE(all_linked, "Preloaded dependencies should resolve to the right scripts.");
+
+	data.scripts.clear();
+	for (int i = 0; i < PARALLEL_LOAD_SCRIPT_COUNT; i++) {
+		GDScriptCache::remove_script(_parallel_load_script_path(data.dir, i));
+		DirAccess::remove_absolute(_parallel_load_script_path(data.dir, i));
+	}
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
@@ -34,6 +34,7 @@
 #include "nav_mesh_generator_3d.h"
 #endif // _3D_DISABLED
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 using namespace NavigationUtilities;
@@ -194,6 +195,20 @@ bool GodotNavigationServer::map_get_use_edge_connections(RID p_map) const {
 	return map->get_use_edge_connections();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
 COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
@@ -631,6 +646,69 @@ COMMAND_2(link_set_owner_id, RID, p_link, ObjectID, p_owner_id) {
 	link->set_owner_id(p_owner_id);
 }
 
+RID GodotNavigationServer::flow_field_create() {
+	MutexLock lock(operations_mutex);
+
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	NavMap *map = map_owner.get_or_null(p_map);
+
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer::flow_field_get_map(RID p_flow_field) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, RID());
+
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_target_position(p_position);
+}
+
+Vector3 GodotNavigationServer::flow_field_get_target_position(RID p_flow_field) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector3());
+
+	return flow_field->get_target_position();
+}
+
+COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_navigation_layers(p_navigation_layers);
+}
+
+uint32_t GodotNavigationServer::flow_field_get_navigation_layers(RID p_flow_field) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, 0);
+
+	return flow_field->get_navigation_layers();
+}
+
+Vector3 GodotNavigationServer::flow_field_get_direction(RID p_flow_field, Vector3 p_position) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector3());
+
+	return flow_field->get_direction(p_position);
+}
+
 ObjectID GodotNavigationServer::link_get_owner_id(RID p_link) const {
 	const NavLink *link = link_owner.get_or_null(p_link);
 	ERR_FAIL_NULL_V(link, ObjectID());
@@ -962,6 +1040,17 @@ void GodotNavigationServer::bake_from_source_geometry_data_async(const Ref<Navig
 #endif // _3D_DISABLED
 }
 
+int GodotNavigationServer::bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_tiles, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_V_MSG(!p_source_geometry_data.is_valid(), 0, "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL_V(NavMeshGenerator3D::get_singleton(), 0);
+	return NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data(p_tiles, p_source_geometry_data);
+#else
+	return 0;
+#endif // _3D_DISABLED
+}
+
 COMMAND_1(free, RID, p_object) {
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
@@ -990,6 +1079,12 @@ COMMAND_1(free, RID, p_object) {
 			obstacle->set_map(nullptr);
 		}
 
+		// Remove any assigned flow fields
+		const LocalVector<NavFlowField *> flow_fields = map->get_flow_fields();
+		for (NavFlowField *flow_field : flow_fields) {
+			flow_field->set_map(nullptr);
+		}
+
 		int map_index = active_maps.find(map);
 		if (map_index >= 0) {
 			active_maps.remove_at(map_index);
@@ -1025,6 +1120,14 @@ COMMAND_1(free, RID, p_object) {
 	} else if (obstacle_owner.owns(p_object)) {
 		internal_free_obstacle(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		NavFlowField *flow_field = flow_field_owner.get_or_null(p_object);
+
+		// Removes this flow field from the map if assigned
+		flow_field->set_map(nullptr);
+
+		flow_field_owner.free(p_object);
+
 	} else {
 		ERR_PRINT("Attempted to free a NavigationServer RID that did not exist (or was already freed).");
 	}
@@ -1109,6 +1212,8 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	int _new_pm_edge_merge_count = 0;
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
+	uint64_t _new_pm_map_sync_time_usec = 0;
+	int _new_pm_region_sync_count = 0;
 
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
@@ -1126,6 +1231,8 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 		_new_pm_edge_merge_count += active_maps[i]->get_pm_edge_merge_count();
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
+		_new_pm_map_sync_time_usec += active_maps[i]->get_pm_sync_time_usec();
+		_new_pm_region_sync_count += active_maps[i]->get_pm_region_sync_count();
 
 		// Emit a signal if a map changed.
 		const uint32_t new_map_update_id = active_maps[i]->get_map_update_id();
@@ -1143,6 +1250,8 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+	pm_map_sync_time_usec = MIN(_new_pm_map_sync_time_usec, (uint64_t)INT32_MAX);
+	pm_region_sync_count = _new_pm_region_sync_count;
 }
 
 void GodotNavigationServer::init() {
@@ -1202,6 +1311,25 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 	return r_query_result;
 }
 
+void GodotNavigationServer::_query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) const {
+	p_batch->results[p_index] = _query_path(p_batch->parameters[p_index]);
+}
+
+void GodotNavigationServer::_query_paths(const LocalVector<PathQueryParameters> &p_parameters, LocalVector<PathQueryResult> &r_results) const {
+	r_results.resize(p_parameters.size());
+	if (p_parameters.size() < 2) {
+		NavigationServer3D::_query_paths(p_parameters, r_results);
+		return;
+	}
+
+	// Each worker thread keeps its own path search buffers, so the queries don't share anything they write to.
+	PathQueryBatch batch;
+	batch.parameters = p_parameters.ptr();
+	batch.results = r_results.ptr();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_query_path_batch_item, &batch, p_parameters.size(), -1, true, SNAME("NavigationServerPathQueries"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
@@ -1231,6 +1359,12 @@ int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 		case INFO_EDGE_FREE_COUNT: {
 			return pm_edge_free_count;
 		} break;
+		case INFO_MAP_SYNC_TIME: {
+			return pm_map_sync_time_usec;
+		} break;
+		case INFO_REGION_SYNC_COUNT: {
+			return pm_region_sync_count;
+		} break;
 	}
 
 	return 0;
@@ -32,6 +32,7 @@
 #define GODOT_NAVIGATION_SERVER_H
 
 #include "nav_agent.h"
+#include "nav_flow_field.h"
 #include "nav_link.h"
 #include "nav_map.h"
 #include "nav_obstacle.h"
@@ -77,6 +78,7 @@ class GodotNavigationServer : public NavigationServer3D {
 	mutable RID_Owner<NavRegion> region_owner;
 	mutable RID_Owner<NavAgent> agent_owner;
 	mutable RID_Owner<NavObstacle> obstacle_owner;
+	mutable RID_Owner<NavFlowField> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
@@ -95,6 +97,8 @@ class GodotNavigationServer : public NavigationServer3D {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_map_sync_time_usec = 0;
+	int pm_region_sync_count = 0;
 
 public:
 	GodotNavigationServer();
@@ -120,6 +124,9 @@ public:
 	COMMAND_2(map_set_use_edge_connections, RID, p_map, bool, p_enabled);
 	virtual bool map_get_use_edge_connections(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
+
 	COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin);
 	virtual real_t map_get_edge_connection_margin(RID p_map) const override;
 
@@ -191,6 +198,15 @@ public:
 	COMMAND_2(link_set_owner_id, RID, p_link, ObjectID, p_owner_id);
 	virtual ObjectID link_get_owner_id(RID p_link) const override;
 
+	virtual RID flow_field_create() override;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position);
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, Vector3 p_position) const override;
+
 	virtual RID agent_create() override;
 	COMMAND_2(agent_set_avoidance_enabled, RID, p_agent, bool, p_enabled);
 	virtual bool agent_get_avoidance_enabled(RID p_agent) const override;
@@ -235,6 +251,7 @@ public:
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
+	virtual int bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_tiles, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) override;
 
 	COMMAND_1(free, RID, p_object);
 
@@ -247,12 +264,19 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void _query_paths(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<NavigationUtilities::PathQueryResult> &r_results) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	struct PathQueryBatch {
+		const NavigationUtilities::PathQueryParameters *parameters = nullptr;
+		NavigationUtilities::PathQueryResult *results = nullptr;
+	};
+	void _query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) const;
 };
 
 #undef COMMAND_1
@@ -248,6 +248,9 @@ real_t FORWARD_1_C(map_get_cell_size, RID, p_map, rid_to_rid);
 void FORWARD_2(map_set_use_edge_connections, RID, p_map, bool, p_enabled, rid_to_rid, bool_to_bool);
 bool FORWARD_1_C(map_get_use_edge_connections, RID, p_map, rid_to_rid);
 
+void FORWARD_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled, rid_to_rid, bool_to_bool);
+bool FORWARD_1_C(map_get_use_hierarchical_pathfinding, RID, p_map, rid_to_rid);
+
 void FORWARD_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin, rid_to_rid, real_to_real);
 real_t FORWARD_1_C(map_get_edge_connection_margin, RID, p_map, rid_to_rid);
 
@@ -308,6 +311,16 @@ real_t FORWARD_1_C(link_get_travel_cost, RID, p_link, rid_to_rid);
 void FORWARD_2(link_set_owner_id, RID, p_link, ObjectID, p_owner_id, rid_to_rid, id_to_id);
 ObjectID FORWARD_1_C(link_get_owner_id, RID, p_link, rid_to_rid);
 
+RID FORWARD_0(flow_field_create);
+
+void FORWARD_2(flow_field_set_map, RID, p_flow_field, RID, p_map, rid_to_rid, rid_to_rid);
+RID FORWARD_1_C(flow_field_get_map, RID, p_flow_field, rid_to_rid);
+void FORWARD_2(flow_field_set_target_position, RID, p_flow_field, Vector2, p_position, rid_to_rid, v2_to_v3);
+Vector2 FORWARD_1_R_C(v3_to_v2, flow_field_get_target_position, RID, p_flow_field, rid_to_rid);
+void FORWARD_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers, rid_to_rid, uint32_to_uint32);
+uint32_t FORWARD_1_C(flow_field_get_navigation_layers, RID, p_flow_field, rid_to_rid);
+Vector2 FORWARD_2_R_C(v3_to_v2, flow_field_get_direction, RID, p_flow_field, Vector2, p_position, rid_to_rid, v2_to_v3);
+
 RID GodotNavigationServer2D::agent_create() {
 	RID agent = NavigationServer3D::get_singleton()->agent_create();
 	return agent;
@@ -367,3 +380,27 @@ void GodotNavigationServer2D::query_path(const Ref<NavigationPathQueryParameters
 	p_query_result->set_path_rids(_query_result.path_rids);
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
+
+void GodotNavigationServer2D::query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) const {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must be the same.");
+
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	parameters.resize(p_query_parameters.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		ERR_FAIL_COND(!query_parameters.is_valid());
+		ERR_FAIL_COND(!Ref<NavigationPathQueryResult2D>(p_query_results[i]).is_valid());
+		parameters[i] = query_parameters->get_parameters();
+	}
+
+	LocalVector<NavigationUtilities::PathQueryResult> results;
+	NavigationServer3D::get_singleton()->_query_paths(parameters, results);
+
+	for (int i = 0; i < p_query_results.size(); i++) {
+		Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		query_result->set_path(vector_v3_to_v2(results[i].path));
+		query_result->set_path_types(results[i].path_types);
+		query_result->set_path_rids(results[i].path_rids);
+		query_result->set_path_owner_ids(results[i].path_owner_ids);
+	}
+}
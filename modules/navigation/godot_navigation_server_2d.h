@@ -64,6 +64,8 @@ public:
 	virtual real_t map_get_cell_size(RID p_map) const override;
 	virtual void map_set_use_edge_connections(RID p_map, bool p_enabled) override;
 	virtual bool map_get_use_edge_connections(RID p_map) const override;
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) override;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
 	virtual void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) override;
 	virtual real_t map_get_edge_connection_margin(RID p_map) const override;
 	virtual void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) override;
@@ -136,6 +138,15 @@ public:
 	virtual void link_set_owner_id(RID p_link, ObjectID p_owner_id) override;
 	virtual ObjectID link_get_owner_id(RID p_link) const override;
 
+	virtual RID flow_field_create() override;
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) override;
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector2 p_position) override;
+	virtual Vector2 flow_field_get_target_position(RID p_flow_field) const override;
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) override;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector2 flow_field_get_direction(RID p_flow_field, Vector2 p_position) const override;
+
 	/// Creates the agent.
 	virtual RID agent_create() override;
 
@@ -220,6 +231,7 @@ public:
 	virtual void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const override;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) const override;
 
 	virtual void init() override;
 	virtual void sync() override;
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  nav_avoidance_grid.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_grid.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void NavAvoidanceGrid::_compute_item_cell(uint32_t p_index, const Vector2 *p_positions) {
+	const Vector2i cell = _get_cell(p_positions[p_index]);
+	item_cells[p_index] = cell.y * size.x + cell.x;
+}
+
+void NavAvoidanceGrid::build(const LocalVector<Vector2> &p_positions, bool p_use_threads) {
+	const uint32_t item_count = p_positions.size();
+	if (item_count == 0) {
+		clear();
+		return;
+	}
+
+	Rect2 bounds(p_positions[0], Vector2());
+	for (const Vector2 &position : p_positions) {
+		bounds.expand_to(position);
+	}
+
+	// Aim for a few items per cell, also when the items are spread along a line.
+	cell_size = Math::sqrt(bounds.size.x * bounds.size.y * ITEMS_PER_CELL / item_count);
+	cell_size = MAX(cell_size, MAX(bounds.size.x, bounds.size.y) * ITEMS_PER_CELL / item_count);
+	if (cell_size <= CMP_EPSILON) {
+		cell_size = 1.0;
+	}
+	origin = bounds.position;
+	size = Vector2i(int(bounds.size.x / cell_size) + 1, int(bounds.size.y / cell_size) + 1);
+
+	item_cells.resize(item_count);
+
+	if (p_use_threads && item_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavAvoidanceGrid::_compute_item_cell, p_positions.ptr(), item_count, -1, true, SNAME("NavAvoidanceGridCells"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < item_count; i++) {
+			_compute_item_cell(i, p_positions.ptr());
+		}
+	}
+
+	// Counting sort of the items by cell.
+	const uint32_t cell_count = size.x * size.y;
+	cell_offsets.resize(cell_count + 1);
+	memset(cell_offsets.ptr(), 0, (cell_count + 1) * sizeof(uint32_t));
+	for (uint32_t item_cell : item_cells) {
+		cell_offsets[item_cell]++;
+	}
+	for (uint32_t i = 1; i <= cell_count; i++) {
+		cell_offsets[i] += cell_offsets[i - 1];
+	}
+
+	// Fills each cell from its end, which leaves its offset at its beginning.
+	cell_items.resize(item_count);
+	for (uint32_t i = item_count; i-- > 0;) {
+		cell_items[--cell_offsets[item_cells[i]]] = i;
+	}
+}
+
+void NavAvoidanceGrid::clear() {
+	item_cells.clear();
+	cell_items.clear();
+	cell_offsets.clear();
+}
@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  nav_avoidance_grid.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_AVOIDANCE_GRID_H
+#define NAV_AVOIDANCE_GRID_H
+
+#include "core/math/rect2.h"
+#include "core/math/vector2.h"
+#include "core/math/vector2i.h"
+#include "core/templates/local_vector.h"
+
+/// Uniform grid over the avoidance agent positions, used for their neighbor queries.
+/// The cells are sized for a few agents each, so the queries visit the nearest cells
+/// first and stop as soon as the remaining cells are out of range.
+class NavAvoidanceGrid {
+	static const uint32_t ITEMS_PER_CELL = 4;
+
+	real_t cell_size = 1.0;
+	Vector2 origin;
+	Vector2i size;
+
+	LocalVector<uint32_t> item_cells;
+
+	/// The items sorted by cell, and where the items of each cell begin.
+	LocalVector<uint32_t> cell_items;
+	LocalVector<uint32_t> cell_offsets;
+
+	_FORCE_INLINE_ Vector2i _get_cell(const Vector2 &p_position) const {
+		const Vector2 cell = (p_position - origin) / cell_size;
+		return Vector2i(CLAMP(int(cell.x), 0, size.x - 1), CLAMP(int(cell.y), 0, size.y - 1));
+	}
+
+	void _compute_item_cell(uint32_t p_index, const Vector2 *p_positions);
+
+public:
+	void build(const LocalVector<Vector2> &p_positions, bool p_use_threads);
+	void clear();
+
+	/// Calls p_visit with the index of each item in the cells closer than the square root of r_range_sq,
+	/// nearest cells first. p_visit may shrink r_range_sq to end the query early.
+	template <typename F>
+	void query(const Vector2 &p_position, float &r_range_sq, F p_visit) const {
+		if (item_cells.is_empty()) {
+			return;
+		}
+
+		const Vector2i cell = _get_cell(p_position);
+
+		for (int ring = 0;; ring++) {
+			if (ring > 0) {
+				const real_t ring_distance = (ring - 1) * cell_size;
+				if (ring_distance * ring_distance >= r_range_sq) {
+					break;
+				}
+			}
+
+			const Vector2i begin = cell - Vector2i(ring, ring);
+			const Vector2i end = cell + Vector2i(ring, ring);
+			if (begin.x < 0 && begin.y < 0 && end.x >= size.x && end.y >= size.y) {
+				break;
+			}
+
+			for (int y = MAX(begin.y, 0); y <= MIN(end.y, size.y - 1); y++) {
+				// Only the outline of the ring, its inside was visited by the previous rings.
+				const bool full_row = y == begin.y || y == end.y;
+				const int step = full_row ? 1 : 2 * ring;
+				for (int x = full_row ? MAX(begin.x, 0) : begin.x; x <= MIN(end.x, size.x - 1); x += step) {
+					if (x < 0) {
+						continue;
+					}
+
+					const Vector2 cell_begin = origin + Vector2(x, y) * cell_size;
+					const real_t dx = MAX(real_t(0.0), MAX(cell_begin.x - p_position.x, p_position.x - (cell_begin.x + cell_size)));
+					const real_t dy = MAX(real_t(0.0), MAX(cell_begin.y - p_position.y, p_position.y - (cell_begin.y + cell_size)));
+					if (dx * dx + dy * dy >= r_range_sq) {
+						continue;
+					}
+
+					const uint32_t cell_index = y * size.x + x;
+					for (uint32_t i = cell_offsets[cell_index]; i < cell_offsets[cell_index + 1]; i++) {
+						p_visit(cell_items[i]);
+					}
+				}
+			}
+		}
+	}
+};
+
+#endif // NAV_AVOIDANCE_GRID_H
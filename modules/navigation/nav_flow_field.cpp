@@ -0,0 +1,257 @@
+/**************************************************************************/
+/*  nav_flow_field.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_flow_field.h"
+
+#include "nav_map.h"
+#include "nav_region.h"
+
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+struct FlowFieldQueueEntry {
+	uint32_t polygon_id = 0;
+	real_t cost = 0.0;
+};
+
+struct FlowFieldQueueEntryComparator {
+	_FORCE_INLINE_ bool operator()(const FlowFieldQueueEntry &p_a, const FlowFieldQueueEntry &p_b) const {
+		// Keeps the lowest cost on top of the heap.
+		return p_a.cost > p_b.cost;
+	}
+};
+
+struct FlowFieldIncomingConnection {
+	const gd::Polygon *polygon = nullptr;
+	const gd::Edge::Connection *connection = nullptr;
+};
+
+void NavFlowField::set_map(NavMap *p_map) {
+	if (map == p_map) {
+		return;
+	}
+
+	if (map) {
+		map->remove_flow_field(this);
+	}
+
+	map = p_map;
+	field_dirty = true;
+
+	if (map) {
+		map->add_flow_field(this);
+	}
+}
+
+void NavFlowField::set_target_position(const Vector3 &p_position) {
+	if (target_position == p_position) {
+		return;
+	}
+	target_position = p_position;
+	target_dirty = true;
+}
+
+void NavFlowField::set_navigation_layers(uint32_t p_navigation_layers) {
+	if (navigation_layers == p_navigation_layers) {
+		return;
+	}
+	navigation_layers = p_navigation_layers;
+	field_dirty = true;
+}
+
+bool NavFlowField::is_dirty() const {
+	return map && (field_dirty || target_dirty || map_update_id != map->get_map_update_id());
+}
+
+void NavFlowField::update() {
+	ERR_FAIL_NULL(map);
+
+	target_dirty = false;
+
+	Vector3 new_target_point;
+	const gd::Polygon *target_polygon = map->get_closest_polygon(target_position, navigation_layers, new_target_point);
+	const uint32_t new_target_polygon_id = target_polygon ? target_polygon->id : UINT32_MAX;
+	target_point = new_target_point;
+
+	// A target moving within its polygon keeps the directions of all the other polygons.
+	if (!field_dirty && map_update_id == map->get_map_update_id() && new_target_polygon_id == target_polygon_id) {
+		return;
+	}
+
+	field_dirty = false;
+	map_update_id = map->get_map_update_id();
+	target_polygon_id = new_target_polygon_id;
+
+	_search_polygon_flows();
+}
+
+void NavFlowField::_search_polygon_flows() {
+	const uint32_t map_polygon_count = map->get_polygon_count() + map->get_link_polygons().size();
+	polygon_flows.resize(map_polygon_count);
+	for (PolygonFlow &polygon_flow : polygon_flows) {
+		polygon_flow = PolygonFlow();
+	}
+
+	if (target_polygon_id == UINT32_MAX) {
+		return;
+	}
+
+	// The polygons on the navigation layers, by id.
+	LocalVector<const gd::Polygon *> polygons;
+	polygons.resize(map_polygon_count);
+	memset(polygons.ptr(), 0, map_polygon_count * sizeof(const gd::Polygon *));
+	for (const NavRegion *region : map->get_regions()) {
+		if (!region->get_enabled() || (navigation_layers & region->get_navigation_layers()) == 0) {
+			continue;
+		}
+		for (const gd::Polygon &polygon : region->get_polygons()) {
+			polygons[polygon.id] = &polygon;
+		}
+	}
+	for (const gd::Polygon &link_polygon : map->get_link_polygons()) {
+		if (link_polygon.owner && (navigation_layers & link_polygon.owner->get_navigation_layers()) != 0) {
+			polygons[link_polygon.id] = &link_polygon;
+		}
+	}
+
+	// The search runs from the target, so it walks the connections backwards.
+	LocalVector<uint32_t> incoming_offsets;
+	incoming_offsets.resize(map_polygon_count + 1);
+	memset(incoming_offsets.ptr(), 0, (map_polygon_count + 1) * sizeof(uint32_t));
+	for (const gd::Polygon *polygon : polygons) {
+		if (!polygon) {
+			continue;
+		}
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if (polygons[connection.polygon->id]) {
+					incoming_offsets[connection.polygon->id]++;
+				}
+			}
+		}
+	}
+	for (uint32_t i = 1; i <= map_polygon_count; i++) {
+		incoming_offsets[i] += incoming_offsets[i - 1];
+	}
+
+	LocalVector<FlowFieldIncomingConnection> incoming_connections;
+	incoming_connections.resize(incoming_offsets[map_polygon_count]);
+	for (const gd::Polygon *polygon : polygons) {
+		if (!polygon) {
+			continue;
+		}
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if (polygons[connection.polygon->id]) {
+					incoming_connections[--incoming_offsets[connection.polygon->id]] = { polygon, &connection };
+				}
+			}
+		}
+	}
+
+	// Dijkstra from the target polygon, with the same costs as the path queries.
+	SortArray<FlowFieldQueueEntry, FlowFieldQueueEntryComparator> heap;
+	LocalVector<FlowFieldQueueEntry> queue;
+
+	polygon_flows[target_polygon_id].cost = 0.0;
+	queue.push_back({ target_polygon_id, 0.0 });
+
+	while (!queue.is_empty()) {
+		heap.pop_heap(0, queue.size(), queue.ptr());
+		const FlowFieldQueueEntry entry = queue[queue.size() - 1];
+		queue.resize(queue.size() - 1);
+
+		if (entry.cost > polygon_flows[entry.polygon_id].cost) {
+			// Reached again for less since it was queued.
+			continue;
+		}
+
+		const gd::Polygon *to_polygon = polygons[entry.polygon_id];
+		for (uint32_t i = incoming_offsets[entry.polygon_id]; i < incoming_offsets[entry.polygon_id + 1]; i++) {
+			const FlowFieldIncomingConnection &incoming = incoming_connections[i];
+			const Vector3 pathway_center = (incoming.connection->pathway_start + incoming.connection->pathway_end) * 0.5;
+
+			real_t cost = entry.cost;
+			cost += incoming.polygon->center.distance_to(pathway_center) * incoming.polygon->owner->get_travel_cost();
+			cost += pathway_center.distance_to(to_polygon->center) * to_polygon->owner->get_travel_cost();
+			if (incoming.polygon->owner != to_polygon->owner) {
+				cost += to_polygon->owner->get_enter_cost();
+			}
+
+			PolygonFlow &polygon_flow = polygon_flows[incoming.polygon->id];
+			if (cost >= polygon_flow.cost) {
+				continue;
+			}
+			polygon_flow.cost = cost;
+			polygon_flow.pathway_start = incoming.connection->pathway_start;
+			polygon_flow.pathway_end = incoming.connection->pathway_end;
+			polygon_flow.next_polygon_id = entry.polygon_id;
+
+			queue.push_back({ incoming.polygon->id, cost });
+			heap.push_heap(0, queue.size() - 1, 0, queue[queue.size() - 1], queue.ptr());
+		}
+	}
+}
+
+Vector3 NavFlowField::get_direction(const Vector3 &p_position) const {
+	if (!map || target_polygon_id == UINT32_MAX) {
+		return Vector3();
+	}
+
+	Vector3 point;
+	const gd::Polygon *polygon = map->get_closest_polygon(p_position, navigation_layers, point);
+	if (!polygon || polygon->id >= polygon_flows.size()) {
+		return Vector3();
+	}
+
+	uint32_t polygon_id = polygon->id;
+	while (polygon_id != target_polygon_id) {
+		const PolygonFlow &polygon_flow = polygon_flows[polygon_id];
+		if (polygon_flow.next_polygon_id == UINT32_MAX) {
+			// The target can't be reached from here.
+			return Vector3();
+		}
+
+		const Vector3 pathway[2] = { polygon_flow.pathway_start, polygon_flow.pathway_end };
+		const Vector3 direction = Geometry3D::get_closest_point_to_segment(point, pathway) - point;
+		if (direction.length_squared() > CMP_EPSILON2) {
+			return direction.normalized();
+		}
+
+		// Already on the pathway, head on with the polygon it leads to.
+		polygon_id = polygon_flow.next_polygon_id;
+	}
+
+	const Vector3 direction = target_point - point;
+	if (direction.length_squared() > CMP_EPSILON2) {
+		return direction.normalized();
+	}
+	return Vector3();
+}
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  nav_flow_field.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_FLOW_FIELD_H
+#define NAV_FLOW_FIELD_H
+
+#include "nav_rid.h"
+#include "nav_utils.h"
+
+class NavMap;
+
+/// Directions toward one target for every polygon of a map, shared by all the agents heading there.
+class NavFlowField : public NavRid {
+public:
+	/// Where a polygon leads to on its way to the target.
+	struct PolygonFlow {
+		/// Pathway into the next polygon.
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+		uint32_t next_polygon_id = UINT32_MAX;
+		/// Cost to reach the target polygon, FLT_MAX when it can't be reached.
+		real_t cost = FLT_MAX;
+	};
+
+private:
+	NavMap *map = nullptr;
+	Vector3 target_position;
+	uint32_t navigation_layers = 1;
+
+	/// Set when the field has to be searched again, not only moved to a new target position.
+	bool field_dirty = true;
+	bool target_dirty = true;
+	uint32_t map_update_id = 0;
+
+	uint32_t target_polygon_id = UINT32_MAX;
+	Vector3 target_point;
+
+	/// Indexed by polygon id.
+	LocalVector<PolygonFlow> polygon_flows;
+
+	void _search_polygon_flows();
+
+public:
+	void set_map(NavMap *p_map);
+	NavMap *get_map() const {
+		return map;
+	}
+
+	void set_target_position(const Vector3 &p_position);
+	Vector3 get_target_position() const {
+		return target_position;
+	}
+
+	void set_navigation_layers(uint32_t p_navigation_layers);
+	uint32_t get_navigation_layers() const {
+		return navigation_layers;
+	}
+
+	bool is_dirty() const;
+	void update();
+
+	Vector3 get_direction(const Vector3 &p_position) const;
+};
+
+#endif // NAV_FLOW_FIELD_H
@@ -31,17 +31,119 @@
 #include "nav_map.h"
 
 #include "nav_agent.h"
+#include "nav_flow_field.h"
 #include "nav_link.h"
 #include "nav_obstacle.h"
 #include "nav_region.h"
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
 
 #include <Obstacle2d.h>
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+#define POLYGON_BVH_STACK_SIZE 64
+
+static thread_local gd::PathQueryScratch path_query_scratch;
+static thread_local uint32_t last_path_query_polygon_count = 0;
+
+// Gives back the search buffers in the state the next search expects, however the search returns.
+struct PathQueryScratchReset {
+	gd::PathQueryScratch &scratch;
+
+	PathQueryScratchReset(gd::PathQueryScratch &p_scratch) :
+			scratch(p_scratch) {}
+
+	~PathQueryScratchReset() {
+		last_path_query_polygon_count = scratch.navigation_polys.size();
+		for (const gd::NavigationPoly &np : scratch.navigation_polys) {
+			scratch.navigation_poly_ids[np.poly->id] = UINT32_MAX;
+		}
+		scratch.navigation_polys.clear();
+	}
+};
+
+// Search buffers of the portal graph searches running on this thread.
+struct PathCorridorScratch {
+	struct QueueEntry {
+		uint32_t portal = 0;
+		real_t cost = 0.0;
+		real_t estimated_cost = 0.0;
+	};
+
+	LocalVector<real_t> portal_costs;
+	LocalVector<uint32_t> portal_back_ids;
+	LocalVector<uint32_t> reached_portals;
+	LocalVector<QueueEntry> queue;
+	LocalVector<uint8_t> corridor;
+
+	void push(const QueueEntry &p_entry) {
+		uint32_t pos = queue.size();
+		queue.push_back(p_entry);
+		while (pos > 0) {
+			const uint32_t parent = (pos - 1) / 2;
+			if (queue[parent].estimated_cost <= p_entry.estimated_cost) {
+				break;
+			}
+			queue[pos] = queue[parent];
+			pos = parent;
+		}
+		queue[pos] = p_entry;
+	}
+
+	QueueEntry pop() {
+		const QueueEntry top = queue[0];
+		const QueueEntry last = queue[queue.size() - 1];
+		queue.resize(queue.size() - 1);
+		const uint32_t size = queue.size();
+		if (size == 0) {
+			return top;
+		}
+		uint32_t pos = 0;
+		while (true) {
+			uint32_t child = 2 * pos + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && queue[child + 1].estimated_cost < queue[child].estimated_cost) {
+				child++;
+			}
+			if (queue[child].estimated_cost >= last.estimated_cost) {
+				break;
+			}
+			queue[pos] = queue[child];
+			pos = child;
+		}
+		queue[pos] = last;
+		return top;
+	}
+
+	void reach(uint32_t p_portal, uint32_t p_back_portal, real_t p_cost, real_t p_estimated_cost) {
+		if (p_cost >= portal_costs[p_portal]) {
+			return;
+		}
+		if (portal_costs[p_portal] == FLT_MAX) {
+			reached_portals.push_back(p_portal);
+		}
+		portal_costs[p_portal] = p_cost;
+		portal_back_ids[p_portal] = p_back_portal;
+		push({ p_portal, p_cost, p_estimated_cost });
+	}
+
+	void reset() {
+		for (uint32_t portal : reached_portals) {
+			portal_costs[portal] = FLT_MAX;
+		}
+		reached_portals.clear();
+		queue.clear();
+	}
+};
+
+static thread_local PathCorridorScratch path_corridor_scratch;
+
 // Helper macro
 #define APPEND_METADATA(poly)                                  \
 	if (r_path_types) {                                        \
@@ -54,6 +156,18 @@
 		r_path_owners->push_back(poly->owner->get_owner_id()); \
 	}
 
+// Squared distance between two boxes, zero when they touch.
+static real_t _get_aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+	real_t ds = 0.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t gap = MAX(p_a.position[i] - (p_b.position[i] + p_b.size[i]), p_b.position[i] - (p_a.position[i] + p_a.size[i]));
+		if (gap > 0.0) {
+			ds += gap * gap;
+		}
+	}
+	return ds;
+}
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -94,12 +208,20 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	regenerate_links = true;
 }
 
+void NavMap::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	links_dirty = true;
+}
+
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 	if (link_connection_radius == p_link_connection_radius) {
 		return;
 	}
 	link_connection_radius = p_link_connection_radius;
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
@@ -115,6 +237,10 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
+uint32_t NavMap::get_last_path_query_polygon_count() {
+	return last_path_query_polygon_count;
+}
+
 Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
 	ERR_FAIL_COND_V_MSG(map_update_id == 0, Vector<Vector3>(), "NavigationServer map query failed because it was made before first map synchronization.");
 	// Clear metadata outputs.
@@ -128,41 +254,15 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		r_path_owners->clear();
 	}
 
+	last_path_query_polygon_count = 0;
+
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
+	// Only consider the polygons in regions with compatible layers.
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
+	const gd::Polygon *begin_poly = _get_closest_polygon_point(p_origin, true, p_navigation_layers, begin_point, nullptr);
+	const gd::Polygon *end_poly = _get_closest_polygon_point(p_destination, true, p_navigation_layers, end_point, nullptr);
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -194,9 +294,21 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// The search buffers are reused by the queries running on this thread.
+	gd::PathQueryScratch &scratch = path_query_scratch;
+	PathQueryScratchReset scratch_reset(scratch);
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	LocalVector<gd::NavigationPoly> &navigation_polys = scratch.navigation_polys;
+
+	// Index of each map polygon in the reachable navigation polys, UINT32_MAX when not reached yet.
+	LocalVector<uint32_t> &navigation_poly_ids = scratch.navigation_poly_ids;
+	const uint32_t map_polygon_count = polygon_count + link_polygons.size();
+	if (navigation_poly_ids.size() < map_polygon_count) {
+		const uint32_t old_size = navigation_poly_ids.size();
+		navigation_poly_ids.resize(map_polygon_count);
+		memset(navigation_poly_ids.ptr() + old_size, 0xFF, (map_polygon_count - old_size) * sizeof(uint32_t));
+	}
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -205,10 +317,16 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 	navigation_polys.push_back(begin_navigation_poly);
+	navigation_poly_ids[begin_poly->id] = 0;
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// Polygon IDs to visit, sorted by their estimated cost.
+	gd::NavigationPolyHeap to_visit(navigation_polys, scratch.heap);
+
+	// On hierarchical maps, only the regions and links along the path between them are searched first.
+	const uint8_t *corridor = nullptr;
+	if (use_hierarchical_pathfinding && _get_path_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, path_corridor_scratch.corridor)) {
+		corridor = path_corridor_scratch.corridor.ptr();
+	}
 
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
@@ -230,6 +348,9 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				if ((p_navigation_layers & connection.polygon->owner->get_navigation_layers()) == 0) {
 					continue;
 				}
+				if (corridor && !corridor[polygon_cluster_ids[connection.polygon->id]]) {
+					continue;
+				}
 
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
@@ -244,9 +365,9 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				const uint32_t already_visited_polygon_index = navigation_poly_ids[connection.polygon->id];
 
-				if (already_visited_polygon_index != -1) {
+				if (already_visited_polygon_index != UINT32_MAX) {
 					// Polygon already visited, check if we can reduce the travel cost.
 					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
 					if (new_distance < avp.traveled_distance) {
@@ -256,6 +377,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 						avp.back_navigation_edge_pathway_end = connection.pathway_end;
 						avp.traveled_distance = new_distance;
 						avp.entry = new_entry;
+						avp.distance_to_destination = new_entry.distance_to(end_point) * avp.poly->owner->get_travel_cost();
+						if (avp.heap_index != UINT32_MAX) {
+							to_visit.update(already_visited_polygon_index);
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
@@ -267,19 +392,36 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
 					new_navigation_poly.traveled_distance = new_distance;
 					new_navigation_poly.entry = new_entry;
+					new_navigation_poly.distance_to_destination = new_entry.distance_to(end_point) * connection.polygon->owner->get_travel_cost();
 					navigation_polys.push_back(new_navigation_poly);
+					navigation_poly_ids[connection.polygon->id] = new_navigation_poly.self_id;
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					to_visit.push(new_navigation_poly.self_id);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
-
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		if (to_visit.is_empty()) {
+			if (corridor) {
+				// The polygons of the corridor don't connect, search the whole map instead.
+				corridor = nullptr;
+				for (uint32_t i = 1; i < navigation_polys.size(); i++) {
+					navigation_poly_ids[navigation_polys[i].poly->id] = UINT32_MAX;
+				}
+				gd::NavigationPoly np = navigation_polys[0];
+				navigation_polys.clear();
+				navigation_polys.push_back(np);
+				least_cost_id = 0;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -342,11 +484,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			}
 
 			// Reset open and navigation_polys
+			for (uint32_t i = 1; i < navigation_polys.size(); i++) {
+				navigation_poly_ids[navigation_polys[i].poly->id] = UINT32_MAX;
+			}
 			gd::NavigationPoly np = navigation_polys[0];
 			navigation_polys.clear();
 			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
 			least_cost_id = 0;
 			prev_least_cost_id = -1;
 
@@ -355,20 +498,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Take the polygon with the minimum cost from the polygons to visit.
+		least_cost_id = to_visit.pop();
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -575,31 +706,84 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	return path;
 }
 
-Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
-	ERR_FAIL_COND_V_MSG(map_update_id == 0, Vector3(), "NavigationServer map query failed because it was made before first map synchronization.");
-	bool use_collision = p_use_collision;
-	Vector3 closest_point;
-	real_t closest_point_d = FLT_MAX;
+// Closest crossing of the segment with the polygons of a region, only improves on the given one.
+static void _get_region_closest_segment_intersection(const NavRegion *p_region, const Vector3 &p_from, const Vector3 &p_to, const gd::Polygon *&r_closest_polygon, real_t &r_closest_point_d, Vector3 &r_closest_point) {
+	const LocalVector<gd::PolygonBVHNode> &polygon_bvh = p_region->get_polygon_bvh();
+	const LocalVector<uint32_t> &polygon_bvh_indices = p_region->get_polygon_bvh_indices();
+	const LocalVector<gd::Polygon> &polygons = p_region->get_polygons();
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
+	uint32_t stack[POLYGON_BVH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const gd::PolygonBVHNode &node = polygon_bvh[node_index];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			ERR_FAIL_COND(stack_size + 2 > POLYGON_BVH_STACK_SIZE);
+			stack[stack_size++] = node.second_child;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const gd::Polygon &p = polygons[polygon_bvh_indices[i]];
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				Vector3 inters;
+				if (f.intersects_segment(p_from, p_to, &inters)) {
+					const real_t d = p_from.distance_to(inters);
+					if (d < r_closest_point_d || (d == r_closest_point_d && p.id < r_closest_polygon->id)) {
+						r_closest_polygon = &p;
+						r_closest_point = inters;
+						r_closest_point_d = d;
+					}
 				}
 			}
 		}
+	}
+}
+
+struct PolygonBVHStackEntry {
+	uint32_t node = 0;
+	real_t ds = 0.0;
+};
 
-		if (use_collision == false) {
+// Closest point of the polygon edges of a region to the segment, only improves on the given one.
+static void _get_region_closest_segment_edge_point(const NavRegion *p_region, const Vector3 &p_from, const Vector3 &p_to, const AABB &p_segment_aabb, const gd::Polygon *&r_closest_polygon, real_t &r_closest_point_ds, Vector3 &r_closest_point) {
+	const LocalVector<gd::PolygonBVHNode> &polygon_bvh = p_region->get_polygon_bvh();
+	const LocalVector<uint32_t> &polygon_bvh_indices = p_region->get_polygon_bvh_indices();
+	const LocalVector<gd::Polygon> &polygons = p_region->get_polygons();
+
+	PolygonBVHStackEntry stack[POLYGON_BVH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = PolygonBVHStackEntry();
+
+	while (stack_size > 0) {
+		const PolygonBVHStackEntry entry = stack[--stack_size];
+		if (entry.ds > r_closest_point_ds) {
+			continue;
+		}
+
+		const gd::PolygonBVHNode &node = polygon_bvh[entry.node];
+		if (node.count == 0) {
+			ERR_FAIL_COND(stack_size + 2 > POLYGON_BVH_STACK_SIZE);
+			PolygonBVHStackEntry first_child = { entry.node + 1, _get_aabb_distance_squared(polygon_bvh[entry.node + 1].aabb, p_segment_aabb) };
+			PolygonBVHStackEntry second_child = { node.second_child, _get_aabb_distance_squared(polygon_bvh[node.second_child].aabb, p_segment_aabb) };
+			if (second_child.ds < first_child.ds) {
+				SWAP(first_child, second_child);
+			}
+			stack[stack_size++] = second_child;
+			stack[stack_size++] = first_child;
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const gd::Polygon &p = polygons[polygon_bvh_indices[i]];
 			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
 				Vector3 a, b;
 
@@ -611,14 +795,115 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 						a,
 						b);
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
+				const real_t ds = a.distance_squared_to(b);
+				if (ds < r_closest_point_ds || (ds == r_closest_point_ds && p.id < r_closest_polygon->id)) {
+					r_closest_polygon = &p;
+					r_closest_point_ds = ds;
+					r_closest_point = b;
 				}
 			}
 		}
 	}
+}
+
+// Closest point of the polygon faces of a region to the point, only improves on the given one.
+static void _get_region_closest_polygon_point(const NavRegion *p_region, const Vector3 &p_point, const gd::Polygon *&r_closest_polygon, size_t &r_closest_point_id, real_t &r_closest_point_ds, Vector3 &r_point) {
+	const LocalVector<gd::PolygonBVHNode> &polygon_bvh = p_region->get_polygon_bvh();
+	const LocalVector<uint32_t> &polygon_bvh_indices = p_region->get_polygon_bvh_indices();
+	const LocalVector<gd::Polygon> &polygons = p_region->get_polygons();
+	const AABB point_aabb(p_point, Vector3());
+
+	PolygonBVHStackEntry stack[POLYGON_BVH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = PolygonBVHStackEntry();
+
+	while (stack_size > 0) {
+		const PolygonBVHStackEntry entry = stack[--stack_size];
+		// Nodes as far as the closest point so far are still visited, so ties go to the first polygon of the map.
+		if (entry.ds > r_closest_point_ds) {
+			continue;
+		}
+
+		const gd::PolygonBVHNode &node = polygon_bvh[entry.node];
+		if (node.count == 0) {
+			ERR_FAIL_COND(stack_size + 2 > POLYGON_BVH_STACK_SIZE);
+			PolygonBVHStackEntry first_child = { entry.node + 1, _get_aabb_distance_squared(polygon_bvh[entry.node + 1].aabb, point_aabb) };
+			PolygonBVHStackEntry second_child = { node.second_child, _get_aabb_distance_squared(polygon_bvh[node.second_child].aabb, point_aabb) };
+			if (second_child.ds < first_child.ds) {
+				SWAP(first_child, second_child);
+			}
+			stack[stack_size++] = second_child;
+			stack[stack_size++] = first_child;
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const gd::Polygon &p = polygons[polygon_bvh_indices[i]];
+
+			// For each face check the distance to the point.
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 inters = f.get_closest_point_to(p_point);
+				const real_t ds = inters.distance_squared_to(p_point);
+				if (ds < r_closest_point_ds || (ds == r_closest_point_ds && p.id < r_closest_polygon->id)) {
+					r_closest_polygon = &p;
+					r_closest_point_id = point_id;
+					r_closest_point_ds = ds;
+					r_point = inters;
+				}
+			}
+		}
+	}
+}
+
+struct RegionDistance {
+	const NavRegion *region = nullptr;
+	real_t ds = 0.0;
+
+	bool operator<(const RegionDistance &p_other) const {
+		return ds < p_other.ds;
+	}
+};
+
+Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
+	ERR_FAIL_COND_V_MSG(map_update_id == 0, Vector3(), "NavigationServer map query failed because it was made before first map synchronization.");
+
+	const gd::Polygon *closest_polygon = nullptr;
+	Vector3 closest_point;
+	real_t closest_point_d = FLT_MAX;
+
+	// Use the intersection with the navigation surface closest to the start of the segment.
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled() || region->get_polygon_bvh().is_empty()) {
+			continue;
+		}
+		_get_region_closest_segment_intersection(region, p_from, p_to, closest_polygon, closest_point_d, closest_point);
+	}
+
+	if (closest_polygon || p_use_collision) {
+		return closest_point;
+	}
+
+	// The segment doesn't cross the navigation surface, find the closest point on the polygon edges instead.
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	LocalVector<RegionDistance> region_distances;
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled() || region->get_polygon_bvh().is_empty()) {
+			continue;
+		}
+		region_distances.push_back({ region, _get_aabb_distance_squared(region->get_bounds(), segment_aabb) });
+	}
+	region_distances.sort();
+
+	real_t closest_point_ds = FLT_MAX;
+	for (const RegionDistance &region_distance : region_distances) {
+		if (region_distance.ds > closest_point_ds) {
+			break;
+		}
+		_get_region_closest_segment_edge_point(region_distance.region, p_from, p_to, segment_aabb, closest_polygon, closest_point_ds, closest_point);
+	}
 
 	return closest_point;
 }
@@ -643,52 +928,102 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
+	const gd::Polygon *closest_polygon = _get_closest_polygon_point(p_point, false, 0, result.point, &result.normal);
+	if (closest_polygon) {
+		result.owner = closest_polygon->owner->get_self();
+	}
+	return result;
+}
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
+const gd::Polygon *NavMap::_get_closest_polygon_point(const Vector3 &p_point, bool p_filter_layers, uint32_t p_navigation_layers, Vector3 &r_point, Vector3 *r_normal) const {
+	// Visit the regions nearest first, the others are skipped once they are further than the closest point.
+	const AABB point_aabb(p_point, Vector3());
+	LocalVector<RegionDistance> region_distances;
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled() || region->get_polygon_bvh().is_empty()) {
+			continue;
+		}
+		if (p_filter_layers && (p_navigation_layers & region->get_navigation_layers()) == 0) {
+			continue;
 		}
+		region_distances.push_back({ region, _get_aabb_distance_squared(region->get_bounds(), point_aabb) });
 	}
+	region_distances.sort();
 
-	return result;
+	const gd::Polygon *closest_polygon = nullptr;
+	size_t closest_point_id = 0;
+	real_t closest_point_ds = FLT_MAX;
+	for (const RegionDistance &region_distance : region_distances) {
+		if (region_distance.ds > closest_point_ds) {
+			break;
+		}
+		_get_region_closest_polygon_point(region_distance.region, p_point, closest_polygon, closest_point_id, closest_point_ds, r_point);
+	}
+
+	if (closest_polygon && r_normal) {
+		const Face3 f(closest_polygon->points[0].pos, closest_polygon->points[closest_point_id - 1].pos, closest_polygon->points[closest_point_id].pos);
+		*r_normal = f.get_plane().normal;
+	}
+	return closest_polygon;
 }
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+
+		// The polygons of the region can be freed before the next sync, forget the link entries pointing to them.
+		const LocalVector<gd::Polygon> &region_polygons = p_region->get_polygons();
+		if (!region_polygons.is_empty()) {
+			const gd::Polygon *region_polygons_begin = region_polygons.ptr();
+			const gd::Polygon *region_polygons_end = region_polygons_begin + region_polygons.size();
+			for (int64_t i = link_entry_polygons.size() - 1; i >= 0; i--) {
+				if (link_entry_polygons[i] >= region_polygons_begin && link_entry_polygons[i] < region_polygons_end) {
+					link_entry_polygons.remove_at_unordered(i);
+				}
+			}
+			removed_region_bounds.push_back(p_region->get_bounds());
+		}
+		region_edge_counts.erase(p_region);
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		links_dirty = true;
+	}
+}
+
+void NavMap::add_flow_field(NavFlowField *p_flow_field) {
+	flow_fields.push_back(p_flow_field);
+}
+
+void NavMap::remove_flow_field(NavFlowField *p_flow_field) {
+	int64_t flow_field_index = flow_fields.find(p_flow_field);
+	if (flow_field_index >= 0) {
+		flow_fields.remove_at_unordered(flow_field_index);
 	}
 }
 
+const gd::Polygon *NavMap::get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_point) const {
+	return _get_closest_polygon_point(p_point, true, p_navigation_layers, r_point, nullptr);
+}
+
+void NavMap::_update_flow_field(uint32_t p_index, NavFlowField **p_flow_fields) {
+	p_flow_fields[p_index]->update();
+}
+
 bool NavMap::has_agent(NavAgent *agent) const {
 	return (agents.find(agent) >= 0);
 }
@@ -769,187 +1104,483 @@ void NavMap::remove_agent_as_controlled(NavAgent *agent) {
 	}
 }
 
-void NavMap::sync() {
-	// Performance Monitor
-	int _new_pm_region_count = regions.size();
-	int _new_pm_agent_count = agents.size();
-	int _new_pm_link_count = links.size();
-	int _new_pm_polygon_count = pm_polygon_count;
-	int _new_pm_edge_count = pm_edge_count;
-	int _new_pm_edge_merge_count = pm_edge_merge_count;
-	int _new_pm_edge_connection_count = pm_edge_connection_count;
-	int _new_pm_edge_free_count = pm_edge_free_count;
+void NavMap::_build_path_clusters() {
+	path_clusters.clear();
+	path_portals.clear();
+	polygon_cluster_ids.clear();
+	if (!use_hierarchical_pathfinding) {
+		return;
+	}
 
-	// Check if we need to update the links.
-	if (regenerate_polygons) {
-		for (NavRegion *region : regions) {
-			region->scratch_polygons();
+	polygon_cluster_ids.resize(polygon_count + link_polygons.size());
+	memset(polygon_cluster_ids.ptr(), 0xFF, polygon_cluster_ids.size() * sizeof(uint32_t));
+
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled() || region->get_polygons().is_empty()) {
+			continue;
 		}
-		regenerate_links = true;
+		const uint32_t cluster_id = path_clusters.size();
+		path_clusters.push_back(PathCluster());
+		path_clusters[cluster_id].owner = region;
+		for (const gd::Polygon &polygon : region->get_polygons()) {
+			polygon_cluster_ids[polygon.id] = cluster_id;
+		}
+	}
+	for (const gd::Polygon &link_polygon : link_polygons) {
+		if (link_polygon.owner == nullptr) {
+			// Link not connected to the map.
+			continue;
+		}
+		const uint32_t cluster_id = path_clusters.size();
+		path_clusters.push_back(PathCluster());
+		path_clusters[cluster_id].owner = link_polygon.owner;
+		polygon_cluster_ids[link_polygon.id] = cluster_id;
 	}
 
-	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+	// One portal per pair of connected clusters and direction.
+	HashMap<uint64_t, uint32_t> portal_ids;
+	LocalVector<uint32_t> portal_connection_counts;
+	auto add_portal_connection = [&](uint32_t p_from_cluster, const gd::Edge::Connection &p_connection) {
+		const uint32_t to_cluster = polygon_cluster_ids[p_connection.polygon->id];
+		if (to_cluster == UINT32_MAX || to_cluster == p_from_cluster) {
+			return;
+		}
+		const uint64_t key = (uint64_t(p_from_cluster) << 32) | to_cluster;
+		HashMap<uint64_t, uint32_t>::Iterator portal_id = portal_ids.find(key);
+		if (!portal_id) {
+			portal_id = portal_ids.insert(key, path_portals.size());
+			PathPortal portal;
+			portal.from_cluster = p_from_cluster;
+			portal.to_cluster = to_cluster;
+			path_portals.push_back(portal);
+			portal_connection_counts.push_back(0);
+			path_clusters[p_from_cluster].exit_portals.push_back(portal_id->value);
+		}
+		path_portals[portal_id->value].position += (p_connection.pathway_start + p_connection.pathway_end) * 0.5;
+		portal_connection_counts[portal_id->value] += 1;
+	};
+
+	const gd::Polygon *link_polygons_begin = link_polygons.ptr();
+	const gd::Polygon *link_polygons_end = link_polygons_begin + link_polygons.size();
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled() || region->get_polygons().is_empty()) {
+			continue;
+		}
+		for (const gd::FreeEdge &free_edge : region->get_free_edges()) {
+			const gd::Polygon *polygon = free_edge.connection.polygon;
+			const uint32_t from_cluster = polygon_cluster_ids[polygon->id];
+			for (const gd::Edge::Connection &connection : polygon->edges[free_edge.connection.edge].connections) {
+				// The link entries are added below.
+				if (connection.polygon >= link_polygons_begin && connection.polygon < link_polygons_end) {
+					continue;
+				}
+				add_portal_connection(from_cluster, connection);
+			}
 		}
 	}
 
-	for (NavLink *link : links) {
-		if (link->check_dirty()) {
-			regenerate_links = true;
+	HashSet<const gd::Polygon *> added_link_entry_polygons;
+	for (const gd::Polygon *polygon : link_entry_polygons) {
+		if (added_link_entry_polygons.has(polygon)) {
+			continue;
+		}
+		added_link_entry_polygons.insert(polygon);
+		for (const gd::Edge::Connection &connection : polygon->edges[0].connections) {
+			if (connection.polygon >= link_polygons_begin && connection.polygon < link_polygons_end) {
+				add_portal_connection(polygon_cluster_ids[polygon->id], connection);
+			}
 		}
 	}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
+	for (const gd::Polygon &link_polygon : link_polygons) {
+		if (link_polygon.owner == nullptr) {
+			continue;
+		}
+		for (const gd::Edge &edge : link_polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				add_portal_connection(polygon_cluster_ids[link_polygon.id], connection);
+			}
+		}
+	}
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
+	for (uint32_t i = 0; i < path_portals.size(); i++) {
+		path_portals[i].position /= real_t(portal_connection_counts[i]);
+	}
+}
+
+bool NavMap::_get_path_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const {
+	if (path_clusters.is_empty()) {
+		return false;
+	}
+	const uint32_t begin_cluster = polygon_cluster_ids[p_begin_poly->id];
+	const uint32_t end_cluster = polygon_cluster_ids[p_end_poly->id];
+	if (begin_cluster == UINT32_MAX || end_cluster == UINT32_MAX || begin_cluster == end_cluster) {
+		return false;
+	}
+
+	PathCorridorScratch &scratch = path_corridor_scratch;
+	if (scratch.portal_costs.size() < path_portals.size()) {
+		const uint32_t old_size = scratch.portal_costs.size();
+		scratch.portal_costs.resize(path_portals.size());
+		scratch.portal_back_ids.resize(path_portals.size());
+		for (uint32_t i = old_size; i < path_portals.size(); i++) {
+			scratch.portal_costs[i] = FLT_MAX;
 		}
+	}
 
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			count += region->get_polygons().size();
+	// A* over the portals, with the same costs as the polygon search.
+	const PathCluster &begin = path_clusters[begin_cluster];
+	for (uint32_t portal_id : begin.exit_portals) {
+		const PathPortal &portal = path_portals[portal_id];
+		const NavBase *to_owner = path_clusters[portal.to_cluster].owner;
+		if ((p_navigation_layers & to_owner->get_navigation_layers()) == 0) {
+			continue;
 		}
-		polygons.resize(count);
+		const real_t cost = p_begin_point.distance_to(portal.position) * begin.owner->get_travel_cost() + to_owner->get_enter_cost();
+		scratch.reach(portal_id, UINT32_MAX, cost, cost + portal.position.distance_to(p_end_point));
+	}
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
+	uint32_t end_portal = UINT32_MAX;
+	while (!scratch.queue.is_empty()) {
+		const PathCorridorScratch::QueueEntry entry = scratch.pop();
+		if (entry.cost > scratch.portal_costs[entry.portal]) {
+			// Reached again for less since it was queued.
+			continue;
+		}
+
+		const PathPortal &portal = path_portals[entry.portal];
+		if (portal.to_cluster == end_cluster) {
+			end_portal = entry.portal;
+			break;
+		}
+
+		const PathCluster &cluster = path_clusters[portal.to_cluster];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+		for (uint32_t next_portal_id : cluster.exit_portals) {
+			const PathPortal &next_portal = path_portals[next_portal_id];
+			const NavBase *to_owner = path_clusters[next_portal.to_cluster].owner;
+			if ((p_navigation_layers & to_owner->get_navigation_layers()) == 0) {
 				continue;
 			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
-			}
-			count += region->get_polygons().size();
+			const real_t cost = entry.cost + portal.position.distance_to(next_portal.position) * travel_cost + to_owner->get_enter_cost();
+			scratch.reach(next_portal_id, entry.portal, cost, cost + next_portal.position.distance_to(p_end_point));
 		}
+	}
 
-		_new_pm_polygon_count = polygons.size();
+	if (end_portal != UINT32_MAX) {
+		r_corridor.resize(path_clusters.size());
+		memset(r_corridor.ptr(), 0, r_corridor.size());
+		for (uint32_t portal_id = end_portal; portal_id != UINT32_MAX; portal_id = scratch.portal_back_ids[portal_id]) {
+			r_corridor[path_portals[portal_id].from_cluster] = 1;
+			r_corridor[path_portals[portal_id].to_cluster] = 1;
+		}
+	}
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+	scratch.reset();
+	return end_portal != UINT32_MAX;
+}
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
+real_t NavMap::_get_region_neighbor_margin() const {
+	// Edges merge when their points fall in the same cell, so neighbors can be a cell apart.
+	return MAX(edge_connection_margin, MAX(cell_size, cell_height));
+}
+
+void NavMap::_remove_link_entry_connections() {
+	if (!link_polygons.is_empty()) {
+		const gd::Polygon *link_polygons_begin = link_polygons.ptr();
+		const gd::Polygon *link_polygons_end = link_polygons_begin + link_polygons.size();
+		for (gd::Polygon *polygon : link_entry_polygons) {
+			Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+			for (int i = connections.size() - 1; i >= 0; i--) {
+				if (connections[i].polygon >= link_polygons_begin && connections[i].polygon < link_polygons_end) {
+					connections.remove_at(i);
 				}
 			}
 		}
+	}
+	link_entry_polygons.clear();
+}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
+void NavMap::_update_region_connections(const LocalVector<NavRegion *> &p_regions) {
+	const real_t neighbor_margin = _get_region_neighbor_margin();
+
+	// Regions close enough to each region to share or connect edges with it.
+	LocalVector<LocalVector<const NavRegion *>> region_neighbors;
+	region_neighbors.resize(p_regions.size());
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		const NavRegion *region = p_regions[i];
+		if (!region->get_enabled() || region->get_polygon_bvh().is_empty()) {
+			continue;
+		}
+		const AABB bounds = region->get_bounds().grow(neighbor_margin);
+		for (const NavRegion *other_region : regions) {
+			if (other_region == region || !other_region->get_enabled() || other_region->get_polygon_bvh().is_empty()) {
+				continue;
+			}
+			if (bounds.intersects_inclusive(other_region->get_bounds())) {
+				region_neighbors[i].push_back(other_region);
+			}
+		}
+	}
+
+	// Find the free edges shared with another region first, those are not connected by margin.
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		for (gd::FreeEdge &free_edge : p_regions[i]->get_free_edges()) {
+			free_edge.merged = false;
+			for (const NavRegion *other_region : region_neighbors[i]) {
+				if (other_region->get_free_edge_keys().has(free_edge.key)) {
+					free_edge.merged = true;
+					break;
 				}
 			}
 		}
+	}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		NavRegion *region = p_regions[i];
+		LocalVector<gd::FreeEdge> &free_edges = region->get_free_edges();
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+		// Remove the previous connections of the region.
+		for (gd::FreeEdge &free_edge : free_edges) {
+			free_edge.connection.polygon->edges[free_edge.connection.edge].connections.clear();
+		}
+		region->get_connections().clear();
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
+		if (!region->get_enabled() || free_edges.is_empty()) {
+			region_edge_counts.erase(region);
+			continue;
+		}
+
+		RegionEdgeCounts counts;
+		const bool region_use_edge_connections = use_edge_connections && region->get_use_edge_connections();
+
+		for (gd::FreeEdge &free_edge : free_edges) {
+			const gd::Edge::Connection &connection = free_edge.connection;
+			gd::Edge &edge = connection.polygon->edges[connection.edge];
+
+			if (free_edge.merged) {
+				// Connect edge that are shared in different regions.
+				for (const NavRegion *other_region : region_neighbors[i]) {
+					const uint32_t *other_edge_index = other_region->get_free_edge_keys().getptr(free_edge.key);
+					if (!other_edge_index) {
+						continue;
+					}
+					if (!edge.connections.is_empty()) {
+						// The edge is already connected with another edge, skip.
+						ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
+						continue;
+					}
+					// Note: The pathway_start/end are full for those connection and do not need to be modified.
+					edge.connections.push_back(other_region->get_free_edges()[*other_edge_index].connection);
 				}
+				counts.edge_merge_count += 1;
+				continue;
+			}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+			if (!region_use_edge_connections) {
+				continue;
+			}
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+			// Find the compatible near edges.
+			//
+			// Note:
+			// Considering that the edges must be compatible (for obvious reasons)
+			// to be connected, create new polygons to remove that small gap is
+			// not really useful and would result in wasteful computation during
+			// connection, integration and path finding.
+			counts.edge_free_count += 1;
+
+			Vector3 edge_p1 = connection.polygon->points[connection.edge].pos;
+			Vector3 edge_p2 = connection.polygon->points[(connection.edge + 1) % connection.polygon->points.size()].pos;
+			AABB edge_aabb(edge_p1, Vector3());
+			edge_aabb.expand_to(edge_p2);
+			edge_aabb = edge_aabb.grow(edge_connection_margin);
+
+			for (const NavRegion *other_region : region_neighbors[i]) {
+				if (!other_region->get_use_edge_connections()) {
 					continue;
 				}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+				for (const gd::FreeEdge &other_free_edge : other_region->get_free_edges()) {
+					if (other_free_edge.merged) {
+						continue;
+					}
+					const gd::Edge::Connection &other_edge = other_free_edge.connection;
+
+					Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+					Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+					AABB other_edge_aabb(other_edge_p1, Vector3());
+					other_edge_aabb.expand_to(other_edge_p2);
+					if (!edge_aabb.intersects_inclusive(other_edge_aabb)) {
+						continue;
+					}
+
+					// Compute the projection of the opposite edge on the current one
+					Vector3 edge_vector = edge_p2 - edge_p1;
+					real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+					real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+					if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+						continue;
+					}
+
+					// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+					Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+					Vector3 other1;
+					if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+						other1 = other_edge_p1;
+					} else {
+						other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+					}
+					if (other1.distance_to(self1) > edge_connection_margin) {
+						continue;
+					}
+
+					Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+					Vector3 other2;
+					if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+						other2 = other_edge_p2;
+					} else {
+						other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+					}
+					if (other2.distance_to(self2) > edge_connection_margin) {
+						continue;
+					}
+
+					// The edges can now be connected.
+					gd::Edge::Connection new_connection = other_edge;
+					new_connection.pathway_start = (self1 + other1) / 2.0;
+					new_connection.pathway_end = (self2 + other2) / 2.0;
+					edge.connections.push_back(new_connection);
+
+					// Add the connection to the region_connection map.
+					region->get_connections().push_back(new_connection);
+					counts.edge_connection_count += 1;
 				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
+			}
+		}
+
+		region_edge_counts[region] = counts;
+	}
+}
+
+void NavMap::sync() {
+	const uint64_t sync_start_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Performance Monitor
+	int _new_pm_region_count = regions.size();
+	int _new_pm_agent_count = agents.size();
+	int _new_pm_link_count = links.size();
+	int _new_pm_polygon_count = pm_polygon_count;
+	int _new_pm_edge_count = pm_edge_count;
+	int _new_pm_edge_merge_count = pm_edge_merge_count;
+	int _new_pm_edge_connection_count = pm_edge_connection_count;
+	int _new_pm_edge_free_count = pm_edge_free_count;
+	int _new_pm_region_sync_count = 0;
+
+	// Check if we need to update the links.
+	if (regenerate_polygons) {
+		for (NavRegion *region : regions) {
+			region->scratch_polygons();
+		}
+		regenerate_links = true;
+	}
+
+	for (NavLink *link : links) {
+		if (link->check_dirty()) {
+			links_dirty = true;
+		}
+	}
+
+	// Only the regions that changed, and their neighbors, are connected again.
+	LocalVector<bool> region_changed;
+	region_changed.resize(regions.size());
+	LocalVector<AABB> changed_bounds = removed_region_bounds;
+	removed_region_bounds.clear();
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		region_changed[i] = regions[i]->is_dirty();
+		if (region_changed[i]) {
+			_new_pm_region_sync_count += 1;
+			if (!regions[i]->get_polygon_bvh().is_empty()) {
+				changed_bounds.push_back(regions[i]->get_bounds());
+			}
+		}
+	}
+
+	if (regenerate_links || links_dirty || _new_pm_region_sync_count > 0 || !changed_bounds.is_empty()) {
+		// The link entries are rebuilt below, and the polygons of the changed regions are about to be freed.
+		_remove_link_entry_connections();
+
+		polygon_count = 0;
+		for (uint32_t i = 0; i < regions.size(); i++) {
+			NavRegion *region = regions[i];
+			if (region_changed[i]) {
+				region->sync();
+				if (!region->get_polygon_bvh().is_empty()) {
+					changed_bounds.push_back(region->get_bounds());
 				}
+			}
+			region->set_polygon_id_offset(polygon_count);
+			polygon_count += region->get_polygons().size();
+		}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+		LocalVector<NavRegion *> dirty_regions;
+		if (regenerate_links) {
+			dirty_regions = regions;
+		} else if (!changed_bounds.is_empty()) {
+			const real_t neighbor_margin = _get_region_neighbor_margin();
+			for (uint32_t i = 0; i < regions.size(); i++) {
+				NavRegion *region = regions[i];
+				if (region_changed[i]) {
+					dirty_regions.push_back(region);
+					continue;
 				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
+				if (!region->get_enabled() || region->get_polygon_bvh().is_empty()) {
 					continue;
 				}
+				const AABB bounds = region->get_bounds().grow(neighbor_margin);
+				for (const AABB &other_bounds : changed_bounds) {
+					if (bounds.intersects_inclusive(other_bounds)) {
+						dirty_regions.push_back(region);
+						break;
+					}
+				}
+			}
+		}
+
+		_update_region_connections(dirty_regions);
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+		_new_pm_polygon_count = 0;
+		_new_pm_edge_count = 0;
+		_new_pm_edge_merge_count = 0;
+		_new_pm_edge_connection_count = 0;
+		_new_pm_edge_free_count = 0;
 
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+		// Edges merged with another region are counted by both regions.
+		int region_edge_merge_count = 0;
+		for (const NavRegion *region : regions) {
+			if (!region->get_enabled()) {
+				continue;
+			}
+			_new_pm_polygon_count += region->get_polygons().size();
+			_new_pm_edge_count += region->get_edge_count();
+			_new_pm_edge_merge_count += region->get_edge_merge_count();
+
+			const RegionEdgeCounts *counts = region_edge_counts.getptr(region);
+			if (counts) {
+				region_edge_merge_count += counts->edge_merge_count;
+				_new_pm_edge_free_count += counts->edge_free_count;
+				_new_pm_edge_connection_count += counts->edge_connection_count;
 			}
 		}
+		_new_pm_edge_count -= region_edge_merge_count / 2;
+		_new_pm_edge_merge_count += region_edge_merge_count / 2;
 
 		uint32_t link_poly_idx = 0;
+		link_polygons.clear();
 		link_polygons.resize(links.size());
+		for (uint32_t i = 0; i < link_polygons.size(); i++) {
+			link_polygons[i].id = polygon_count + i;
+		}
 
 		// Search for polygons within range of a nav link.
 		for (const NavLink *link : links) {
@@ -959,48 +1590,20 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
+			// Pick the polygons closest to the start and end points, if within our radius.
+			// The map owns the connections of the region polygons, so they are modified here.
 			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
 			Vector3 closest_start_point;
+			const gd::Polygon *start_poly = _get_closest_polygon_point(start, false, 0, closest_start_point, nullptr);
+			if (start_poly && closest_start_point.distance_to(start) < link_connection_radius) {
+				closest_start_polygon = const_cast<gd::Polygon *>(start_poly);
+			}
 
 			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			const gd::Polygon *end_poly = _get_closest_polygon_point(end, false, 0, closest_end_point, nullptr);
+			if (end_poly && closest_end_point.distance_to(end) < link_connection_radius) {
+				closest_end_polygon = const_cast<gd::Polygon *>(end_poly);
 			}
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
@@ -1034,6 +1637,7 @@ void NavMap::sync() {
 					entry_connection.pathway_start = new_polygon.points[0].pos;
 					entry_connection.pathway_end = new_polygon.points[1].pos;
 					closest_start_polygon->edges[0].connections.push_back(entry_connection);
+					link_entry_polygons.push_back(closest_start_polygon);
 
 					gd::Edge::Connection exit_connection;
 					exit_connection.polygon = closest_end_polygon;
@@ -1051,6 +1655,7 @@ void NavMap::sync() {
 					entry_connection.pathway_start = new_polygon.points[2].pos;
 					entry_connection.pathway_end = new_polygon.points[3].pos;
 					closest_end_polygon->edges[0].connections.push_back(entry_connection);
+					link_entry_polygons.push_back(closest_end_polygon);
 
 					gd::Edge::Connection exit_connection;
 					exit_connection.polygon = closest_start_polygon;
@@ -1062,11 +1667,29 @@ void NavMap::sync() {
 			}
 		}
 
+		_build_path_clusters();
+
 		// Update the update ID.
 		// Some code treats 0 as a failure case, so we avoid returning 0.
 		map_update_id = map_update_id % 9999999 + 1;
 	}
 
+	// Search the flow fields again for their new targets, or the new map.
+	LocalVector<NavFlowField *> dirty_flow_fields;
+	for (NavFlowField *flow_field : flow_fields) {
+		if (flow_field->is_dirty()) {
+			dirty_flow_fields.push_back(flow_field);
+		}
+	}
+	if (use_threads && dirty_flow_fields.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_update_flow_field, dirty_flow_fields.ptr(), dirty_flow_fields.size(), -1, true, SNAME("NavigationFlowFields"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (NavFlowField *flow_field : dirty_flow_fields) {
+			flow_field->update();
+		}
+	}
+
 	// Do we have modified obstacle positions?
 	for (NavObstacle *obstacle : obstacles) {
 		if (obstacle->check_dirty()) {
@@ -1087,6 +1710,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	links_dirty = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
 
@@ -1099,6 +1723,8 @@ void NavMap::sync() {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+	pm_region_sync_count = _new_pm_region_sync_count;
+	pm_sync_time_usec = OS::get_singleton()->get_ticks_usec() - sync_start_usec;
 }
 
 void NavMap::_update_rvo_obstacles_tree_2d() {
@@ -1180,23 +1806,50 @@ void NavMap::_update_rvo_obstacles_tree_2d() {
 }
 
 void NavMap::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
-	for (NavAgent *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+	LocalVector<Vector2> positions;
+	positions.resize(active_2d_avoidance_agents.size());
+	for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+		const RVO2D::Vector2 &position = active_2d_avoidance_agents[i]->get_rvo_agent_2d()->position_;
+		positions[i] = Vector2(position.x(), position.y());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+	avoidance_agents_grid_2d.build(positions, use_threads && avoidance_use_multiple_threads);
 }
 
 void NavMap::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
-	for (NavAgent *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+	// The agents are spread over the ground plane, their height is left to the distance checks.
+	LocalVector<Vector2> positions;
+	positions.resize(active_3d_avoidance_agents.size());
+	for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+		const RVO3D::Vector3 &position = active_3d_avoidance_agents[i]->get_rvo_agent_3d()->position_;
+		positions[i] = Vector2(position.x(), position.z());
+	}
+	avoidance_agents_grid_3d.build(positions, use_threads && avoidance_use_multiple_threads);
+}
+
+void NavMap::_compute_rvo_agent_neighbors_2d(RVO2D::Agent2D *p_agent) {
+	p_agent->obstacleNeighbors_.clear();
+	const float obstacle_range = p_agent->timeHorizonObst_ * p_agent->maxSpeed_ + p_agent->radius_;
+	rvo_simulation_2d.kdTree_->computeObstacleNeighbors(p_agent, obstacle_range * obstacle_range);
+
+	p_agent->agentNeighbors_.clear();
+
+	if (p_agent->maxNeighbors_ > 0) {
+		float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+		avoidance_agents_grid_2d.query(Vector2(p_agent->position_.x(), p_agent->position_.y()), range_sq, [&](uint32_t p_index) {
+			p_agent->insertAgentNeighbor(active_2d_avoidance_agents[p_index]->get_rvo_agent_2d(), range_sq);
+		});
+	}
+}
+
+void NavMap::_compute_rvo_agent_neighbors_3d(RVO3D::Agent3D *p_agent) {
+	p_agent->agentNeighbors_.clear();
+
+	if (p_agent->maxNeighbors_ > 0) {
+		float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+		avoidance_agents_grid_3d.query(Vector2(p_agent->position_.x(), p_agent->position_.z()), range_sq, [&](uint32_t p_index) {
+			p_agent->insertAgentNeighbor(active_3d_avoidance_agents[p_index]->get_rvo_agent_3d(), range_sq);
+		});
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
 }
 
 void NavMap::_update_rvo_simulation() {
@@ -1210,14 +1863,14 @@ void NavMap::_update_rvo_simulation() {
 }
 
 void NavMap::compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+	_compute_rvo_agent_neighbors_2d((*(agent + index))->get_rvo_agent_2d());
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 	(*(agent + index))->update();
 }
 
 void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+	_compute_rvo_agent_neighbors_3d((*(agent + index))->get_rvo_agent_3d());
 	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 	(*(agent + index))->update();
@@ -1235,7 +1888,7 @@ void NavMap::step(real_t p_deltatime) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+				_compute_rvo_agent_neighbors_2d(agent->get_rvo_agent_2d());
 				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 				agent->update();
@@ -1249,7 +1902,7 @@ void NavMap::step(real_t p_deltatime) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+				_compute_rvo_agent_neighbors_3d(agent->get_rvo_agent_3d());
 				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 				agent->update();
@@ -31,9 +31,11 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_avoidance_grid.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
+#include "core/math/aabb.h"
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
 
@@ -42,6 +44,7 @@
 #include <RVOSimulator2d.h>
 #include <RVOSimulator3d.h>
 
+class NavFlowField;
 class NavLink;
 class NavRegion;
 class NavAgent;
@@ -64,7 +67,10 @@ class NavMap : public NavRid {
 	real_t link_connection_radius = 1.0;
 
 	bool regenerate_polygons = true;
+	/// Forces the connections of all regions to be rebuilt.
 	bool regenerate_links = true;
+	/// Set when the links need to be connected again.
+	bool links_dirty = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
@@ -72,9 +78,42 @@ class NavMap : public NavRid {
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
-
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	/// Region polygons holding a connection that enters a link polygon.
+	LocalVector<gd::Polygon *> link_entry_polygons;
+
+	/// Number of region polygons, the link polygon ids start after them.
+	uint32_t polygon_count = 0;
+
+	/// Bounds of the regions removed since the last sync, their neighbors need to be connected again.
+	LocalVector<AABB> removed_region_bounds;
+
+	/// Edge statistics of the connections between a region and its neighbors.
+	struct RegionEdgeCounts {
+		int edge_merge_count = 0;
+		int edge_free_count = 0;
+		int edge_connection_count = 0;
+	};
+	HashMap<const NavRegion *, RegionEdgeCounts> region_edge_counts;
+
+	/// Search the connections between regions and links first on long paths.
+	bool use_hierarchical_pathfinding = false;
+
+	/// The regions and links of the map, as clusters of polygons for the hierarchical pathfinding.
+	struct PathCluster {
+		const NavBase *owner = nullptr;
+		/// Portals leading out of this cluster.
+		LocalVector<uint32_t> exit_portals;
+	};
+	/// Connections from one cluster to another, placed in the middle of their pathways.
+	struct PathPortal {
+		Vector3 position;
+		uint32_t from_cluster = 0;
+		uint32_t to_cluster = 0;
+	};
+	LocalVector<PathCluster> path_clusters;
+	LocalVector<PathPortal> path_portals;
+	/// Cluster of each polygon, indexed by polygon id.
+	LocalVector<uint32_t> polygon_cluster_ids;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -84,6 +123,10 @@ class NavMap : public NavRid {
 	LocalVector<NavAgent *> active_2d_avoidance_agents;
 	LocalVector<NavAgent *> active_3d_avoidance_agents;
 
+	/// Grids of the avoidance controlled agents for their neighbor queries, indexed like the arrays above
+	NavAvoidanceGrid avoidance_agents_grid_2d;
+	NavAvoidanceGrid avoidance_agents_grid_3d;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -96,6 +139,9 @@ class NavMap : public NavRid {
 	/// Are rvo obstacles modified?
 	bool obstacles_dirty = true;
 
+	/// Flow fields toward targets on this map
+	LocalVector<NavFlowField *> flow_fields;
+
 	/// Physics delta time
 	real_t deltatime = 0.0;
 
@@ -115,6 +161,8 @@ class NavMap : public NavRid {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	uint64_t pm_sync_time_usec = 0;
+	int pm_region_sync_count = 0;
 
 public:
 	NavMap();
@@ -143,6 +191,11 @@ public:
 		return edge_connection_margin;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
 	void set_link_connection_radius(real_t p_link_connection_radius);
 	real_t get_link_connection_radius() const {
 		return link_connection_radius;
@@ -150,6 +203,9 @@ public:
 
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
+	/// Polygons reached by the last path query made on the calling thread.
+	static uint32_t get_last_path_query_polygon_count();
+
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
@@ -168,6 +224,22 @@ public:
 	const LocalVector<NavLink *> &get_links() const {
 		return links;
 	}
+	const LocalVector<gd::Polygon> &get_link_polygons() const {
+		return link_polygons;
+	}
+
+	/// Number of region polygons, the link polygons are numbered after them.
+	uint32_t get_polygon_count() const {
+		return polygon_count;
+	}
+
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_point) const;
+
+	void add_flow_field(NavFlowField *p_flow_field);
+	void remove_flow_field(NavFlowField *p_flow_field);
+	const LocalVector<NavFlowField *> &get_flow_fields() const {
+		return flow_fields;
+	}
 
 	bool has_agent(NavAgent *agent) const;
 	void add_agent(NavAgent *agent);
@@ -203,18 +275,30 @@ public:
 	int get_pm_edge_merge_count() const { return pm_edge_merge_count; }
 	int get_pm_edge_connection_count() const { return pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return pm_edge_free_count; }
+	uint64_t get_pm_sync_time_usec() const { return pm_sync_time_usec; }
+	int get_pm_region_sync_count() const { return pm_region_sync_count; }
 
 private:
 	void compute_single_step(uint32_t index, NavAgent **agent);
+	void _update_flow_field(uint32_t p_index, NavFlowField **p_flow_fields);
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
+	real_t _get_region_neighbor_margin() const;
+	void _remove_link_entry_connections();
+	void _update_region_connections(const LocalVector<NavRegion *> &p_regions);
+	void _build_path_clusters();
+	bool _get_path_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const;
+	const gd::Polygon *_get_closest_polygon_point(const Vector3 &p_point, bool p_filter_layers, uint32_t p_navigation_layers, Vector3 &r_point, Vector3 *r_normal) const;
+
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
+	void _compute_rvo_agent_neighbors_2d(RVO2D::Agent2D *p_agent);
+	void _compute_rvo_agent_neighbors_3d(RVO3D::Agent3D *p_agent);
 };
 
 #endif // NAV_MAP_H
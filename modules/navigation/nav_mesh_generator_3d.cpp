@@ -70,6 +70,9 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+HashMap<ObjectID, uint32_t> NavMeshGenerator3D::baked_tile_hashes;
+Mutex NavMeshGenerator3D::mesh_faces_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshGeneratorMeshFaces3D> NavMeshGenerator3D::mesh_faces_cache;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -130,6 +133,7 @@ void NavMeshGenerator3D::cleanup() {
 	generator_task_mutex.lock();
 
 	baking_navmeshes.clear();
+	baked_tile_hashes.clear();
 
 	for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorTask3D *> &E : generator_tasks) {
 		WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
@@ -140,6 +144,10 @@ void NavMeshGenerator3D::cleanup() {
 
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
+
+	mesh_faces_cache_mutex.lock();
+	mesh_faces_cache.clear();
+	mesh_faces_cache_mutex.unlock();
 }
 
 void NavMeshGenerator3D::finish() {
@@ -236,25 +244,327 @@ void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
 
-void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
-	generator_parse_meshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+int NavMeshGenerator3D::bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_tiles, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data) {
+	ERR_FAIL_COND_V(!p_source_geometry_data.is_valid(), 0);
+
+	NavMeshGeneratorTileBatch3D batch;
+	batch.vertices = p_source_geometry_data->get_vertices();
+	batch.indices = p_source_geometry_data->get_indices();
+
+	baking_navmesh_mutex.lock();
+
+	// Forget the hashes of tiles that no longer exist.
+	LocalVector<ObjectID> freed_tiles;
+	for (const KeyValue<ObjectID, uint32_t> &E : baked_tile_hashes) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed_tiles.push_back(E.key);
+		}
+	}
+	for (const ObjectID &freed_tile : freed_tiles) {
+		baked_tile_hashes.erase(freed_tile);
+	}
+
+	for (int i = 0; i < p_tiles.size(); i++) {
+		Ref<NavigationMesh> navigation_mesh = p_tiles[i];
+		ERR_CONTINUE_MSG(navigation_mesh.is_null(), "Invalid navigation mesh tile.");
+		ERR_CONTINUE_MSG(!navigation_mesh->get_filter_baking_aabb().has_volume(), "NavigationMesh tiles require a filter_baking_aabb with a volume.");
+		ERR_CONTINUE_MSG(baking_navmeshes.has(navigation_mesh), "NavigationMesh is already baking. Wait for current bake to finish.");
+		baking_navmeshes.insert(navigation_mesh);
+
+		AABB bounds = navigation_mesh->get_filter_baking_aabb();
+		bounds.position += navigation_mesh->get_filter_baking_aabb_offset();
+		// The border is rasterized too, so include the geometry up to a cell past it.
+		const real_t border = navigation_mesh->get_border_size() + navigation_mesh->get_cell_size();
+
+		NavMeshGeneratorTile3D tile;
+		tile.navigation_mesh = navigation_mesh;
+		tile.bounds_begin = bounds.position - Vector3(border, 0.0, border);
+		tile.bounds_end = bounds.get_end() + Vector3(border, 0.0, border);
+		tile.settings_hash = generator_get_bake_settings_hash(navigation_mesh);
+
+		HashMap<ObjectID, uint32_t>::ConstIterator E = baked_tile_hashes.find(navigation_mesh->get_instance_id());
+		if (E) {
+			tile.previous_source_hash = E->value;
+			tile.has_previous_source_hash = true;
+		}
+
+		batch.tiles.push_back(tile);
+	}
+
+	baking_navmesh_mutex.unlock();
+
+	generator_bucket_tile_triangles(batch);
+
+	if (use_threads && batch.tiles.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_bake_tile, &batch, batch.tiles.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch.tiles.size(); i++) {
+			generator_bake_tile(&batch, i);
+		}
+	}
+
+	int baked_tile_count = 0;
+
+	baking_navmesh_mutex.lock();
+	for (const NavMeshGeneratorTile3D &tile : batch.tiles) {
+		baking_navmeshes.erase(tile.navigation_mesh);
+		// Tiles that failed to bake keep the hash of what they were last baked from, so they're baked again next time.
+		if (tile.baked) {
+			baked_tile_hashes[tile.navigation_mesh->get_instance_id()] = tile.source_hash;
+			baked_tile_count++;
+		}
+	}
+	baking_navmesh_mutex.unlock();
+
+	return baked_tile_count;
+}
+
+uint32_t NavMeshGenerator3D::generator_get_bake_settings_hash(const Ref<NavigationMesh> &p_navigation_mesh) {
+	uint32_t hash = HASH_MURMUR3_SEED;
+
+	List<PropertyInfo> property_list;
+	p_navigation_mesh->get_property_list(&property_list);
+	for (const PropertyInfo &E : property_list) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == "vertices" || E.name == "polygons") {
+			continue;
+		}
+		hash = hash_murmur3_one_32(p_navigation_mesh->get(E.name).hash(), hash);
+	}
+
+	return hash;
+}
+
+// Sorts the source triangles into the tiles they affect in a single pass over them.
+// The tiles are registered in a coarse grid first, so each triangle is only tested against the tiles around it.
+void NavMeshGenerator3D::generator_bucket_tile_triangles(NavMeshGeneratorTileBatch3D &r_batch) {
+	if (r_batch.tiles.is_empty()) {
+		return;
+	}
+
+	Vector2 grid_begin(r_batch.tiles[0].bounds_begin.x, r_batch.tiles[0].bounds_begin.z);
+	Vector2 grid_end(r_batch.tiles[0].bounds_end.x, r_batch.tiles[0].bounds_end.z);
+	Vector2 cell_size;
+	for (const NavMeshGeneratorTile3D &tile : r_batch.tiles) {
+		grid_begin = grid_begin.min(Vector2(tile.bounds_begin.x, tile.bounds_begin.z));
+		grid_end = grid_end.max(Vector2(tile.bounds_end.x, tile.bounds_end.z));
+		cell_size = cell_size.max(Vector2(tile.bounds_end.x - tile.bounds_begin.x, tile.bounds_end.z - tile.bounds_begin.z));
+	}
+	cell_size = cell_size.max(Vector2(CMP_EPSILON, CMP_EPSILON));
+
+	// Cells at least as large as the tiles, so each tile is in at most four of them. Tiles far apart get coarser cells.
+	Vector2i grid_size;
+	while (true) {
+		grid_size = Vector2i(MAX(1, (int)Math::ceil((grid_end.x - grid_begin.x) / cell_size.x)), MAX(1, (int)Math::ceil((grid_end.y - grid_begin.y) / cell_size.y)));
+		if ((int64_t)grid_size.x * grid_size.y <= (int64_t)r_batch.tiles.size() * 4) {
+			break;
+		}
+		cell_size *= 2.0;
+	}
+
+	LocalVector<LocalVector<uint32_t>> cells;
+	cells.resize(grid_size.x * grid_size.y);
+
+	const Vector2 cell_scale = Vector2(1.0, 1.0) / cell_size;
+	const Vector2i grid_max = grid_size - Vector2i(1, 1);
+	for (uint32_t tile_index = 0; tile_index < r_batch.tiles.size(); tile_index++) {
+		const NavMeshGeneratorTile3D &tile = r_batch.tiles[tile_index];
+		const Vector2i cell_begin = Vector2i(((Vector2(tile.bounds_begin.x, tile.bounds_begin.z) - grid_begin) * cell_scale).floor()).clamp(Vector2i(), grid_max);
+		const Vector2i cell_end = Vector2i(((Vector2(tile.bounds_end.x, tile.bounds_end.z) - grid_begin) * cell_scale).floor()).clamp(Vector2i(), grid_max);
+		for (int y = cell_begin.y; y <= cell_end.y; y++) {
+			for (int x = cell_begin.x; x <= cell_end.x; x++) {
+				cells[y * grid_size.x + x].push_back(tile_index);
+			}
+		}
+	}
+
+	const float *vertices = r_batch.vertices.ptr();
+	const int *indices = r_batch.indices.ptr();
+	const int index_count = r_batch.indices.size() - r_batch.indices.size() % 3;
+
+	// Last triangle added to each tile, for triangles found again through another cell of the same tile.
+	LocalVector<int> last_triangles;
+	last_triangles.resize(r_batch.tiles.size());
+	for (int &last_triangle : last_triangles) {
+		last_triangle = -1;
+	}
+
+	for (int i = 0; i < index_count; i += 3) {
+		const float *a = &vertices[indices[i + 0] * 3];
+		const float *b = &vertices[indices[i + 1] * 3];
+		const float *c = &vertices[indices[i + 2] * 3];
+		const Vector3 triangle_begin(MIN(MIN(a[0], b[0]), c[0]), MIN(MIN(a[1], b[1]), c[1]), MIN(MIN(a[2], b[2]), c[2]));
+		const Vector3 triangle_end(MAX(MAX(a[0], b[0]), c[0]), MAX(MAX(a[1], b[1]), c[1]), MAX(MAX(a[2], b[2]), c[2]));
+
+		if (triangle_end.x < grid_begin.x || triangle_begin.x > grid_end.x || triangle_end.z < grid_begin.y || triangle_begin.z > grid_end.y) {
+			continue;
+		}
+
+		const Vector2i cell_begin = Vector2i(((Vector2(triangle_begin.x, triangle_begin.z) - grid_begin) * cell_scale).floor()).clamp(Vector2i(), grid_max);
+		const Vector2i cell_end = Vector2i(((Vector2(triangle_end.x, triangle_end.z) - grid_begin) * cell_scale).floor()).clamp(Vector2i(), grid_max);
+		for (int y = cell_begin.y; y <= cell_end.y; y++) {
+			for (int x = cell_begin.x; x <= cell_end.x; x++) {
+				for (uint32_t tile_index : cells[y * grid_size.x + x]) {
+					if (last_triangles[tile_index] == i) {
+						continue;
+					}
+					NavMeshGeneratorTile3D &tile = r_batch.tiles[tile_index];
+					if (triangle_end.x < tile.bounds_begin.x || triangle_begin.x > tile.bounds_end.x ||
+							triangle_end.y < tile.bounds_begin.y || triangle_begin.y > tile.bounds_end.y ||
+							triangle_end.z < tile.bounds_begin.z || triangle_begin.z > tile.bounds_end.z) {
+						continue;
+					}
+					last_triangles[tile_index] = i;
+					tile.triangles.push_back(indices[i + 0]);
+					tile.triangles.push_back(indices[i + 1]);
+					tile.triangles.push_back(indices[i + 2]);
+				}
+			}
+		}
+	}
+}
+
+void NavMeshGenerator3D::generator_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTileBatch3D *batch = static_cast<NavMeshGeneratorTileBatch3D *>(p_arg);
+	NavMeshGeneratorTile3D &tile = batch->tiles[p_index];
+
+	const float *vertices = batch->vertices.ptr();
+
+	uint32_t hash = tile.settings_hash;
+	for (int index : tile.triangles) {
+		const float *vertex = &vertices[index * 3];
+		hash = hash_murmur3_one_float(vertex[0], hash);
+		hash = hash_murmur3_one_float(vertex[1], hash);
+		hash = hash_murmur3_one_float(vertex[2], hash);
+	}
+	tile.source_hash = hash_fmix32(hash);
+
+	// Nothing that affects this tile changed since it was last baked.
+	if (tile.has_previous_source_hash && tile.source_hash == tile.previous_source_hash) {
+		return;
+	}
+
+	if (tile.triangles.is_empty()) {
+		tile.navigation_mesh->clear();
+		tile.baked = true;
+	} else {
+		tile.baked = generator_bake_from_triangles(tile.navigation_mesh, vertices, batch->vertices.size() / 3, tile.triangles.ptr(), tile.triangles.size() / 3);
+	}
+}
+
+void NavMeshGenerator3D::generator_mesh_changed(ObjectID p_mesh_id) {
+	mesh_faces_cache_mutex.lock();
+	mesh_faces_cache.erase(p_mesh_id);
+	mesh_faces_cache_mutex.unlock();
+}
+
+void NavMeshGenerator3D::generator_add_mesh(const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Ref<Mesh> &p_mesh, const Transform3D &p_xform, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances) {
+	// Also brings pending primitive mesh updates in, which drops their outdated faces from the cache.
+	if (p_mesh->get_surface_count() == 0) {
+		return;
+	}
+
+	NavMeshGeneratorMeshInstance3D mesh_instance;
+	mesh_instance.transform = p_source_geometry_data->root_node_transform * p_xform;
+
+	const ObjectID mesh_id = p_mesh->get_instance_id();
+
+	mesh_faces_cache_mutex.lock();
+	HashMap<ObjectID, NavMeshGeneratorMeshFaces3D>::ConstIterator E = mesh_faces_cache.find(mesh_id);
+	if (E) {
+		mesh_instance.faces = E->value;
+	} else {
+		NavigationMeshSourceGeometryData3D::get_mesh_faces(p_mesh, mesh_instance.faces.vertices, mesh_instance.faces.indices);
+		mesh_faces_cache.insert(mesh_id, mesh_instance.faces);
+		p_mesh->connect_changed(callable_mp_static(&NavMeshGenerator3D::generator_mesh_changed).bind(mesh_id), CONNECT_ONE_SHOT);
+	}
+	mesh_faces_cache_mutex.unlock();
+
+	if (mesh_instance.faces.indices.is_empty()) {
+		return;
+	}
+
+	r_mesh_instances.push_back(mesh_instance);
+}
+
+void NavMeshGenerator3D::generator_add_parsed_meshes(Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const LocalVector<NavMeshGeneratorMeshInstance3D> &p_mesh_instances) {
+	if (p_mesh_instances.is_empty()) {
+		return;
+	}
+
+	NavMeshGeneratorParseBatch3D batch;
+	batch.mesh_instances = p_mesh_instances;
+
+	Vector<float> vertices = p_source_geometry_data->get_vertices();
+	Vector<int> indices = p_source_geometry_data->get_indices();
+
+	// Reserve the room of every mesh instance up front, so they can be transformed in parallel.
+	int vertex_count = vertices.size() / 3;
+	int index_count = indices.size();
+	for (NavMeshGeneratorMeshInstance3D &mesh_instance : batch.mesh_instances) {
+		mesh_instance.vertex_offset = vertex_count;
+		mesh_instance.index_offset = index_count;
+		vertex_count += mesh_instance.faces.vertices.size();
+		index_count += mesh_instance.faces.indices.size();
+	}
+
+	vertices.resize(vertex_count * 3);
+	indices.resize(index_count);
+	batch.vertices = vertices.ptrw();
+	batch.indices = indices.ptrw();
+
+	if (use_threads && batch.mesh_instances.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_transform_mesh_instance, &batch, batch.mesh_instances.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorParseMeshes3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch.mesh_instances.size(); i++) {
+			generator_transform_mesh_instance(&batch, i);
+		}
+	}
+
+	p_source_geometry_data->set_vertices(vertices);
+	p_source_geometry_data->set_indices(indices);
+}
+
+void NavMeshGenerator3D::generator_transform_mesh_instance(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorParseBatch3D *batch = static_cast<NavMeshGeneratorParseBatch3D *>(p_arg);
+	const NavMeshGeneratorMeshInstance3D &mesh_instance = batch->mesh_instances[p_index];
+
+	const Vector3 *vr = mesh_instance.faces.vertices.ptr();
+	float *vw = &batch->vertices[mesh_instance.vertex_offset * 3];
+	for (int i = 0; i < mesh_instance.faces.vertices.size(); i++) {
+		const Vector3 vertex = mesh_instance.transform.xform(vr[i]);
+		vw[i * 3 + 0] = vertex.x;
+		vw[i * 3 + 1] = vertex.y;
+		vw[i * 3 + 2] = vertex.z;
+	}
+
+	const int *ir = mesh_instance.faces.indices.ptr();
+	int *iw = &batch->indices[mesh_instance.index_offset];
+	for (int i = 0; i < mesh_instance.faces.indices.size(); i++) {
+		iw[i] = mesh_instance.vertex_offset + ir[i];
+	}
+}
+
+void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances) {
+	generator_parse_meshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node, r_mesh_instances);
+	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node, r_mesh_instances);
 	generator_parse_staticbody3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
 #ifdef MODULE_CSG_ENABLED
-	generator_parse_csgshape3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_csgshape3d_node(p_navigation_mesh, p_source_geometry_data, p_node, r_mesh_instances);
 #endif
 #ifdef MODULE_GRIDMAP_ENABLED
-	generator_parse_gridmap_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_gridmap_node(p_navigation_mesh, p_source_geometry_data, p_node, r_mesh_instances);
 #endif
 
 	if (p_recurse_children) {
 		for (int i = 0; i < p_node->get_child_count(); i++) {
-			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children);
+			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children, r_mesh_instances);
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances) {
 	MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(p_node);
 
 	if (mesh_instance) {
@@ -263,13 +573,13 @@ void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<Navigatio
 		if (parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_BOTH) {
 			Ref<Mesh> mesh = mesh_instance->get_mesh();
 			if (mesh.is_valid()) {
-				p_source_geometry_data->add_mesh(mesh, mesh_instance->get_global_transform());
+				generator_add_mesh(p_source_geometry_data, mesh, mesh_instance->get_global_transform(), r_mesh_instances);
 			}
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances) {
 	MultiMeshInstance3D *multimesh_instance = Object::cast_to<MultiMeshInstance3D>(p_node);
 
 	if (multimesh_instance) {
@@ -285,7 +595,7 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 						n = multimesh->get_instance_count();
 					}
 					for (int i = 0; i < n; i++) {
-						p_source_geometry_data->add_mesh(mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i));
+						generator_add_mesh(p_source_geometry_data, mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i), r_mesh_instances);
 					}
 				}
 			}
@@ -415,7 +725,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 }
 
 #ifdef MODULE_CSG_ENABLED
-void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances) {
 	CSGShape3D *csgshape3d = Object::cast_to<CSGShape3D>(p_node);
 
 	if (csgshape3d) {
@@ -428,7 +738,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 			if (!meshes.is_empty()) {
 				Ref<Mesh> mesh = meshes[1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, csg_shape->get_global_transform());
+					generator_add_mesh(p_source_geometry_data, mesh, csg_shape->get_global_transform(), r_mesh_instances);
 				}
 			}
 		}
@@ -437,7 +747,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 #endif // MODULE_CSG_ENABLED
 
 #ifdef MODULE_GRIDMAP_ENABLED
-void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances) {
 	GridMap *gridmap = Object::cast_to<GridMap>(p_node);
 
 	if (gridmap) {
@@ -450,7 +760,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 			for (int i = 0; i < meshes.size(); i += 2) {
 				Ref<Mesh> mesh = meshes[i + 1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, xform * (Transform3D)meshes[i]);
+					generator_add_mesh(p_source_geometry_data, mesh, xform * (Transform3D)meshes[i], r_mesh_instances);
 				}
 			}
 		}
@@ -583,9 +893,26 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
+	// Forget the faces of meshes that no longer exist.
+	mesh_faces_cache_mutex.lock();
+	LocalVector<ObjectID> freed_meshes;
+	for (const KeyValue<ObjectID, NavMeshGeneratorMeshFaces3D> &E : mesh_faces_cache) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed_meshes.push_back(E.key);
+		}
+	}
+	for (const ObjectID &freed_mesh : freed_meshes) {
+		mesh_faces_cache.erase(freed_mesh);
+	}
+	mesh_faces_cache_mutex.unlock();
+
+	// Mesh instances found while parsing, added to the source geometry all at once.
+	LocalVector<NavMeshGeneratorMeshInstance3D> mesh_instances;
 	for (Node *parse_node : parse_nodes) {
-		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
+		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children, mesh_instances);
 	}
+
+	generator_add_parsed_meshes(p_source_geometry_data, mesh_instances);
 };
 
 void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
@@ -600,6 +927,10 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	generator_bake_from_triangles(p_navigation_mesh, vertices.ptr(), vertices.size() / 3, indices.ptr(), indices.size() / 3);
+}
+
+bool NavMeshGenerator3D::generator_bake_from_triangles(Ref<NavigationMesh> p_navigation_mesh, const float *p_vertices, int p_vertex_count, const int *p_triangles, int p_triangle_count) {
 	rcHeightfield *hf = nullptr;
 	rcCompactHeightfield *chf = nullptr;
 	rcContourSet *cset = nullptr;
@@ -612,10 +943,10 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Setting up Configuration..."; // step #1
 
-	const float *verts = vertices.ptr();
-	const int nverts = vertices.size() / 3;
-	const int *tris = indices.ptr();
-	const int ntris = indices.size() / 3;
+	const float *verts = p_vertices;
+	const int nverts = p_vertex_count;
+	const int *tris = p_triangles;
+	const int ntris = p_triangle_count;
 
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
@@ -636,6 +967,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
 	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
 	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+	cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
 
 	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
@@ -680,6 +1012,14 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	// The geometry in the border is rasterized too, but no polygons are built on it.
+	if (cfg.borderSize > 0) {
+		cfg.bmin[0] -= cfg.borderSize * cfg.cs;
+		cfg.bmin[2] -= cfg.borderSize * cfg.cs;
+		cfg.bmax[0] += cfg.borderSize * cfg.cs;
+		cfg.bmax[2] += cfg.borderSize * cfg.cs;
+	}
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
@@ -694,20 +1034,20 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
 		tri_areas.resize(ntris);
 
-		ERR_FAIL_COND(tri_areas.size() == 0);
+		ERR_FAIL_COND_V(tri_areas.size() == 0, false);
 
 		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
 		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
@@ -724,43 +1064,43 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf), false);
 
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -803,6 +1143,8 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	detail_mesh = nullptr;
 
 	bake_state = "Baking finished."; // step #12
+
+	return true;
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
@@ -35,8 +35,10 @@
 
 #include "core/object/class_db.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/variant/typed_array.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
 
+class Mesh;
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
@@ -73,18 +75,73 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
-	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
+	struct NavMeshGeneratorTile3D {
+		Ref<NavigationMesh> navigation_mesh;
+		// Bounds of the geometry that affects the tile, its border included.
+		Vector3 bounds_begin;
+		Vector3 bounds_end;
+		// Vertex indices of the source triangles within the bounds, in source order.
+		LocalVector<int> triangles;
+		uint32_t settings_hash = 0;
+		uint32_t source_hash = 0;
+		uint32_t previous_source_hash = 0;
+		bool has_previous_source_hash = false;
+		bool baked = false;
+	};
+
+	struct NavMeshGeneratorTileBatch3D {
+		Vector<float> vertices;
+		Vector<int> indices;
+		LocalVector<NavMeshGeneratorTile3D> tiles;
+	};
+
+	// Hash of the settings and source geometry each tile was last baked from.
+	static HashMap<ObjectID, uint32_t> baked_tile_hashes;
+
+	static uint32_t generator_get_bake_settings_hash(const Ref<NavigationMesh> &p_navigation_mesh);
+	static void generator_bucket_tile_triangles(NavMeshGeneratorTileBatch3D &r_batch);
+	static void generator_bake_tile(void *p_arg, uint32_t p_index);
+
+	struct NavMeshGeneratorMeshFaces3D {
+		Vector<Vector3> vertices;
+		Vector<int> indices;
+	};
+
+	struct NavMeshGeneratorMeshInstance3D {
+		NavMeshGeneratorMeshFaces3D faces;
+		Transform3D transform;
+		int vertex_offset = 0;
+		int index_offset = 0;
+	};
+
+	struct NavMeshGeneratorParseBatch3D {
+		LocalVector<NavMeshGeneratorMeshInstance3D> mesh_instances;
+		float *vertices = nullptr;
+		int *indices = nullptr;
+	};
+
+	// Faces of the parsed meshes, so parsing them again only needs to transform them.
+	static Mutex mesh_faces_cache_mutex;
+	static HashMap<ObjectID, NavMeshGeneratorMeshFaces3D> mesh_faces_cache;
+
+	static void generator_mesh_changed(ObjectID p_mesh_id);
+	static void generator_add_mesh(const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Ref<Mesh> &p_mesh, const Transform3D &p_xform, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances);
+	static void generator_add_parsed_meshes(Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const LocalVector<NavMeshGeneratorMeshInstance3D> &p_mesh_instances);
+	static void generator_transform_mesh_instance(void *p_arg, uint32_t p_index);
+
+	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static bool generator_bake_from_triangles(Ref<NavigationMesh> p_navigation_mesh, const float *p_vertices, int p_vertex_count, const int *p_triangles, int p_triangle_count);
 
-	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances);
+	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances);
 	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 #ifdef MODULE_CSG_ENABLED
-	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances);
 #endif // MODULE_CSG_ENABLED
 #ifdef MODULE_GRIDMAP_ENABLED
-	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, LocalVector<NavMeshGeneratorMeshInstance3D> &r_mesh_instances);
 #endif // MODULE_GRIDMAP_ENABLED
 
 	static bool generator_emit_callback(const Callable &p_callback);
@@ -99,6 +156,7 @@ public:
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
+	static int bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_tiles, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data);
 
 	NavMeshGenerator3D();
 	~NavMeshGenerator3D();
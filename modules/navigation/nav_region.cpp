@@ -32,6 +32,10 @@
 
 #include "nav_map.h"
 
+#include "core/templates/sort_array.h"
+
+#define POLYGON_BVH_LEAF_SIZE 4
+
 void NavRegion::set_map(NavMap *p_map) {
 	if (map == p_map) {
 		return;
@@ -115,6 +119,14 @@ void NavRegion::update_polygons() {
 	polygons.clear();
 	polygons_dirty = false;
 
+	free_edges.clear();
+	free_edge_keys.clear();
+	polygon_bvh.clear();
+	polygon_bvh_indices.clear();
+	polygon_id_offset = UINT32_MAX;
+	edge_count = 0;
+	edge_merge_count = 0;
+
 	if (map == nullptr) {
 		return;
 	}
@@ -191,4 +203,133 @@ void NavRegion::update_polygons() {
 			p.center = center / real_t(mesh_poly.size());
 		}
 	}
+
+	_update_free_edges();
+	_build_polygon_bvh();
+}
+
+void NavRegion::set_polygon_id_offset(uint32_t p_offset) {
+	if (polygon_id_offset == p_offset) {
+		return;
+	}
+	polygon_id_offset = p_offset;
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		polygons[i].id = p_offset + i;
+	}
+}
+
+void NavRegion::_update_free_edges() {
+	// Group all edges per key.
+	HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
+	for (gd::Polygon &poly : polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
+			if (!connection) {
+				connection = connections.insert(ek, Vector<gd::Edge::Connection>());
+				edge_count += 1;
+			}
+			if (connection->value.size() <= 1) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+				connection->value.push_back(new_connection);
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
+			}
+		}
+	}
+
+	for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			gd::Edge::Connection &c1 = E.value.write[0];
+			gd::Edge::Connection &c2 = E.value.write[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			edge_merge_count += 1;
+		} else {
+			CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+			// The map connects it to other regions.
+			gd::FreeEdge free_edge;
+			free_edge.connection = E.value[0];
+			free_edge.key = E.key;
+			free_edge_keys.insert(E.key, free_edges.size());
+			free_edges.push_back(free_edge);
+		}
+	}
+}
+
+struct PolygonBVHCenterCompare {
+	const AABB *aabbs = nullptr;
+	int axis = 0;
+
+	bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return aabbs[p_a].get_center()[axis] < aabbs[p_b].get_center()[axis];
+	}
+};
+
+uint32_t NavRegion::_build_polygon_bvh_node(const LocalVector<AABB> &p_polygon_aabbs, uint32_t p_first, uint32_t p_count) {
+	const uint32_t node_index = polygon_bvh.size();
+	polygon_bvh.push_back(gd::PolygonBVHNode());
+
+	AABB aabb = p_polygon_aabbs[polygon_bvh_indices[p_first]];
+	AABB center_aabb(aabb.get_center(), Vector3());
+	for (uint32_t i = p_first + 1; i < p_first + p_count; i++) {
+		const AABB &polygon_aabb = p_polygon_aabbs[polygon_bvh_indices[i]];
+		aabb.merge_with(polygon_aabb);
+		center_aabb.expand_to(polygon_aabb.get_center());
+	}
+	polygon_bvh[node_index].aabb = aabb;
+
+	if (p_count <= POLYGON_BVH_LEAF_SIZE) {
+		polygon_bvh[node_index].first = p_first;
+		polygon_bvh[node_index].count = p_count;
+		return node_index;
+	}
+
+	// Split in two halves along the axis where the polygons are the most spread out.
+	SortArray<uint32_t, PolygonBVHCenterCompare> sorter;
+	sorter.compare.aabbs = p_polygon_aabbs.ptr();
+	sorter.compare.axis = center_aabb.get_longest_axis_index();
+	const uint32_t half = p_count / 2;
+	sorter.nth_element(p_first, p_first + p_count, p_first + half, polygon_bvh_indices.ptr());
+
+	_build_polygon_bvh_node(p_polygon_aabbs, p_first, half);
+	const uint32_t second_child = _build_polygon_bvh_node(p_polygon_aabbs, p_first + half, p_count - half);
+	polygon_bvh[node_index].second_child = second_child;
+	return node_index;
+}
+
+void NavRegion::_build_polygon_bvh() {
+	polygon_bvh_indices.resize(polygons.size());
+	if (polygons.is_empty()) {
+		return;
+	}
+
+	LocalVector<AABB> polygon_aabbs;
+	polygon_aabbs.resize(polygons.size());
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		const gd::Polygon &p = polygons[i];
+		AABB aabb;
+		if (!p.points.is_empty()) {
+			aabb.position = p.points[0].pos;
+			for (uint32_t j = 1; j < p.points.size(); j++) {
+				aabb.expand_to(p.points[j].pos);
+			}
+		}
+		// Keeps rounding in the face queries from landing just outside of the box.
+		polygon_aabbs[i] = aabb.grow(0.001);
+		polygon_bvh_indices[i] = i;
+	}
+
+	polygon_bvh.reserve(2 * polygons.size() / POLYGON_BVH_LEAF_SIZE + 1);
+	_build_polygon_bvh_node(polygon_aabbs, 0, polygons.size());
 }
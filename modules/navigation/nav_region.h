@@ -50,6 +50,20 @@ class NavRegion : public NavBase {
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
 
+	/// Edges not shared by two polygons of this region, and their index by key.
+	LocalVector<gd::FreeEdge> free_edges;
+	HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> free_edge_keys;
+
+	/// Bounding volume hierarchy over the polygons.
+	LocalVector<gd::PolygonBVHNode> polygon_bvh;
+	LocalVector<uint32_t> polygon_bvh_indices;
+
+	/// Id of the first polygon on the map.
+	uint32_t polygon_id_offset = UINT32_MAX;
+
+	int edge_count = 0;
+	int edge_merge_count = 0;
+
 public:
 	NavRegion() {
 		type = NavigationUtilities::PathSegmentType::PATH_SEGMENT_TYPE_REGION;
@@ -58,6 +72,9 @@ public:
 	void scratch_polygons() {
 		polygons_dirty = true;
 	}
+	bool is_dirty() const {
+		return polygons_dirty;
+	}
 
 	void set_enabled(bool p_enabled);
 	bool get_enabled() const { return enabled; }
@@ -93,10 +110,38 @@ public:
 		return polygons;
 	}
 
+	LocalVector<gd::FreeEdge> &get_free_edges() {
+		return free_edges;
+	}
+	const LocalVector<gd::FreeEdge> &get_free_edges() const {
+		return free_edges;
+	}
+	const HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> &get_free_edge_keys() const {
+		return free_edge_keys;
+	}
+
+	const LocalVector<gd::PolygonBVHNode> &get_polygon_bvh() const {
+		return polygon_bvh;
+	}
+	const LocalVector<uint32_t> &get_polygon_bvh_indices() const {
+		return polygon_bvh_indices;
+	}
+	AABB get_bounds() const {
+		return polygon_bvh.is_empty() ? AABB() : polygon_bvh[0].aabb;
+	}
+
+	void set_polygon_id_offset(uint32_t p_offset);
+
+	int get_edge_count() const { return edge_count; }
+	int get_edge_merge_count() const { return edge_merge_count; }
+
 	bool sync();
 
 private:
 	void update_polygons();
+	void _update_free_edges();
+	void _build_polygon_bvh();
+	uint32_t _build_polygon_bvh_node(const LocalVector<AABB> &p_polygon_aabbs, uint32_t p_first, uint32_t p_count);
 };
 
 #endif // NAV_REGION_H
@@ -31,6 +31,7 @@
 #ifndef NAV_UTILS_H
 #define NAV_UTILS_H
 
+#include "core/math/aabb.h"
 #include "core/math/vector3.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
@@ -112,6 +113,29 @@ struct Polygon {
 
 	/// The center of this `Polygon`
 	Vector3 center;
+
+	/// Index of this `Polygon` in the map, region polygons come first and link polygons after them.
+	uint32_t id = 0;
+};
+
+/// An edge of a region polygon that no other polygon of the same region shares.
+/// The map connects these to the polygons of other regions.
+struct FreeEdge {
+	/// Connection leading to the polygon of this edge, as other regions see it.
+	Edge::Connection connection;
+	EdgeKey key;
+	/// Whether a polygon of another region shares this edge.
+	bool merged = false;
+};
+
+/// Node of a bounding volume hierarchy over the polygons of a region.
+struct PolygonBVHNode {
+	AABB aabb;
+	/// Range of leaf polygons in the hierarchy's polygon indices, internal nodes have a count of 0.
+	uint32_t first = 0;
+	uint32_t count = 0;
+	/// The first child of an internal node directly follows it.
+	uint32_t second_child = 0;
 };
 
 struct NavigationPoly {
@@ -127,8 +151,13 @@ struct NavigationPoly {
 
 	/// The entry position of this poly.
 	Vector3 entry;
-	/// The distance to the destination.
+	/// The distance traveled to reach the entry position.
 	real_t traveled_distance = 0.0;
+	/// The estimated cost from the entry position to the destination.
+	real_t distance_to_destination = 0.0;
+
+	/// Position in the open list, or `UINT32_MAX` when not in it.
+	uint32_t heap_index = UINT32_MAX;
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -142,6 +171,113 @@ struct NavigationPoly {
 	bool operator!=(const NavigationPoly &other) const {
 		return !operator==(other);
 	}
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+/// Binary min-heap of `NavigationPoly` ids ordered by total travel cost, used as the A* open list.
+/// Polys with the same cost come out in the order they were reached.
+class NavigationPolyHeap {
+	LocalVector<NavigationPoly> &navigation_polys;
+	LocalVector<uint32_t> &heap;
+
+	_FORCE_INLINE_ bool _less(uint32_t p_a, uint32_t p_b) const {
+		const real_t cost_a = navigation_polys[p_a].total_travel_cost();
+		const real_t cost_b = navigation_polys[p_b].total_travel_cost();
+		return cost_a < cost_b || (cost_a == cost_b && p_a < p_b);
+	}
+
+	_FORCE_INLINE_ void _set(uint32_t p_index, uint32_t p_id) {
+		heap[p_index] = p_id;
+		navigation_polys[p_id].heap_index = p_index;
+	}
+
+	void _shift_up(uint32_t p_index) {
+		const uint32_t id = heap[p_index];
+		while (p_index > 0) {
+			const uint32_t parent = (p_index - 1) / 2;
+			if (!_less(id, heap[parent])) {
+				break;
+			}
+			_set(p_index, heap[parent]);
+			p_index = parent;
+		}
+		_set(p_index, id);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		const uint32_t id = heap[p_index];
+		const uint32_t size = heap.size();
+		while (true) {
+			uint32_t child = p_index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && _less(heap[child + 1], heap[child])) {
+				child++;
+			}
+			if (!_less(heap[child], id)) {
+				break;
+			}
+			_set(p_index, heap[child]);
+			p_index = child;
+		}
+		_set(p_index, id);
+	}
+
+public:
+	void push(uint32_t p_id) {
+		heap.push_back(p_id);
+		_shift_up(heap.size() - 1);
+	}
+
+	uint32_t pop() {
+		const uint32_t id = heap[0];
+		navigation_polys[id].heap_index = UINT32_MAX;
+		const uint32_t last = heap[heap.size() - 1];
+		heap.resize(heap.size() - 1);
+		if (!heap.is_empty()) {
+			_set(0, last);
+			_shift_down(0);
+		}
+		return id;
+	}
+
+	/// Moves a poly that is in the heap to its new place after its cost changed.
+	void update(uint32_t p_id) {
+		const uint32_t index = navigation_polys[p_id].heap_index;
+		_shift_up(index);
+		_shift_down(navigation_polys[p_id].heap_index);
+	}
+
+	void clear() {
+		for (uint32_t id : heap) {
+			navigation_polys[id].heap_index = UINT32_MAX;
+		}
+		heap.clear();
+	}
+
+	uint32_t size() const { return heap.size(); }
+	bool is_empty() const { return heap.is_empty(); }
+
+	NavigationPolyHeap(LocalVector<NavigationPoly> &p_navigation_polys, LocalVector<uint32_t> &p_heap) :
+			navigation_polys(p_navigation_polys),
+			heap(p_heap) {
+		heap.clear();
+	}
+};
+
+/// Buffers used by a path search, kept to be reused by the next search on the same thread.
+struct PathQueryScratch {
+	/// All the reachable navigation polys.
+	LocalVector<NavigationPoly> navigation_polys;
+	/// Index of each map polygon in `navigation_polys`, `UINT32_MAX` when not reached.
+	/// Searches put back `UINT32_MAX` in the entries they used when they are done.
+	LocalVector<uint32_t> navigation_poly_ids;
+	/// Storage for the open list.
+	LocalVector<uint32_t> heap;
 };
 
 struct ClosestPointQueryResult {
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_nav_avoidance_grid.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_AVOIDANCE_GRID_H
+#define TEST_NAV_AVOIDANCE_GRID_H
+
+#include "../nav_avoidance_grid.h"
+
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavAvoidanceGrid {
+
+// Checks that the grid finds the same agents in range as a brute force search, and visits none twice.
+bool grid_matches_brute_force(const NavAvoidanceGrid &p_grid, const LocalVector<Vector2> &p_agents, const Vector2 &p_position, float p_range) {
+	const float range_sq = p_range * p_range;
+
+	LocalVector<uint32_t> visits;
+	visits.resize(p_agents.size());
+	for (uint32_t &visit : visits) {
+		visit = 0;
+	}
+
+	float query_range_sq = range_sq;
+	p_grid.query(p_position, query_range_sq, [&](uint32_t p_index) {
+		visits[p_index]++;
+	});
+
+	for (uint32_t i = 0; i < p_agents.size(); i++) {
+		if (visits[i] > 1) {
+			return false;
+		}
+		const bool in_range = p_position.distance_squared_to(p_agents[i]) < range_sq;
+		if (in_range && visits[i] == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[NavAvoidanceGrid] Query matches brute force on random agents") {
+	RandomPCG rng(42);
+	NavAvoidanceGrid grid;
+
+	for (int set = 0; set < 20; set++) {
+		LocalVector<Vector2> agents;
+		const int agent_count = rng.random(1, 300);
+		const float extent = rng.random(1.0f, 100.0f);
+		for (int i = 0; i < agent_count; i++) {
+			agents.push_back(Vector2(rng.random(-extent, extent), rng.random(-extent, extent)));
+		}
+		grid.build(agents, false);
+
+		bool matches = true;
+		for (int i = 0; i < 200; i++) {
+			// Also queries from outside the bounds of the agents.
+			const Vector2 position(rng.random(-2.0f * extent, 2.0f * extent), rng.random(-2.0f * extent, 2.0f * extent));
+			matches = matches && grid_matches_brute_force(grid, agents, position, rng.random(0.0f, extent));
+		}
+		CHECK_MESSAGE(matches, vformat("Query of agent set %d should find the same agents as a brute force search.", set));
+	}
+}
+
+TEST_CASE("[NavAvoidanceGrid] Query matches brute force on a single row of agents") {
+	RandomPCG rng(7);
+	NavAvoidanceGrid grid;
+
+	LocalVector<Vector2> agents;
+	for (int i = 0; i < 100; i++) {
+		agents.push_back(Vector2(rng.random(0.0f, 50.0f), 3.0f));
+	}
+	grid.build(agents, false);
+
+	SUBCASE("Query positions off the row") {
+		bool matches = true;
+		for (int i = 0; i < 500; i++) {
+			const Vector2 position(rng.random(-10.0f, 60.0f), rng.random(-20.0f, 26.0f));
+			matches = matches && grid_matches_brute_force(grid, agents, position, rng.random(0.0f, 30.0f));
+		}
+		CHECK_MESSAGE(matches, "Query from above and below the row should find the same agents as a brute force search.");
+	}
+
+	SUBCASE("Query positions outside the grid") {
+		// These are clamped into the border cells of the grid, away from the cells they are nearest to in range.
+		bool matches = true;
+		for (int i = 0; i < 500; i++) {
+			const float side = rng.random(0, 1) ? 1.0f : -1.0f;
+			const Vector2 position = rng.random(0, 1) ? Vector2(25.0f + side * rng.random(25.0f, 100.0f), rng.random(-100.0f, 100.0f)) : Vector2(rng.random(-100.0f, 150.0f), 3.0f + side * rng.random(1.0f, 100.0f));
+			matches = matches && grid_matches_brute_force(grid, agents, position, rng.random(0.0f, 150.0f));
+		}
+		CHECK_MESSAGE(matches, "Query from outside the grid should find the same agents as a brute force search.");
+	}
+
+	SUBCASE("All agents at the same position") {
+		LocalVector<Vector2> same_agents;
+		for (int i = 0; i < 10; i++) {
+			same_agents.push_back(Vector2(5.0f, 3.0f));
+		}
+		grid.build(same_agents, false);
+
+		bool matches = true;
+		for (int i = 0; i < 100; i++) {
+			const Vector2 position(rng.random(-5.0f, 15.0f), rng.random(-7.0f, 13.0f));
+			matches = matches && grid_matches_brute_force(grid, same_agents, position, rng.random(0.0f, 10.0f));
+		}
+		CHECK_MESSAGE(matches, "Query should find coincident agents as a brute force search does.");
+	}
+}
+
+} // namespace TestNavAvoidanceGrid
+
+#endif // TEST_NAV_AVOIDANCE_GRID_H
@@ -96,6 +96,9 @@ void NavigationAgent3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_navigation_map", "navigation_map"), &NavigationAgent3D::set_navigation_map);
 	ClassDB::bind_method(D_METHOD("get_navigation_map"), &NavigationAgent3D::get_navigation_map);
 
+	ClassDB::bind_method(D_METHOD("set_flow_field", "flow_field"), &NavigationAgent3D::set_flow_field);
+	ClassDB::bind_method(D_METHOD("get_flow_field"), &NavigationAgent3D::get_flow_field);
+
 	ClassDB::bind_method(D_METHOD("set_target_position", "position"), &NavigationAgent3D::set_target_position);
 	ClassDB::bind_method(D_METHOD("get_target_position"), &NavigationAgent3D::get_target_position);
 
@@ -493,6 +496,20 @@ RID NavigationAgent3D::get_navigation_map() const {
 	return RID();
 }
 
+void NavigationAgent3D::set_flow_field(RID p_flow_field) {
+	if (flow_field == p_flow_field) {
+		return;
+	}
+
+	flow_field = p_flow_field;
+
+	_request_repath();
+}
+
+RID NavigationAgent3D::get_flow_field() const {
+	return flow_field;
+}
+
 void NavigationAgent3D::set_path_desired_distance(real_t p_path_desired_distance) {
 	if (Math::is_equal_approx(path_desired_distance, p_path_desired_distance)) {
 		return;
@@ -624,6 +641,12 @@ Vector3 NavigationAgent3D::get_target_position() const {
 Vector3 NavigationAgent3D::get_next_path_position() {
 	update_navigation();
 
+	if (flow_field.is_valid()) {
+		ERR_FAIL_NULL_V_MSG(agent_parent, Vector3(), "The agent has no parent.");
+		const Vector3 origin = agent_parent->get_global_position();
+		return origin + NavigationServer3D::get_singleton()->flow_field_get_direction(flow_field, origin) * path_desired_distance;
+	}
+
 	const Vector<Vector3> &navigation_path = navigation_result->get_path();
 	if (navigation_path.size() == 0) {
 		ERR_FAIL_NULL_V_MSG(agent_parent, Vector3(), "The agent has no parent.");
@@ -708,6 +731,14 @@ void NavigationAgent3D::update_navigation() {
 
 	Vector3 origin = agent_parent->get_global_position();
 
+	if (flow_field.is_valid()) {
+		// The flow field already holds the way to the target, there is no path to follow.
+		if (navigation_finished == false && origin.distance_to(target_position) < target_desired_distance) {
+			_transition_to_navigation_finished();
+		}
+		return;
+	}
+
 	bool reload_path = false;
 
 	if (NavigationServer3D::get_singleton()->agent_is_map_changed(agent)) {
@@ -823,23 +854,27 @@ void NavigationAgent3D::update_navigation() {
 
 			// Check to see if we've finished our route
 			if (navigation_path_index == navigation_path.size()) {
-				_check_distance_to_target();
 				navigation_path_index -= 1;
-				navigation_finished = true;
-				target_position_submitted = false;
-				if (avoidance_enabled) {
-					NavigationServer3D::get_singleton()->agent_set_position(agent, agent_parent->get_global_transform().origin);
-					NavigationServer3D::get_singleton()->agent_set_velocity(agent, Vector3(0.0, 0.0, 0.0));
-					NavigationServer3D::get_singleton()->agent_set_velocity_forced(agent, Vector3(0.0, 0.0, 0.0));
-					stored_y_velocity = 0.0;
-				}
-				emit_signal(SNAME("navigation_finished"));
+				_transition_to_navigation_finished();
 				break;
 			}
 		}
 	}
 }
 
+void NavigationAgent3D::_transition_to_navigation_finished() {
+	_check_distance_to_target();
+	navigation_finished = true;
+	target_position_submitted = false;
+	if (avoidance_enabled) {
+		NavigationServer3D::get_singleton()->agent_set_position(agent, agent_parent->get_global_transform().origin);
+		NavigationServer3D::get_singleton()->agent_set_velocity(agent, Vector3(0.0, 0.0, 0.0));
+		NavigationServer3D::get_singleton()->agent_set_velocity_forced(agent, Vector3(0.0, 0.0, 0.0));
+		stored_y_velocity = 0.0;
+	}
+	emit_signal(SNAME("navigation_finished"));
+}
+
 void NavigationAgent3D::_request_repath() {
 	navigation_result->reset();
 	target_reached = false;
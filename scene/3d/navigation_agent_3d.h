@@ -44,6 +44,7 @@ class NavigationAgent3D : public Node {
 
 	RID agent;
 	RID map_override;
+	RID flow_field;
 
 	bool avoidance_enabled = false;
 	bool use_3d_avoidance = false;
@@ -157,6 +158,9 @@ public:
 	void set_navigation_map(RID p_navigation_map);
 	RID get_navigation_map() const;
 
+	void set_flow_field(RID p_flow_field);
+	RID get_flow_field() const;
+
 	void set_path_desired_distance(real_t p_dd);
 	real_t get_path_desired_distance() const { return path_desired_distance; }
 
@@ -253,6 +257,7 @@ private:
 	void update_navigation();
 	void _request_repath();
 	void _check_distance_to_target();
+	void _transition_to_navigation_finished();
 
 #ifdef DEBUG_ENABLED
 	void _navigation_debug_changed();
@@ -43,16 +43,9 @@ void NavigationMeshSourceGeometryData3D::clear() {
 	indices.clear();
 }
 
-void NavigationMeshSourceGeometryData3D::_add_vertex(const Vector3 &p_vec3) {
-	vertices.push_back(p_vec3.x);
-	vertices.push_back(p_vec3.y);
-	vertices.push_back(p_vec3.z);
-}
-
-void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
-	int current_vertex_count;
+void NavigationMeshSourceGeometryData3D::get_mesh_faces(const Ref<Mesh> &p_mesh, Vector<Vector3> &r_vertices, Vector<int> &r_indices) {
 	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
-		current_vertex_count = vertices.size() / 3;
+		const int current_vertex_count = r_vertices.size();
 
 		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			continue;
@@ -67,7 +60,7 @@ void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, cons
 
 		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
 
-		int face_count = index_count / 3;
+		const int face_count = index_count / 3;
 
 		Array a = p_mesh->surface_get_arrays(i);
 		ERR_CONTINUE(a.is_empty() || (a.size() != Mesh::ARRAY_MAX));
@@ -81,32 +74,52 @@ void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, cons
 			ERR_CONTINUE(mesh_indices.is_empty() || (mesh_indices.size() != index_count));
 			const int *ir = mesh_indices.ptr();
 
-			for (int j = 0; j < mesh_vertices.size(); j++) {
-				_add_vertex(p_xform.xform(vr[j]));
-			}
+			r_vertices.append_array(mesh_vertices);
 
 			for (int j = 0; j < face_count; j++) {
 				// CCW
-				indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
+				r_indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
+				r_indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
+				r_indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
 			}
 		} else {
 			ERR_CONTINUE(mesh_vertices.size() != index_count);
-			face_count = mesh_vertices.size() / 3;
 			for (int j = 0; j < face_count; j++) {
-				_add_vertex(p_xform.xform(vr[j * 3 + 0]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 2]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 1]));
+				r_vertices.push_back(vr[j * 3 + 0]);
+				r_vertices.push_back(vr[j * 3 + 2]);
+				r_vertices.push_back(vr[j * 3 + 1]);
 
-				indices.push_back(current_vertex_count + (j * 3 + 0));
-				indices.push_back(current_vertex_count + (j * 3 + 1));
-				indices.push_back(current_vertex_count + (j * 3 + 2));
+				r_indices.push_back(current_vertex_count + (j * 3 + 0));
+				r_indices.push_back(current_vertex_count + (j * 3 + 1));
+				r_indices.push_back(current_vertex_count + (j * 3 + 2));
 			}
 		}
 	}
 }
 
+void NavigationMeshSourceGeometryData3D::_add_vertex(const Vector3 &p_vec3) {
+	vertices.push_back(p_vec3.x);
+	vertices.push_back(p_vec3.y);
+	vertices.push_back(p_vec3.z);
+}
+
+void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
+	Vector<Vector3> mesh_vertices;
+	Vector<int> mesh_indices;
+	get_mesh_faces(p_mesh, mesh_vertices, mesh_indices);
+
+	const int current_vertex_count = vertices.size() / 3;
+	const Vector3 *vr = mesh_vertices.ptr();
+	for (int j = 0; j < mesh_vertices.size(); j++) {
+		_add_vertex(p_xform.xform(vr[j]));
+	}
+
+	const int *ir = mesh_indices.ptr();
+	for (int j = 0; j < mesh_indices.size(); j++) {
+		indices.push_back(current_vertex_count + ir[j]);
+	}
+}
+
 void NavigationMeshSourceGeometryData3D::_add_mesh_array(const Array &p_mesh_array, const Transform3D &p_xform) {
 	ERR_FAIL_COND(p_mesh_array.size() != Mesh::ARRAY_MAX);
 
@@ -68,6 +68,8 @@ public:
 	void add_mesh_array(const Array &p_mesh_array, const Transform3D &p_xform);
 	void add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform);
 
+	static void get_mesh_faces(const Ref<Mesh> &p_mesh, Vector<Vector3> &r_vertices, Vector<int> &r_indices);
+
 	NavigationMeshSourceGeometryData3D();
 	~NavigationMeshSourceGeometryData3D();
 };
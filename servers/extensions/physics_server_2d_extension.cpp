@@ -161,6 +161,9 @@ void PhysicsServer2DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_save_snapshot, "space");
+	GDVIRTUAL_BIND(_space_restore_snapshot, "space", "snapshot");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
@@ -243,6 +243,22 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	// Optional, extensions that don't implement snapshots fail to restore them.
+	GDVIRTUAL1R(PackedByteArray, _space_save_snapshot, RID)
+	GDVIRTUAL2R(bool, _space_restore_snapshot, RID, const PackedByteArray &)
+
+	virtual void space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) override {
+		PackedByteArray ret;
+		GDVIRTUAL_CALL(_space_save_snapshot, p_space, ret);
+		r_snapshot = ret;
+	}
+
+	virtual bool space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override {
+		bool ret = false;
+		GDVIRTUAL_CALL(_space_restore_snapshot, p_space, p_snapshot, ret);
+		return ret;
+	}
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
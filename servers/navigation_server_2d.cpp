@@ -44,6 +44,8 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_cell_size", "map"), &NavigationServer2D::map_get_cell_size);
 	ClassDB::bind_method(D_METHOD("map_set_use_edge_connections", "map", "enabled"), &NavigationServer2D::map_set_use_edge_connections);
 	ClassDB::bind_method(D_METHOD("map_get_use_edge_connections", "map"), &NavigationServer2D::map_get_use_edge_connections);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_pathfinding", "map", "enabled"), &NavigationServer2D::map_set_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_pathfinding", "map"), &NavigationServer2D::map_get_use_hierarchical_pathfinding);
 	ClassDB::bind_method(D_METHOD("map_set_edge_connection_margin", "map", "margin"), &NavigationServer2D::map_set_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer2D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer2D::map_set_link_connection_radius);
@@ -60,6 +62,7 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_force_update", "map"), &NavigationServer2D::map_force_update);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer2D::query_path);
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "results"), &NavigationServer2D::query_paths);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer2D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer2D::region_set_enabled);
@@ -103,6 +106,15 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("link_set_owner_id", "link", "owner_id"), &NavigationServer2D::link_set_owner_id);
 	ClassDB::bind_method(D_METHOD("link_get_owner_id", "link"), &NavigationServer2D::link_get_owner_id);
 
+	ClassDB::bind_method(D_METHOD("flow_field_create"), &NavigationServer2D::flow_field_create);
+	ClassDB::bind_method(D_METHOD("flow_field_set_map", "flow_field", "map"), &NavigationServer2D::flow_field_set_map);
+	ClassDB::bind_method(D_METHOD("flow_field_get_map", "flow_field"), &NavigationServer2D::flow_field_get_map);
+	ClassDB::bind_method(D_METHOD("flow_field_set_target_position", "flow_field", "position"), &NavigationServer2D::flow_field_set_target_position);
+	ClassDB::bind_method(D_METHOD("flow_field_get_target_position", "flow_field"), &NavigationServer2D::flow_field_get_target_position);
+	ClassDB::bind_method(D_METHOD("flow_field_set_navigation_layers", "flow_field", "navigation_layers"), &NavigationServer2D::flow_field_set_navigation_layers);
+	ClassDB::bind_method(D_METHOD("flow_field_get_navigation_layers", "flow_field"), &NavigationServer2D::flow_field_get_navigation_layers);
+	ClassDB::bind_method(D_METHOD("flow_field_get_direction", "flow_field", "position"), &NavigationServer2D::flow_field_get_direction);
+
 	ClassDB::bind_method(D_METHOD("agent_create"), &NavigationServer2D::agent_create);
 	ClassDB::bind_method(D_METHOD("agent_set_avoidance_enabled", "agent", "enabled"), &NavigationServer2D::agent_set_avoidance_enabled);
 	ClassDB::bind_method(D_METHOD("agent_get_avoidance_enabled", "agent"), &NavigationServer2D::agent_get_avoidance_enabled);
@@ -78,6 +78,10 @@ public:
 	virtual void map_set_use_edge_connections(RID p_map, bool p_enabled) = 0;
 	virtual bool map_get_use_edge_connections(RID p_map) const = 0;
 
+	/// Set if the path queries of this map search the connections between regions and links first.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
 	/// Set the map edge connection margin used to weld the compatible region edges.
 	virtual void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) = 0;
 
@@ -183,6 +187,24 @@ public:
 	virtual void link_set_owner_id(RID p_link, ObjectID p_owner_id) = 0;
 	virtual ObjectID link_get_owner_id(RID p_link) const = 0;
 
+	/// Creates a flow field leading to a target in the nav map.
+	virtual RID flow_field_create() = 0;
+
+	/// Set the map of this flow field.
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	/// Set the position the flow field leads to.
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector2 p_position) = 0;
+	virtual Vector2 flow_field_get_target_position(RID p_flow_field) const = 0;
+
+	/// Set the navigation layers the flow field goes through.
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+
+	/// Get the direction toward the target of the flow field at a position.
+	virtual Vector2 flow_field_get_direction(RID p_flow_field, Vector2 p_position) const = 0;
+
 	/// Creates the agent.
 	virtual RID agent_create() = 0;
 
@@ -270,6 +292,9 @@ public:
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const = 0;
 
+	/// Returns customized navigation paths for many query parameters objects at once.
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) const = 0;
+
 	virtual void init() = 0;
 	virtual void sync() = 0;
 	virtual void finish() = 0;
@@ -46,6 +46,8 @@ public:
 	real_t map_get_cell_size(RID p_map) const override { return 0; }
 	void map_set_use_edge_connections(RID p_map, bool p_enabled) override {}
 	bool map_get_use_edge_connections(RID p_map) const override { return false; }
+	void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) override {}
+	bool map_get_use_hierarchical_pathfinding(RID p_map) const override { return false; }
 	void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) override {}
 	real_t map_get_edge_connection_margin(RID p_map) const override { return 0; }
 	void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) override {}
@@ -100,6 +102,14 @@ public:
 	real_t link_get_travel_cost(RID p_link) const override { return 0; }
 	void link_set_owner_id(RID p_link, ObjectID p_owner_id) override {}
 	ObjectID link_get_owner_id(RID p_link) const override { return ObjectID(); }
+	RID flow_field_create() override { return RID(); }
+	void flow_field_set_map(RID p_flow_field, RID p_map) override {}
+	RID flow_field_get_map(RID p_flow_field) const override { return RID(); }
+	void flow_field_set_target_position(RID p_flow_field, Vector2 p_position) override {}
+	Vector2 flow_field_get_target_position(RID p_flow_field) const override { return Vector2(); }
+	void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) override {}
+	uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override { return 0; }
+	Vector2 flow_field_get_direction(RID p_flow_field, Vector2 p_position) const override { return Vector2(); }
 
 	RID agent_create() override { return RID(); }
 	void agent_set_map(RID p_agent, RID p_map) override {}
@@ -137,6 +147,7 @@ public:
 	void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) override {}
 
 	void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const override {}
+	void query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) const override {}
 
 	void init() override {}
 	void sync() override {}
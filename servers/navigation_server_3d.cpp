@@ -47,6 +47,8 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_cell_height", "map"), &NavigationServer3D::map_get_cell_height);
 	ClassDB::bind_method(D_METHOD("map_set_use_edge_connections", "map", "enabled"), &NavigationServer3D::map_set_use_edge_connections);
 	ClassDB::bind_method(D_METHOD("map_get_use_edge_connections", "map"), &NavigationServer3D::map_get_use_edge_connections);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_pathfinding", "map", "enabled"), &NavigationServer3D::map_set_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_pathfinding", "map"), &NavigationServer3D::map_get_use_hierarchical_pathfinding);
 	ClassDB::bind_method(D_METHOD("map_set_edge_connection_margin", "map", "margin"), &NavigationServer3D::map_set_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer3D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer3D::map_set_link_connection_radius);
@@ -65,6 +67,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_force_update", "map"), &NavigationServer3D::map_force_update);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "results"), &NavigationServer3D::query_paths);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -111,6 +114,15 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("link_set_owner_id", "link", "owner_id"), &NavigationServer3D::link_set_owner_id);
 	ClassDB::bind_method(D_METHOD("link_get_owner_id", "link"), &NavigationServer3D::link_get_owner_id);
 
+	ClassDB::bind_method(D_METHOD("flow_field_create"), &NavigationServer3D::flow_field_create);
+	ClassDB::bind_method(D_METHOD("flow_field_set_map", "flow_field", "map"), &NavigationServer3D::flow_field_set_map);
+	ClassDB::bind_method(D_METHOD("flow_field_get_map", "flow_field"), &NavigationServer3D::flow_field_get_map);
+	ClassDB::bind_method(D_METHOD("flow_field_set_target_position", "flow_field", "position"), &NavigationServer3D::flow_field_set_target_position);
+	ClassDB::bind_method(D_METHOD("flow_field_get_target_position", "flow_field"), &NavigationServer3D::flow_field_get_target_position);
+	ClassDB::bind_method(D_METHOD("flow_field_set_navigation_layers", "flow_field", "navigation_layers"), &NavigationServer3D::flow_field_set_navigation_layers);
+	ClassDB::bind_method(D_METHOD("flow_field_get_navigation_layers", "flow_field"), &NavigationServer3D::flow_field_get_navigation_layers);
+	ClassDB::bind_method(D_METHOD("flow_field_get_direction", "flow_field", "position"), &NavigationServer3D::flow_field_get_direction);
+
 	ClassDB::bind_method(D_METHOD("agent_create"), &NavigationServer3D::agent_create);
 	ClassDB::bind_method(D_METHOD("agent_set_avoidance_enabled", "agent", "enabled"), &NavigationServer3D::agent_set_avoidance_enabled);
 	ClassDB::bind_method(D_METHOD("agent_get_avoidance_enabled", "agent"), &NavigationServer3D::agent_get_avoidance_enabled);
@@ -156,6 +168,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("parse_source_geometry_data", "navigation_mesh", "source_geometry_data", "root_node", "callback"), &NavigationServer3D::parse_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data", "navigation_mesh", "source_geometry_data", "callback"), &NavigationServer3D::bake_from_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data_async", "navigation_mesh", "source_geometry_data", "callback"), &NavigationServer3D::bake_from_source_geometry_data_async, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("bake_tiles_from_source_geometry_data", "tiles", "source_geometry_data"), &NavigationServer3D::bake_tiles_from_source_geometry_data);
 
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &NavigationServer3D::free);
 
@@ -180,6 +193,8 @@ void NavigationServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(INFO_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(INFO_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(INFO_MAP_SYNC_TIME);
+	BIND_ENUM_CONSTANT(INFO_REGION_SYNC_COUNT);
 }
 
 NavigationServer3D *NavigationServer3D::get_singleton() {
@@ -904,6 +919,37 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+void NavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must be the same.");
+
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	parameters.resize(p_query_parameters.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		ERR_FAIL_COND(!query_parameters.is_valid());
+		ERR_FAIL_COND(!Ref<NavigationPathQueryResult3D>(p_query_results[i]).is_valid());
+		parameters[i] = query_parameters->get_parameters();
+	}
+
+	LocalVector<NavigationUtilities::PathQueryResult> results;
+	_query_paths(parameters, results);
+
+	for (int i = 0; i < p_query_results.size(); i++) {
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		query_result->set_path(results[i].path);
+		query_result->set_path_types(results[i].path_types);
+		query_result->set_path_rids(results[i].path_rids);
+		query_result->set_path_owner_ids(results[i].path_owner_ids);
+	}
+}
+
+void NavigationServer3D::_query_paths(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<NavigationUtilities::PathQueryResult> &r_results) const {
+	r_results.resize(p_parameters.size());
+	for (uint32_t i = 0; i < p_parameters.size(); i++) {
+		r_results[i] = _query_path(p_parameters[i]);
+	}
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
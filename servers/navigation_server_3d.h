@@ -32,6 +32,7 @@
 #define NAVIGATION_SERVER_3D_H
 
 #include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 
 #include "scene/resources/navigation_mesh.h"
@@ -87,6 +88,10 @@ public:
 	virtual void map_set_use_edge_connections(RID p_map, bool p_enabled) = 0;
 	virtual bool map_get_use_edge_connections(RID p_map) const = 0;
 
+	/// Set if the path queries of this map search the connections between regions and links first.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
 	/// Set the map edge connection margin used to weld the compatible region edges.
 	virtual void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) = 0;
 
@@ -199,6 +204,24 @@ public:
 	virtual void link_set_owner_id(RID p_link, ObjectID p_owner_id) = 0;
 	virtual ObjectID link_get_owner_id(RID p_link) const = 0;
 
+	/// Creates a flow field leading to a target in the nav map.
+	virtual RID flow_field_create() = 0;
+
+	/// Set the map of this flow field.
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	/// Set the position the flow field leads to.
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector3 p_position) = 0;
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const = 0;
+
+	/// Set the navigation layers the flow field goes through.
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+
+	/// Get the direction toward the target of the flow field at a position.
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, Vector3 p_position) const = 0;
+
 	/// Creates the agent.
 	virtual RID agent_create() = 0;
 
@@ -310,9 +333,16 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Returns customized navigation paths for many query parameters objects at once.
+	void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const;
+
+	/// Servers can resolve the queries in parallel, by default they run one after the other.
+	virtual void _query_paths(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<NavigationUtilities::PathQueryResult> &r_results) const;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
+	virtual int bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_tiles, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) = 0;
 
 	NavigationServer3D();
 	~NavigationServer3D() override;
@@ -327,6 +357,8 @@ public:
 		INFO_EDGE_MERGE_COUNT,
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
+		INFO_MAP_SYNC_TIME,
+		INFO_REGION_SYNC_COUNT,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
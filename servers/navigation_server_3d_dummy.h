@@ -49,6 +49,8 @@ public:
 	real_t map_get_cell_height(RID p_map) const override { return 0; }
 	void map_set_use_edge_connections(RID p_map, bool p_enabled) override {}
 	bool map_get_use_edge_connections(RID p_map) const override { return false; }
+	void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) override {}
+	bool map_get_use_hierarchical_pathfinding(RID p_map) const override { return false; }
 	void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) override {}
 	real_t map_get_edge_connection_margin(RID p_map) const override { return 0; }
 	void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) override {}
@@ -106,6 +108,14 @@ public:
 	real_t link_get_travel_cost(RID p_link) const override { return 0; }
 	void link_set_owner_id(RID p_link, ObjectID p_owner_id) override {}
 	ObjectID link_get_owner_id(RID p_link) const override { return ObjectID(); }
+	RID flow_field_create() override { return RID(); }
+	void flow_field_set_map(RID p_flow_field, RID p_map) override {}
+	RID flow_field_get_map(RID p_flow_field) const override { return RID(); }
+	void flow_field_set_target_position(RID p_flow_field, Vector3 p_position) override {}
+	Vector3 flow_field_get_target_position(RID p_flow_field) const override { return Vector3(); }
+	void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) override {}
+	uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override { return 0; }
+	Vector3 flow_field_get_direction(RID p_flow_field, Vector3 p_position) const override { return Vector3(); }
 	RID agent_create() override { return RID(); }
 	void agent_set_map(RID p_agent, RID p_map) override {}
 	RID agent_get_map(RID p_agent) const override { return RID(); }
@@ -146,6 +156,7 @@ public:
 	void obstacle_set_vertices(RID p_obstacle, const Vector<Vector3> &p_vertices) override {}
 	void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) override {}
 	void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override {}
+	int bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_tiles, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) override { return 0; }
 	void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override {}
 	void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override {}
 	void free(RID p_object) override {}
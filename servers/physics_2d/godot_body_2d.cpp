@@ -388,6 +388,40 @@ Variant GodotBody2D::get_state(PhysicsServer2D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody2D::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.transform = get_transform();
+	r_snapshot.inv_transform = get_inv_transform();
+	r_snapshot.new_transform = new_transform;
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.prev_linear_velocity = prev_linear_velocity;
+	r_snapshot.prev_angular_velocity = prev_angular_velocity;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+	r_snapshot.first_time_kinematic = first_time_kinematic;
+}
+
+void GodotBody2D::restore_snapshot(const Snapshot &p_snapshot) {
+	if (get_transform() != p_snapshot.transform) {
+		_set_transform(p_snapshot.transform); // Moves the shapes in the broadphase.
+		_update_transform_dependent();
+	}
+	_set_inv_transform(p_snapshot.inv_transform);
+	new_transform = p_snapshot.new_transform;
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	prev_linear_velocity = p_snapshot.prev_linear_velocity;
+	prev_angular_velocity = p_snapshot.prev_angular_velocity;
+	still_time = p_snapshot.still_time;
+	first_time_kinematic = p_snapshot.first_time_kinematic;
+	set_active(p_snapshot.active);
+
+	// Let the nodes know, sleeping bodies included.
+	if ((fi_callback_data || body_state_callback.is_valid()) && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody2D::set_space(GodotSpace2D *p_space) {
 	if (get_space()) {
 		wakeup_neighbours();
@@ -418,6 +452,16 @@ void GodotBody2D::_update_transform_dependent() {
 }
 
 void GodotBody2D::integrate_forces(real_t p_step) {
+	integrate_forces_local(p_step);
+	integrate_forces_finish();
+}
+
+void GodotBody2D::integrate_velocities(real_t p_step) {
+	integrate_velocities_local(p_step);
+	integrate_velocities_finish();
+}
+
+void GodotBody2D::integrate_forces_local(real_t p_step) {
 	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
 		return;
 	}
@@ -603,28 +647,30 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = 0.0;
 	biased_linear_velocity = Vector2();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	//shapes temporarily extend for raycast
+	pending_motion = motion;
+	pending_motion_update = do_motion;
 
 	contact_count = 0;
 }
 
-void GodotBody2D::integrate_velocities(real_t p_step) {
-	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
-		return;
+void GodotBody2D::integrate_forces_finish() {
+	if (pending_motion_update) {
+		_update_shapes_with_motion(pending_motion);
+		pending_motion_update = false;
 	}
+}
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+void GodotBody2D::integrate_velocities_local(real_t p_step) {
+	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
+		return;
 	}
 
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
-		}
+		//stopped moving, deactivate
+		pending_deactivation = contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0;
 		return;
 	}
 
@@ -640,8 +686,9 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
+	pending_shapes_update = continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED;
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
 		new_transform = get_transform();
@@ -650,6 +697,26 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody2D::integrate_velocities_finish() {
+	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (pending_shapes_update) {
+		_update_shapes();
+		pending_shapes_update = false;
+	}
+
+	if (pending_deactivation) {
+		set_active(false);
+		pending_deactivation = false;
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -42,6 +42,8 @@ class GodotConstraint2D;
 class GodotPhysicsDirectBodyState2D;
 
 class GodotBody2D : public GodotCollisionObject2D {
+	// State read and written by the solver for every contact and joint, and by the integration,
+	// is declared first so that it's close together in memory. Colder state follows.
 	PhysicsServer2D::BodyMode mode = PhysicsServer2D::BODY_MODE_RIGID;
 
 	Vector2 biased_linear_velocity;
@@ -50,6 +52,24 @@ class GodotBody2D : public GodotCollisionObject2D {
 	Vector2 linear_velocity;
 	real_t angular_velocity = 0.0;
 
+	real_t _inv_mass = 1.0;
+	real_t _inv_inertia = 0.0;
+
+	Vector2 center_of_mass;
+
+	Vector2 gravity;
+
+	real_t total_linear_damp = 0.0;
+	real_t total_angular_damp = 0.0;
+
+	Vector2 applied_force;
+	real_t applied_torque = 0.0;
+
+	Vector2 constant_force;
+	real_t constant_torque = 0.0;
+
+	real_t still_time = 0.0;
+
 	Vector2 prev_linear_velocity;
 	real_t prev_angular_velocity = 0.0;
 
@@ -62,36 +82,19 @@ class GodotBody2D : public GodotCollisionObject2D {
 	real_t linear_damp = 0.0;
 	real_t angular_damp = 0.0;
 
-	real_t total_linear_damp = 0.0;
-	real_t total_angular_damp = 0.0;
-
 	real_t gravity_scale = 1.0;
 
 	real_t bounce = 0.0;
 	real_t friction = 1.0;
 
 	real_t mass = 1.0;
-	real_t _inv_mass = 1.0;
-
 	real_t inertia = 0.0;
-	real_t _inv_inertia = 0.0;
 
 	Vector2 center_of_mass_local;
-	Vector2 center_of_mass;
 
 	bool calculate_inertia = true;
 	bool calculate_center_of_mass = true;
 
-	Vector2 gravity;
-
-	real_t still_time = 0.0;
-
-	Vector2 applied_force;
-	real_t applied_torque = 0.0;
-
-	Vector2 constant_force;
-	real_t constant_torque = 0.0;
-
 	SelfList<GodotBody2D> active_list;
 	SelfList<GodotBody2D> mass_properties_update_list;
 	SelfList<GodotBody2D> direct_state_query_list;
@@ -151,6 +154,13 @@ class GodotBody2D : public GodotCollisionObject2D {
 	GodotPhysicsDirectBodyState2D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_node = 0;
+
+	// Left by the thread-safe half of the integration for the half that updates the space.
+	Vector2 pending_motion;
+	bool pending_motion_update = false;
+	bool pending_shapes_update = false;
+	bool pending_deactivation = false;
 
 	void _update_transform_dependent();
 
@@ -202,6 +212,9 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ uint32_t get_island_node() const { return island_node; }
+	_FORCE_INLINE_ void set_island_node(uint32_t p_node) { island_node = p_node; }
+
 	_FORCE_INLINE_ void add_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.push_back({ p_constraint, p_pos }); }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.erase({ p_constraint, p_pos }); }
 	const List<Pair<GodotConstraint2D *, int>> &get_constraint_list() const { return constraint_list; }
@@ -300,6 +313,23 @@ public:
 	void set_state(PhysicsServer2D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer2D::BodyState p_state) const;
 
+	// State changed by stepping, kept in space snapshots. Parameters are left to whoever set them.
+	struct Snapshot {
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+		bool first_time_kinematic = false;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection_mode(PhysicsServer2D::CCDMode p_mode) { continuous_cd_mode = p_mode; }
 	_FORCE_INLINE_ PhysicsServer2D::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
 
@@ -318,6 +348,13 @@ public:
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
 
+	// Both integrations split in a first half that only touches this body, so it can run for several
+	// bodies in parallel, and a second half that updates the space and must run on a single thread.
+	void integrate_forces_local(real_t p_step);
+	void integrate_forces_finish();
+	void integrate_velocities_local(real_t p_step);
+	void integrate_velocities_finish();
+
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
 	}
@@ -245,6 +245,63 @@ real_t combine_friction(GodotBody2D *A, GodotBody2D *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
+// Contacts are plain data, kept as is along with the separating axis used as a hint for the next test
+// and whether one way collision was disabled for the pair.
+uint32_t GodotBodyPair2D::get_snapshot_size() const {
+	return sizeof(Vector2) + sizeof(int) + sizeof(bool) + sizeof(Contact) * MAX_CONTACTS;
+}
+
+void GodotBodyPair2D::save_snapshot(uint8_t *r_snapshot) const {
+	memcpy(r_snapshot, &sep_axis, sizeof(Vector2));
+	r_snapshot += sizeof(Vector2);
+	memcpy(r_snapshot, &contact_count, sizeof(int));
+	r_snapshot += sizeof(int);
+	memcpy(r_snapshot, &oneway_disabled, sizeof(bool));
+	r_snapshot += sizeof(bool);
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		// Copied field by field into zeroed storage, so that padding bytes don't end up in the snapshot.
+		const Contact &from = contacts[i];
+		Contact contact;
+		memset((void *)&contact, 0, sizeof(Contact));
+		contact.position = from.position;
+		contact.normal = from.normal;
+		contact.local_A = from.local_A;
+		contact.local_B = from.local_B;
+		contact.acc_impulse = from.acc_impulse;
+		contact.acc_normal_impulse = from.acc_normal_impulse;
+		contact.acc_tangent_impulse = from.acc_tangent_impulse;
+		contact.acc_bias_impulse = from.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = from.acc_bias_impulse_center_of_mass;
+		contact.mass_normal = from.mass_normal;
+		contact.mass_tangent = from.mass_tangent;
+		contact.bias = from.bias;
+		contact.depth = from.depth;
+		contact.active = from.active;
+		contact.used = from.used;
+		contact.rA = from.rA;
+		contact.rB = from.rB;
+		contact.bounce = from.bounce;
+		memcpy(r_snapshot, &contact, sizeof(Contact));
+		r_snapshot += sizeof(Contact);
+	}
+}
+
+void GodotBodyPair2D::restore_snapshot(const uint8_t *p_snapshot) {
+	memcpy(&sep_axis, p_snapshot, sizeof(Vector2));
+	p_snapshot += sizeof(Vector2);
+	memcpy(&contact_count, p_snapshot, sizeof(int));
+	p_snapshot += sizeof(int);
+	memcpy(&oneway_disabled, p_snapshot, sizeof(bool));
+	p_snapshot += sizeof(bool);
+	memcpy(contacts, p_snapshot, sizeof(Contact) * MAX_CONTACTS);
+}
+
+void GodotBodyPair2D::reset_snapshot() {
+	sep_axis = Vector2();
+	contact_count = 0;
+	oneway_disabled = false;
+}
+
 bool GodotBodyPair2D::setup(real_t p_step) {
 	check_ccd = false;
 
@@ -60,6 +60,15 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Tells apart constraints between the same bodies, such as contacts between different shapes.
+	virtual uint64_t get_order_subindex() const { return 0; }
+
+	// State carried over from one step to the next, such as contact caches, kept in space snapshots.
+	virtual uint32_t get_snapshot_size() const { return 0; }
+	virtual void save_snapshot(uint8_t *r_snapshot) const {}
+	virtual void restore_snapshot(const uint8_t *p_snapshot) {}
+	virtual void reset_snapshot() {}
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -276,6 +276,18 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+void GodotPhysicsServer2D::space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	space->save_snapshot(r_snapshot);
+}
+
+bool GodotPhysicsServer2D::space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->restore_snapshot(p_snapshot);
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL_V(space, nullptr);
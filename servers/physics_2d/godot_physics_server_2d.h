@@ -116,6 +116,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual void space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) override;
+	virtual bool space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
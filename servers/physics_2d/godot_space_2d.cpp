@@ -35,6 +35,7 @@
 
 #include "core/os/os.h"
 #include "core/templates/pair.h"
+#include "core/templates/sort_array.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -1143,6 +1144,178 @@ void GodotSpace2D::update() {
 	broadphase->update();
 }
 
+// Gathers the constraints with state to keep in snapshots, in an order that doesn't depend on when they were created.
+void GodotSpace2D::_gather_snapshot_constraints() {
+	snapshot_constraints.clear();
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(E);
+		for (const Pair<GodotConstraint2D *, int> &F : body->get_constraint_list()) {
+			GodotConstraint2D *constraint = F.first;
+			// Visit pairs from their first body only.
+			if (F.second == 0 && constraint->get_body_count() == 2 && constraint->get_snapshot_size() > 0) {
+				snapshot_constraints.push_back(constraint);
+			}
+		}
+	}
+
+	SortArray<GodotConstraint2D *, GodotConstraint2DOrder> sorter;
+	sorter.sort(snapshot_constraints.ptr(), snapshot_constraints.size());
+}
+
+// Layout: version, body count and constraint count, then for each body its RID and state in the order of the objects,
+// then for each constraint the RIDs of both bodies, its subindex, the size of its state and the state itself.
+void GodotSpace2D::save_snapshot(Vector<uint8_t> &r_snapshot) {
+	ERR_FAIL_COND(locked);
+
+	uint32_t body_count = 0;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			body_count++;
+		}
+	}
+
+	_gather_snapshot_constraints();
+
+	uint32_t size = sizeof(uint32_t) * 3 + body_count * (sizeof(uint64_t) + sizeof(GodotBody2D::Snapshot));
+	for (const GodotConstraint2D *constraint : snapshot_constraints) {
+		size += sizeof(uint64_t) * 3 + sizeof(uint32_t) + constraint->get_snapshot_size();
+	}
+
+	// Reuses the buffer of the previous snapshot when nothing was added or removed.
+	r_snapshot.resize(size);
+	uint8_t *w = r_snapshot.ptrw();
+
+	const uint32_t header[3] = { SNAPSHOT_VERSION, body_count, snapshot_constraints.size() };
+	memcpy(w, header, sizeof(header));
+	w += sizeof(header);
+
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		uint64_t id = E->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+
+		// Zeroed first, the fields are then set one by one and padding bytes are left out of the snapshot.
+		GodotBody2D::Snapshot state;
+		memset((void *)&state, 0, sizeof(GodotBody2D::Snapshot));
+		static_cast<const GodotBody2D *>(E)->save_snapshot(state);
+		memcpy(w, &state, sizeof(GodotBody2D::Snapshot));
+		w += sizeof(GodotBody2D::Snapshot);
+	}
+
+	for (const GodotConstraint2D *constraint : snapshot_constraints) {
+		const uint64_t key[3] = { constraint->get_body_ptr()[0]->get_self().get_id(), constraint->get_body_ptr()[1]->get_self().get_id(), constraint->get_order_subindex() };
+		memcpy(w, key, sizeof(key));
+		w += sizeof(key);
+
+		uint32_t state_size = constraint->get_snapshot_size();
+		memcpy(w, &state_size, sizeof(uint32_t));
+		w += sizeof(uint32_t);
+
+		constraint->save_snapshot(w);
+		w += state_size;
+	}
+}
+
+bool GodotSpace2D::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_V(locked, false);
+
+	const uint8_t *r = p_snapshot.ptr();
+	const uint8_t *end = r + p_snapshot.size();
+
+	uint32_t header[3];
+	ERR_FAIL_COND_V_MSG(p_snapshot.size() < (int)sizeof(header), false, "Invalid physics space snapshot.");
+	memcpy(header, r, sizeof(header));
+	r += sizeof(header);
+	ERR_FAIL_COND_V_MSG(header[0] != SNAPSHOT_VERSION, false, "Invalid physics space snapshot.");
+
+	// Check everything matches before changing anything.
+	const uint32_t body_record_size = sizeof(uint64_t) + sizeof(GodotBody2D::Snapshot);
+	ERR_FAIL_COND_V_MSG(end - r < (int64_t)header[1] * body_record_size, false, "Invalid physics space snapshot.");
+	const uint8_t *body_records = r;
+	uint32_t body_count = 0;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		ERR_FAIL_COND_V_MSG(body_count == header[1], false, "The physics space snapshot was saved with different bodies.");
+		uint64_t id;
+		memcpy(&id, body_records + body_count * body_record_size, sizeof(uint64_t));
+		ERR_FAIL_COND_V_MSG(id != E->get_self().get_id(), false, "The physics space snapshot was saved with different bodies.");
+		body_count++;
+	}
+	ERR_FAIL_COND_V_MSG(body_count != header[1], false, "The physics space snapshot was saved with different bodies.");
+
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody2D::Snapshot state;
+		memcpy(&state, r + sizeof(uint64_t), sizeof(GodotBody2D::Snapshot));
+		static_cast<GodotBody2D *>(E)->restore_snapshot(state);
+		r += body_record_size;
+	}
+
+	// Get the pairs for the restored positions, then match them with the saved ones.
+	// Both are sorted by the same keys, pairs that weren't saved start over.
+	update();
+	_gather_snapshot_constraints();
+
+	const uint32_t constraint_record_count = header[2];
+	uint32_t constraint_record_index = 0;
+	uint64_t record_key[3] = {};
+	uint32_t record_size = 0;
+	bool record_loaded = false;
+
+	for (GodotConstraint2D *constraint : snapshot_constraints) {
+		const uint64_t key[3] = { constraint->get_body_ptr()[0]->get_self().get_id(), constraint->get_body_ptr()[1]->get_self().get_id(), constraint->get_order_subindex() };
+
+		bool restored = false;
+		while (true) {
+			if (!record_loaded) {
+				if (constraint_record_index == constraint_record_count) {
+					break;
+				}
+				ERR_FAIL_COND_V_MSG(end - r < (int64_t)(sizeof(record_key) + sizeof(uint32_t)), false, "Invalid physics space snapshot.");
+				memcpy(record_key, r, sizeof(record_key));
+				memcpy(&record_size, r + sizeof(record_key), sizeof(uint32_t));
+				r += sizeof(record_key) + sizeof(uint32_t);
+				ERR_FAIL_COND_V_MSG(end - r < (int64_t)record_size, false, "Invalid physics space snapshot.");
+				record_loaded = true;
+			}
+
+			if (record_key[0] != key[0] || record_key[1] != key[1] || record_key[2] != key[2]) {
+				bool record_before = record_key[0] != key[0] ? record_key[0] < key[0] : (record_key[1] != key[1] ? record_key[1] < key[1] : record_key[2] < key[2]);
+				if (!record_before) {
+					break; // Not saved, this pair is new.
+				}
+			} else if (record_size == constraint->get_snapshot_size()) {
+				constraint->restore_snapshot(r);
+				restored = true;
+			}
+
+			// The pair that record belongs to is gone.
+			r += record_size;
+			constraint_record_index++;
+			record_loaded = false;
+			if (restored) {
+				break;
+			}
+		}
+
+		if (!restored) {
+			constraint->reset_snapshot();
+		}
+	}
+
+	return true;
+}
+
 void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -40,8 +40,29 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
+// Orders constraints by the objects they connect, rather than by when they were found.
+struct GodotConstraint2DOrder {
+	_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+		if (p_a->get_body_count() != p_b->get_body_count()) {
+			return p_a->get_body_count() < p_b->get_body_count();
+		}
+		for (int i = 0; i < p_a->get_body_count(); i++) {
+			const RID &body_a = p_a->get_body_ptr()[i]->get_self();
+			const RID &body_b = p_b->get_body_ptr()[i]->get_self();
+			if (body_a != body_b) {
+				return body_a < body_b;
+			}
+		}
+		if (p_a->get_self() != p_b->get_self()) {
+			return p_a->get_self() < p_b->get_self(); // Joints between the same bodies.
+		}
+		return p_a->get_order_subindex() < p_b->get_order_subindex();
+	}
+};
+
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
@@ -128,6 +149,14 @@ private:
 	Vector<Vector2> contact_debug;
 	int contact_debug_count = 0;
 
+	enum {
+		SNAPSHOT_VERSION = 1
+	};
+
+	LocalVector<GodotConstraint2D *> snapshot_constraints;
+
+	void _gather_snapshot_constraints();
+
 	friend class GodotPhysicsDirectSpaceState2D;
 
 public:
@@ -172,6 +201,9 @@ public:
 	void setup();
 	void call_queries();
 
+	void save_snapshot(Vector<uint8_t> &r_snapshot);
+	bool restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	bool is_locked() const;
 	void lock();
 	void unlock();
@@ -38,28 +38,26 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define BODY_INTEGRATION_CHUNK_SIZE 64
 
-void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
+void GodotStep2D::_add_island_body(GodotBody2D *p_body) {
 	p_body->set_island_step(_step);
+	p_body->set_island_node(island_bodies.size());
+	island_bodies.push_back(p_body);
+}
 
-	if (p_body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
-		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
-	}
-
+void GodotStep2D::_gather_island_constraints(GodotBody2D *p_body) {
 	for (const Pair<GodotConstraint2D *, int> &E : p_body->get_constraint_list()) {
 		GodotConstraint2D *constraint = const_cast<GodotConstraint2D *>(E.first);
 		if (constraint->get_island_step() == _step) {
 			continue; // Already processed.
 		}
 		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
+
 		all_constraints.push_back(constraint);
+		island_constraint_nodes.push_back(p_body->get_island_node());
 
 		for (int i = 0; i < constraint->get_body_count(); i++) {
-			if (i == E.second) {
-				continue;
-			}
 			GodotBody2D *other_body = constraint->get_body_ptr()[i];
 			if (other_body->get_island_step() == _step) {
 				continue; // Already processed.
@@ -67,11 +65,40 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 			if (other_body->get_mode() == PhysicsServer2D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			_add_island_body(other_body);
 		}
 	}
 }
 
+void GodotStep2D::_unite_island_constraint(uint32_t p_constraint_index, void *p_userdata) {
+	GodotConstraint2D *constraint = all_constraints[island_constraint_offset + p_constraint_index];
+	uint32_t node = island_constraint_nodes[p_constraint_index];
+
+	for (int i = 0; i < constraint->get_body_count(); i++) {
+		GodotBody2D *body = constraint->get_body_ptr()[i];
+		if (body->get_mode() == PhysicsServer2D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
+		}
+		island_sets.create_union(node, body->get_island_node());
+	}
+}
+
+void GodotStep2D::_integrate_forces_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	uint32_t body_begin = p_chunk_index * BODY_INTEGRATION_CHUNK_SIZE;
+	uint32_t body_end = MIN(body_begin + BODY_INTEGRATION_CHUNK_SIZE, active_bodies.size());
+	for (uint32_t body_index = body_begin; body_index < body_end; ++body_index) {
+		active_bodies[body_index]->integrate_forces_local(delta);
+	}
+}
+
+void GodotStep2D::_integrate_velocities_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	uint32_t body_begin = p_chunk_index * BODY_INTEGRATION_CHUNK_SIZE;
+	uint32_t body_end = MIN(body_begin + BODY_INTEGRATION_CHUNK_SIZE, active_bodies.size());
+	for (uint32_t body_index = body_begin; body_index < body_end; ++body_index) {
+		active_bodies[body_index]->integrate_velocities_local(delta);
+	}
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -142,13 +169,22 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
+	active_bodies.clear();
 	const SelfList<GodotBody2D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
+	}
+
+	int active_count = active_bodies.size();
+
+	uint32_t body_chunk_count = (active_bodies.size() + BODY_INTEGRATION_CHUNK_SIZE - 1) / BODY_INTEGRATION_CHUNK_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces_chunk, nullptr, body_chunk_count, -1, true, SNAME("Physics2DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Extending shapes with their motion moves them in the broadphase, which isn't thread-safe.
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_forces_finish();
 	}
 
 	p_space->set_active_objects(active_count);
@@ -192,41 +228,67 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
+	island_bodies.clear();
+	island_constraint_nodes.clear();
+	island_constraint_offset = all_constraints.size();
+
 	b = body_list->first();
+	while (b) {
+		_add_island_body(b->self());
+		b = b->next();
+	}
+
+	// Gather everything connected to the active bodies breadth-first, the list grows while being walked.
+	for (uint32_t island_body_index = 0; island_body_index < island_bodies.size(); ++island_body_index) {
+		_gather_island_constraints(island_bodies[island_body_index]);
+	}
+
+	uint32_t island_node_count = island_bodies.size();
+	island_sets.reset(island_node_count);
+
+	uint32_t island_constraint_count = island_constraint_nodes.size();
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_unite_island_constraint, nullptr, island_constraint_count, -1, true, SNAME("Physics2DUniteIslands"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Each set is represented by its smallest node, so numbering islands by their first member
+	// gives the same islands in the same order no matter how the unions were scheduled.
+	island_root_body_islands.resize(island_node_count);
+	island_root_constraint_islands.resize(island_node_count);
+	for (uint32_t node = 0; node < island_node_count; ++node) {
+		island_root_body_islands[node] = UINT32_MAX;
+		island_root_constraint_islands[node] = UINT32_MAX;
+	}
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	for (GodotBody2D *body : island_bodies) {
+		if (body->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC) {
+			continue; // Only rigid bodies are tested for activation.
+		}
 
-		if (body->get_island_step() != _step) {
-			++body_island_count;
+		uint32_t &body_island_index = island_root_body_islands[island_sets.find(body->get_island_node())];
+		if (body_island_index == UINT32_MAX) {
+			body_island_index = body_island_count++;
 			if (body_islands.size() < body_island_count) {
 				body_islands.resize(body_island_count);
 			}
-			LocalVector<GodotBody2D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+			body_islands[body_island_index].clear();
+			body_islands[body_island_index].reserve(BODY_ISLAND_SIZE_RESERVE);
+		}
+		body_islands[body_island_index].push_back(body);
+	}
 
-			++island_count;
+	for (uint32_t constraint_index = 0; constraint_index < island_constraint_count; ++constraint_index) {
+		uint32_t &island_index = island_root_constraint_islands[island_sets.find(island_constraint_nodes[constraint_index])];
+		if (island_index == UINT32_MAX) {
+			island_index = island_count++;
 			if (constraint_islands.size() < island_count) {
 				constraint_islands.resize(island_count);
 			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+			constraint_islands[island_index].clear();
+			constraint_islands[island_index].reserve(ISLAND_SIZE_RESERVE);
 		}
-		b = b->next();
+		constraint_islands[island_index].push_back(all_constraints[island_constraint_offset + constraint_index]);
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -240,7 +302,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -271,11 +333,22 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
+	// Solving may have woken up more bodies.
+	active_bodies.clear();
 	b = body_list->first();
 	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	body_chunk_count = (active_bodies.size() + BODY_INTEGRATION_CHUNK_SIZE - 1) / BODY_INTEGRATION_CHUNK_SIZE;
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities_chunk, nullptr, body_chunk_count, -1, true, SNAME("Physics2DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Moving shapes in the broadphase, queuing state queries and deactivating kinematic bodies
+	// aren't thread-safe, do them in list order.
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_velocities_finish();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -33,6 +33,7 @@
 
 #include "godot_space_2d.h"
 
+#include "core/math/disjoint_set.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep2D {
@@ -45,7 +46,22 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
-	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
+	LocalVector<GodotBody2D *> active_bodies;
+
+	// Islands are built from the bodies reached from the active ones, each constraint is
+	// attached to the node of the body it was found from and united with its other bodies.
+	LocalVector<GodotBody2D *> island_bodies;
+	LocalVector<uint32_t> island_constraint_nodes;
+	uint32_t island_constraint_offset = 0;
+	ConcurrentDisjointSet island_sets;
+	LocalVector<uint32_t> island_root_body_islands;
+	LocalVector<uint32_t> island_root_constraint_islands;
+
+	void _add_island_body(GodotBody2D *p_body);
+	void _gather_island_constraints(GodotBody2D *p_body);
+	void _unite_island_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _integrate_forces_chunk(uint32_t p_chunk_index, void *p_userdata = nullptr);
+	void _integrate_velocities_chunk(uint32_t p_chunk_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
@@ -41,7 +41,7 @@ void GodotBody3D::_mass_properties_changed() {
 }
 
 void GodotBody3D::_update_transform_dependent() {
-	center_of_mass = get_transform().basis.xform(center_of_mass_local);
+	states->center_of_mass[state_slot] = get_transform().basis.xform(center_of_mass_local);
 	principal_inertia_axes = get_transform().basis * principal_inertia_axes_local;
 
 	// Update inertia tensor.
@@ -49,7 +49,7 @@ void GodotBody3D::_update_transform_dependent() {
 	Basis tbt = tb.transposed();
 	Basis diag;
 	diag.scale(_inv_inertia);
-	_inv_inertia_tensor = tb * diag * tbt;
+	states->inv_inertia_tensor[state_slot] = tb * diag * tbt;
 }
 
 void GodotBody3D::update_mass_properties() {
@@ -143,20 +143,20 @@ void GodotBody3D::update_mass_properties() {
 			}
 
 			if (mass) {
-				_inv_mass = 1.0 / mass;
+				states->inv_mass[state_slot] = 1.0 / mass;
 			} else {
-				_inv_mass = 0;
+				states->inv_mass[state_slot] = 0;
 			}
 
 		} break;
 		case PhysicsServer3D::BODY_MODE_KINEMATIC:
 		case PhysicsServer3D::BODY_MODE_STATIC: {
 			_inv_inertia = Vector3();
-			_inv_mass = 0;
+			states->inv_mass[state_slot] = 0;
 		} break;
 		case PhysicsServer3D::BODY_MODE_RIGID_LINEAR: {
-			_inv_inertia_tensor.set_zero();
-			_inv_mass = 1.0 / mass;
+			states->inv_inertia_tensor[state_slot].set_zero();
+			states->inv_mass[state_slot] = 1.0 / mass;
 
 		} break;
 	}
@@ -303,12 +303,12 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 		case PhysicsServer3D::BODY_MODE_STATIC:
 		case PhysicsServer3D::BODY_MODE_KINEMATIC: {
 			_set_inv_transform(get_transform().affine_inverse());
-			_inv_mass = 0;
+			states->inv_mass[state_slot] = 0;
 			_inv_inertia = Vector3();
 			_set_static(p_mode == PhysicsServer3D::BODY_MODE_STATIC);
 			set_active(p_mode == PhysicsServer3D::BODY_MODE_KINEMATIC && contacts.size());
-			linear_velocity = Vector3();
-			angular_velocity = Vector3();
+			set_linear_velocity(Vector3());
+			set_angular_velocity(Vector3());
 			if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC && prev != mode) {
 				first_time_kinematic = true;
 			}
@@ -316,7 +316,7 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 
 		} break;
 		case PhysicsServer3D::BODY_MODE_RIGID: {
-			_inv_mass = mass > 0 ? (1.0 / mass) : 0;
+			states->inv_mass[state_slot] = mass > 0 ? (1.0 / mass) : 0;
 			if (!calculate_inertia) {
 				principal_inertia_axes_local = Basis();
 				_inv_inertia = inertia.inverse();
@@ -328,9 +328,9 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 
 		} break;
 		case PhysicsServer3D::BODY_MODE_RIGID_LINEAR: {
-			_inv_mass = mass > 0 ? (1.0 / mass) : 0;
+			states->inv_mass[state_slot] = mass > 0 ? (1.0 / mass) : 0;
 			_inv_inertia = Vector3();
-			angular_velocity = Vector3();
+			set_angular_velocity(Vector3());
 			_update_transform_dependent();
 			_set_static(false);
 			set_active(true);
@@ -380,13 +380,13 @@ void GodotBody3D::set_state(PhysicsServer3D::BodyState p_state, const Variant &p
 
 		} break;
 		case PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY: {
-			linear_velocity = p_variant;
-			constant_linear_velocity = linear_velocity;
+			set_linear_velocity(p_variant);
+			constant_linear_velocity = get_linear_velocity();
 			wakeup();
 		} break;
 		case PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY: {
-			angular_velocity = p_variant;
-			constant_angular_velocity = angular_velocity;
+			set_angular_velocity(p_variant);
+			constant_angular_velocity = get_angular_velocity();
 			wakeup();
 
 		} break;
@@ -396,9 +396,9 @@ void GodotBody3D::set_state(PhysicsServer3D::BodyState p_state, const Variant &p
 			}
 			bool do_sleep = p_variant;
 			if (do_sleep) {
-				linear_velocity = Vector3();
+				set_linear_velocity(Vector3());
 				//biased_linear_velocity=Vector3();
-				angular_velocity = Vector3();
+				set_angular_velocity(Vector3());
 				//biased_angular_velocity=Vector3();
 				set_active(false);
 			} else {
@@ -421,10 +421,10 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 			return get_transform();
 		} break;
 		case PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY: {
-			return linear_velocity;
+			return get_linear_velocity();
 		} break;
 		case PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY: {
-			return angular_velocity;
+			return get_angular_velocity();
 		} break;
 		case PhysicsServer3D::BODY_STATE_SLEEPING: {
 			return !is_active();
@@ -437,6 +437,40 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody3D::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.transform = get_transform();
+	r_snapshot.inv_transform = get_inv_transform();
+	r_snapshot.new_transform = new_transform;
+	r_snapshot.linear_velocity = get_linear_velocity();
+	r_snapshot.angular_velocity = get_angular_velocity();
+	r_snapshot.prev_linear_velocity = prev_linear_velocity;
+	r_snapshot.prev_angular_velocity = prev_angular_velocity;
+	r_snapshot.still_time = states->still_time[state_slot];
+	r_snapshot.active = active;
+	r_snapshot.first_time_kinematic = first_time_kinematic;
+}
+
+void GodotBody3D::restore_snapshot(const Snapshot &p_snapshot) {
+	if (get_transform() != p_snapshot.transform) {
+		_set_transform(p_snapshot.transform); // Moves the shapes in the broadphase.
+		_update_transform_dependent();
+	}
+	_set_inv_transform(p_snapshot.inv_transform);
+	new_transform = p_snapshot.new_transform;
+	set_linear_velocity(p_snapshot.linear_velocity);
+	set_angular_velocity(p_snapshot.angular_velocity);
+	prev_linear_velocity = p_snapshot.prev_linear_velocity;
+	prev_angular_velocity = p_snapshot.prev_angular_velocity;
+	states->still_time[state_slot] = p_snapshot.still_time;
+	first_time_kinematic = p_snapshot.first_time_kinematic;
+	set_active(p_snapshot.active);
+
+	// Let the nodes know, sleeping bodies included.
+	if ((fi_callback_data || body_state_callback.is_valid()) && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		if (mass_properties_update_list.in_list()) {
@@ -452,6 +486,12 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 
 	_set_space(p_space);
 
+	GodotBodyStates3D *new_states = get_space() ? &get_space()->get_body_states() : &own_states;
+	if (new_states != states) {
+		state_slot = new_states->move_from(*states, state_slot);
+		states = new_states;
+	}
+
 	if (get_space()) {
 		_mass_properties_changed();
 		if (active) {
@@ -473,12 +513,25 @@ bool GodotBody3D::is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const {
 }
 
 void GodotBody3D::integrate_forces(real_t p_step) {
+	integrate_forces_local(p_step);
+	integrate_forces_finish();
+}
+
+void GodotBody3D::integrate_velocities(real_t p_step) {
+	integrate_velocities_local(p_step);
+	integrate_velocities_finish();
+}
+
+void GodotBody3D::integrate_forces_local(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
 
 	ERR_FAIL_NULL(get_space());
 
+	Vector3 &linear_velocity = states->linear_velocity[state_slot];
+	Vector3 &angular_velocity = states->angular_velocity[state_slot];
+
 	int ac = areas.size();
 
 	bool gravity_done = false;
@@ -646,8 +699,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 			linear_velocity *= damp;
 			angular_velocity *= angular_damp_new;
 
-			linear_velocity += _inv_mass * force * p_step;
-			angular_velocity += _inv_inertia_tensor.xform(torque) * p_step;
+			linear_velocity += states->inv_mass[state_slot] * force * p_step;
+			angular_velocity += states->inv_inertia_tensor[state_slot].xform(torque) * p_step;
 		}
 
 		if (continuous_cd) {
@@ -659,24 +712,32 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	applied_force = Vector3();
 	applied_torque = Vector3();
 
-	biased_angular_velocity = Vector3();
-	biased_linear_velocity = Vector3();
+	states->biased_angular_velocity[state_slot] = Vector3();
+	states->biased_linear_velocity[state_slot] = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	//shapes temporarily extend for raycast
+	pending_motion = motion;
+	pending_motion_update = do_motion;
 
 	contact_count = 0;
 }
 
-void GodotBody3D::integrate_velocities(real_t p_step) {
+void GodotBody3D::integrate_forces_finish() {
+	if (pending_motion_update) {
+		_update_shapes_with_motion(pending_motion);
+		pending_motion_update = false;
+	}
+}
+
+void GodotBody3D::integrate_velocities_local(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
+	Vector3 &linear_velocity = states->linear_velocity[state_slot];
+	Vector3 &angular_velocity = states->angular_velocity[state_slot];
+	Vector3 &biased_linear_velocity = states->biased_linear_velocity[state_slot];
+	Vector3 &biased_angular_velocity = states->biased_angular_velocity[state_slot];
 
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
@@ -697,9 +758,8 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
-		}
+		//stopped moving, deactivate
+		pending_deactivation = contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3();
 
 		return;
 	}
@@ -727,12 +787,33 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	pending_shapes_update = true;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::integrate_velocities_finish() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (pending_shapes_update) {
+		_update_shapes();
+		pending_shapes_update = false;
+	}
+
+	if (pending_deactivation) {
+		set_active(false);
+		pending_deactivation = false;
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -776,23 +857,6 @@ void GodotBody3D::call_queries() {
 	}
 }
 
-bool GodotBody3D::sleep_test(real_t p_step) {
-	if (mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
-		return true;
-	} else if (!can_sleep) {
-		return false;
-	}
-
-	if (Math::abs(angular_velocity.length()) < get_space()->get_body_angular_velocity_sleep_threshold() && Math::abs(linear_velocity.length_squared()) < get_space()->get_body_linear_velocity_sleep_threshold() * get_space()->get_body_linear_velocity_sleep_threshold()) {
-		still_time += p_step;
-
-		return still_time > get_space()->get_body_time_to_sleep();
-	} else {
-		still_time = 0; //maybe this should be set to 0 on set_active?
-		return false;
-	}
-}
-
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -823,6 +887,8 @@ GodotBody3D::GodotBody3D() :
 		active_list(this),
 		mass_properties_update_list(this),
 		direct_state_query_list(this) {
+	states = &own_states;
+	state_slot = own_states.allocate();
 	_set_static(false);
 }
 
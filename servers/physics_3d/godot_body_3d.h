@@ -32,6 +32,7 @@
 #define GODOT_BODY_3D_H
 
 #include "godot_area_3d.h"
+#include "godot_body_states_3d.h"
 #include "godot_collision_object_3d.h"
 
 #include "core/templates/vset.h"
@@ -40,10 +41,35 @@ class GodotConstraint3D;
 class GodotPhysicsDirectBodyState3D;
 
 class GodotBody3D : public GodotCollisionObject3D {
+	// Velocities, inverse mass and inertia, center of mass and sleep time are kept in the arrays
+	// of the space, at the slot of this body. Out of a space, the body keeps them in its own arrays.
+	GodotBodyStates3D *states = nullptr;
+	uint32_t state_slot = 0;
+	GodotBodyStates3D own_states;
+
+	// State read by the solver and by the integration is declared first so that it's close
+	// together in memory. Colder state follows.
 	PhysicsServer3D::BodyMode mode = PhysicsServer3D::BODY_MODE_RIGID;
 
-	Vector3 linear_velocity;
-	Vector3 angular_velocity;
+	Vector3 gravity;
+
+	real_t total_linear_damp = 0.0;
+	real_t total_angular_damp = 0.0;
+
+	Vector3 applied_force;
+	Vector3 applied_torque;
+
+	Vector3 constant_force;
+	Vector3 constant_torque;
+
+	uint16_t locked_axis = 0;
+
+	Vector3 _inv_inertia; // Relative to the principal axes of inertia
+	Basis principal_inertia_axes;
+
+	// Relative to the local frame of reference
+	Basis principal_inertia_axes_local;
+	Vector3 center_of_mass_local;
 
 	Vector3 prev_linear_velocity;
 	Vector3 prev_angular_velocity;
@@ -51,8 +77,6 @@ class GodotBody3D : public GodotCollisionObject3D {
 	Vector3 constant_linear_velocity;
 	Vector3 constant_angular_velocity;
 
-	Vector3 biased_linear_velocity;
-	Vector3 biased_angular_velocity;
 	real_t mass = 1.0;
 	real_t bounce = 0.0;
 	real_t friction = 1.0;
@@ -64,38 +88,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	real_t linear_damp = 0.0;
 	real_t angular_damp = 0.0;
 
-	real_t total_linear_damp = 0.0;
-	real_t total_angular_damp = 0.0;
-
 	real_t gravity_scale = 1.0;
 
-	uint16_t locked_axis = 0;
-
-	real_t _inv_mass = 1.0;
-	Vector3 _inv_inertia; // Relative to the principal axes of inertia
-
-	// Relative to the local frame of reference
-	Basis principal_inertia_axes_local;
-	Vector3 center_of_mass_local;
-
-	// In world orientation with local origin
-	Basis _inv_inertia_tensor;
-	Basis principal_inertia_axes;
-	Vector3 center_of_mass;
-
 	bool calculate_inertia = true;
 	bool calculate_center_of_mass = true;
 
-	Vector3 gravity;
-
-	real_t still_time = 0.0;
-
-	Vector3 applied_force;
-	Vector3 applied_torque;
-
-	Vector3 constant_force;
-	Vector3 constant_torque;
-
 	SelfList<GodotBody3D> active_list;
 	SelfList<GodotBody3D> mass_properties_update_list;
 	SelfList<GodotBody3D> direct_state_query_list;
@@ -145,6 +142,13 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_node = 0;
+
+	// Left by the thread-safe half of the integration for the half that updates the space.
+	Vector3 pending_motion;
+	bool pending_motion_update = false;
+	bool pending_shapes_update = false;
+	bool pending_deactivation = false;
 
 	void _update_transform_dependent();
 
@@ -195,6 +199,9 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ uint32_t get_island_node() const { return island_node; }
+	_FORCE_INLINE_ void set_island_node(uint32_t p_node) { island_node = p_node; }
+
 	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
@@ -204,48 +211,50 @@ public:
 	_FORCE_INLINE_ bool get_omit_force_integration() const { return omit_force_integration; }
 
 	_FORCE_INLINE_ Basis get_principal_inertia_axes() const { return principal_inertia_axes; }
-	_FORCE_INLINE_ Vector3 get_center_of_mass() const { return center_of_mass; }
+	_FORCE_INLINE_ Vector3 get_center_of_mass() const { return states->center_of_mass[state_slot]; }
 	_FORCE_INLINE_ Vector3 get_center_of_mass_local() const { return center_of_mass_local; }
 	_FORCE_INLINE_ Vector3 xform_local_to_principal(const Vector3 &p_pos) const { return principal_inertia_axes_local.xform(p_pos - center_of_mass_local); }
 
-	_FORCE_INLINE_ void set_linear_velocity(const Vector3 &p_velocity) { linear_velocity = p_velocity; }
-	_FORCE_INLINE_ Vector3 get_linear_velocity() const { return linear_velocity; }
+	_FORCE_INLINE_ uint32_t get_state_slot() const { return state_slot; }
+
+	_FORCE_INLINE_ void set_linear_velocity(const Vector3 &p_velocity) { states->linear_velocity[state_slot] = p_velocity; }
+	_FORCE_INLINE_ Vector3 get_linear_velocity() const { return states->linear_velocity[state_slot]; }
 
-	_FORCE_INLINE_ void set_angular_velocity(const Vector3 &p_velocity) { angular_velocity = p_velocity; }
-	_FORCE_INLINE_ Vector3 get_angular_velocity() const { return angular_velocity; }
+	_FORCE_INLINE_ void set_angular_velocity(const Vector3 &p_velocity) { states->angular_velocity[state_slot] = p_velocity; }
+	_FORCE_INLINE_ Vector3 get_angular_velocity() const { return states->angular_velocity[state_slot]; }
 
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
-	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
-	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
+	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return states->biased_linear_velocity[state_slot]; }
+	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return states->biased_angular_velocity[state_slot]; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
-		linear_velocity += p_impulse * _inv_mass;
+		states->linear_velocity[state_slot] += p_impulse * states->inv_mass[state_slot];
 	}
 
 	_FORCE_INLINE_ void apply_impulse(const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) {
-		linear_velocity += p_impulse * _inv_mass;
-		angular_velocity += _inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse));
+		states->linear_velocity[state_slot] += p_impulse * states->inv_mass[state_slot];
+		states->angular_velocity[state_slot] += states->inv_inertia_tensor[state_slot].xform((p_position - states->center_of_mass[state_slot]).cross(p_impulse));
 	}
 
 	_FORCE_INLINE_ void apply_torque_impulse(const Vector3 &p_impulse) {
-		angular_velocity += _inv_inertia_tensor.xform(p_impulse);
+		states->angular_velocity[state_slot] += states->inv_inertia_tensor[state_slot].xform(p_impulse);
 	}
 
 	_FORCE_INLINE_ void apply_bias_impulse(const Vector3 &p_impulse, const Vector3 &p_position = Vector3(), real_t p_max_delta_av = -1.0) {
-		biased_linear_velocity += p_impulse * _inv_mass;
+		states->biased_linear_velocity[state_slot] += p_impulse * states->inv_mass[state_slot];
 		if (p_max_delta_av != 0.0) {
-			Vector3 delta_av = _inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse));
+			Vector3 delta_av = states->inv_inertia_tensor[state_slot].xform((p_position - states->center_of_mass[state_slot]).cross(p_impulse));
 			if (p_max_delta_av > 0 && delta_av.length() > p_max_delta_av) {
 				delta_av = delta_av.normalized() * p_max_delta_av;
 			}
-			biased_angular_velocity += delta_av;
+			states->biased_angular_velocity[state_slot] += delta_av;
 		}
 	}
 
 	_FORCE_INLINE_ void apply_bias_torque_impulse(const Vector3 &p_impulse) {
-		biased_angular_velocity += _inv_inertia_tensor.xform(p_impulse);
+		states->biased_angular_velocity[state_slot] += states->inv_inertia_tensor[state_slot].xform(p_impulse);
 	}
 
 	_FORCE_INLINE_ void apply_central_force(const Vector3 &p_force) {
@@ -254,7 +263,7 @@ public:
 
 	_FORCE_INLINE_ void apply_force(const Vector3 &p_force, const Vector3 &p_position = Vector3()) {
 		applied_force += p_force;
-		applied_torque += (p_position - center_of_mass).cross(p_force);
+		applied_torque += (p_position - states->center_of_mass[state_slot]).cross(p_force);
 	}
 
 	_FORCE_INLINE_ void apply_torque(const Vector3 &p_torque) {
@@ -267,7 +276,7 @@ public:
 
 	_FORCE_INLINE_ void add_constant_force(const Vector3 &p_force, const Vector3 &p_position = Vector3()) {
 		constant_force += p_force;
-		constant_torque += (p_position - center_of_mass).cross(p_force);
+		constant_torque += (p_position - states->center_of_mass[state_slot]).cross(p_force);
 	}
 
 	_FORCE_INLINE_ void add_constant_torque(const Vector3 &p_torque) {
@@ -299,6 +308,23 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
+	// State changed by stepping, kept in space snapshots. Parameters are left to whoever set them.
+	struct Snapshot {
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		real_t still_time = 0.0;
+		bool active = false;
+		bool first_time_kinematic = false;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
@@ -307,9 +333,9 @@ public:
 	void update_mass_properties();
 	void reset_mass_properties();
 
-	_FORCE_INLINE_ real_t get_inv_mass() const { return _inv_mass; }
+	_FORCE_INLINE_ real_t get_inv_mass() const { return states->inv_mass[state_slot]; }
 	_FORCE_INLINE_ const Vector3 &get_inv_inertia() const { return _inv_inertia; }
-	_FORCE_INLINE_ const Basis &get_inv_inertia_tensor() const { return _inv_inertia_tensor; }
+	_FORCE_INLINE_ const Basis &get_inv_inertia_tensor() const { return states->inv_inertia_tensor[state_slot]; }
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
@@ -319,29 +345,36 @@ public:
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
 
+	// Both integrations split in a first half that only touches this body, so it can run for several
+	// bodies in parallel, and a second half that updates the space and must run on a single thread.
+	void integrate_forces_local(real_t p_step);
+	void integrate_forces_finish();
+	void integrate_velocities_local(real_t p_step);
+	void integrate_velocities_finish();
+
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
-		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
+		return states->linear_velocity[state_slot] + states->angular_velocity[state_slot].cross(rel_pos - states->center_of_mass[state_slot]);
 	}
 
 	_FORCE_INLINE_ real_t compute_impulse_denominator(const Vector3 &p_pos, const Vector3 &p_normal) const {
-		Vector3 r0 = p_pos - get_transform().origin - center_of_mass;
+		Vector3 r0 = p_pos - get_transform().origin - states->center_of_mass[state_slot];
 
 		Vector3 c0 = (r0).cross(p_normal);
 
-		Vector3 vec = (_inv_inertia_tensor.xform_inv(c0)).cross(r0);
+		Vector3 vec = (states->inv_inertia_tensor[state_slot].xform_inv(c0)).cross(r0);
 
-		return _inv_mass + p_normal.dot(vec);
+		return states->inv_mass[state_slot] + p_normal.dot(vec);
 	}
 
 	_FORCE_INLINE_ real_t compute_angular_impulse_denominator(const Vector3 &p_axis) const {
-		return p_axis.dot(_inv_inertia_tensor.xform_inv(p_axis));
+		return p_axis.dot(states->inv_inertia_tensor[state_slot].xform_inv(p_axis));
 	}
 
 	//void simulate_motion(const Transform3D& p_xform,real_t p_step);
 	void call_queries();
 	void wakeup_neighbours();
 
-	bool sleep_test(real_t p_step);
+	_FORCE_INLINE_ bool is_sleep_allowed() const { return can_sleep; }
 
 	GodotBody3D();
 	~GodotBody3D();
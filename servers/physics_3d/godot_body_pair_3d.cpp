@@ -38,6 +38,15 @@
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
 
+// Measure of the area spanned by four contact points: the largest cross product of two
+// diagonals out of the three ways of pairing them, squared.
+static real_t _contact_area(const Vector3 &p_point_0, const Vector3 &p_point_1, const Vector3 &p_point_2, const Vector3 &p_point_3) {
+	real_t area_0 = (p_point_0 - p_point_1).cross(p_point_2 - p_point_3).length_squared();
+	real_t area_1 = (p_point_0 - p_point_2).cross(p_point_1 - p_point_3).length_squared();
+	real_t area_2 = (p_point_0 - p_point_3).cross(p_point_1 - p_point_2).length_squared();
+	return MAX(area_0, MAX(area_1, area_2));
+}
+
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
@@ -69,7 +78,8 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 			contact.acc_normal_impulse = c.acc_normal_impulse;
 			contact.acc_bias_impulse = c.acc_bias_impulse;
 			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
+			// The normal may have turned a bit, only warm start with the friction along the new contact plane.
+			contact.acc_tangent_impulse = c.acc_tangent_impulse - contact.normal * contact.normal.dot(c.acc_tangent_impulse);
 			c = contact;
 			return;
 		}
@@ -77,40 +87,56 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
-		// Remove the contact with the minimum depth.
+		// Keep the deepest contact, and among the others the ones spanning the largest area.
+		// This keeps resting contacts stable, e.g. for a box lying on many triangles of a concave shape.
 
 		const Basis &basis_A = A->get_transform().basis;
 		const Basis &basis_B = B->get_transform().basis;
 
-		int least_deep = -1;
-		real_t min_depth;
+		Vector3 points[MAX_CONTACTS + 1];
+		real_t depths[MAX_CONTACTS + 1];
+		int deepest = 0;
 
-		// Start with depth for new contact.
-		{
-			Vector3 global_A = basis_A.xform(contact.local_A);
-			Vector3 global_B = basis_B.xform(contact.local_B) + offset_B;
+		for (int i = 0; i <= MAX_CONTACTS; i++) {
+			// The last one is the new contact.
+			const Contact &c = (i < MAX_CONTACTS) ? contacts[i] : contact;
+			Vector3 global_A = basis_A.xform(c.local_A);
+			Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
 
-			Vector3 axis = global_A - global_B;
-			min_depth = axis.dot(contact.normal);
+			points[i] = global_A;
+			depths[i] = (global_A - global_B).dot(c.normal);
+			if (depths[i] > depths[deepest]) {
+				deepest = i;
+			}
 		}
 
-		for (int i = 0; i < contact_count; i++) {
-			const Contact &c = contacts[i];
-			Vector3 global_A = basis_A.xform(c.local_A);
-			Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
+		int removed = -1;
+		real_t max_area = -1.0;
 
-			Vector3 axis = global_A - global_B;
-			real_t depth = axis.dot(c.normal);
+		for (int i = 0; i <= MAX_CONTACTS; i++) {
+			if (i == deepest) {
+				continue;
+			}
 
-			if (depth < min_depth) {
-				min_depth = depth;
-				least_deep = i;
+			Vector3 kept[MAX_CONTACTS];
+			int kept_count = 0;
+			for (int j = 0; j <= MAX_CONTACTS; j++) {
+				if (j != i) {
+					kept[kept_count++] = points[j];
+				}
+			}
+
+			real_t area = _contact_area(kept[0], kept[1], kept[2], kept[3]);
+			// On ties, drop the least deep contact.
+			if (area > max_area || (area == max_area && depths[i] < depths[removed])) {
+				max_area = area;
+				removed = i;
 			}
 		}
 
-		if (least_deep > -1) {
-			// Replace the least deep contact by the new one.
-			contacts[least_deep] = contact;
+		if (removed < MAX_CONTACTS) {
+			// Replace the removed contact by the new one.
+			contacts[removed] = contact;
 		}
 
 		return;
@@ -161,15 +187,23 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+#define CCD_MAX_ITERATIONS 32
+
 // _test_ccd prevents tunneling by slowing down a high velocity body that is about to collide so that next frame it will be at an appropriate location to collide (i.e. slight overlap)
 // Warning: the way velocity is adjusted down to cause a collision means the momentum will be weaker than it should for a bounce!
 // Process: only proceed if body A's motion is high relative to its size.
-// cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
+// Find the time of impact with conservative advancement: A is moved along its motion relative to B by steps that can't skip past B,
+// bounded by the distance between the shapes and how fast A's farthest point can close it, until the shapes touch or the step ends.
 // adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
 bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
 	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
+	GodotShape3D *shape_B_ptr = p_B->get_shape(p_shape_B);
+	if (shape_A_ptr->is_concave()) {
+		return false; // Distance queries need a convex shape on one side.
+	}
 
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
+	// Work in B's frame of reference, B is only predicted to move linearly.
+	Vector3 motion = (p_A->get_linear_velocity() - p_B->get_linear_velocity()) * p_step;
 	real_t mlen = motion.length();
 	if (mlen < CMP_EPSILON) {
 		return false;
@@ -180,76 +214,140 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	real_t min = 0.0, max = 0.0;
 	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
 
-	// Did it move enough in this direction to even attempt raycast?
+	// Did it move enough in this direction to even attempt the sweep?
 	// Let's say it should move more than 1/3 the size of the object in that axis.
 	bool fast_object = mlen > (max - min) * 0.3;
 	if (!fast_object) {
 		return false; // moving slow enough that there's no chance of tunneling.
 	}
 
-	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
-
-	// Roughly predict body B's position in the next frame (ignoring collisions).
-	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
-
-	// Support points are the farthest forward points on A in the direction of the motion vector.
-	// i.e. the candidate points of which one should hit B first if any collision does occur.
-	static const int max_supports = 16;
-	Vector3 supports_A[max_supports];
-	int support_count_A;
-	GodotShape3D::FeatureType support_type_A;
-	// Convert mnormal into body A's local xform because get_supports requires (and returns) local coordinates.
-	shape_A_ptr->get_supports(p_xform_A.basis.xform_inv(mnormal).normalized(), max_supports, supports_A, support_count_A, support_type_A);
-
-	// Cast a segment from each support point of A in the motion direction.
-	int segment_support_idx = -1;
-	float segment_hit_length = FLT_MAX;
-	Vector3 segment_hit_local;
-	for (int i = 0; i < support_count_A; i++) {
-		supports_A[i] = p_xform_A.xform(supports_A[i]);
-
-		Vector3 from = supports_A[i];
-		Vector3 to = from + motion;
-
-		Transform3D from_inv = predicted_xform_B.affine_inverse();
-
-		// Back up 10% of the per-frame motion behind the support point and use that as the beginning of our cast.
-		// At high speeds, this may mean we're actually casting from well behind the body instead of inside it, which is odd.
-		// But it still works out.
-		Vector3 local_from = from_inv.xform(from - motion * 0.1);
-		Vector3 local_to = from_inv.xform(to);
-
-		Vector3 rpos, rnorm;
-		int fi = -1;
-		if (p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, fi, true)) {
-			float hit_length = local_from.distance_to(rpos);
-			if (hit_length < segment_hit_length) {
-				segment_support_idx = i;
-				segment_hit_length = hit_length;
-				segment_hit_local = rpos;
-			}
+	// The transforms are relative to the origin of either body, A turns around its own center of mass,
+	// so its rotation moves its points by at most this radius times the angle.
+	const Vector3 pivot = p_xform_A.xform(p_A->get_shape_transform(p_shape_A).affine_inverse().origin) + p_A->get_center_of_mass();
+	const AABB aabb_A = p_xform_A.xform(shape_A_ptr->get_aabb());
+	const real_t radius_A = (aabb_A.get_center() - pivot).length() + aabb_A.size.length() * 0.5;
+	const Vector3 angular_velocity = p_A->get_angular_velocity();
+	const real_t angle = angular_velocity.length() * p_step;
+	const Vector3 rotation_axis = angle > CMP_EPSILON ? angular_velocity.normalized() : Vector3();
+	const real_t rotation_bound = angle > CMP_EPSILON ? radius_A * angle : 0.0;
+
+	// Covers the whole sweep, for concave shapes to only test the faces along the way.
+	AABB concave_hint = aabb_A.merge(AABB(aabb_A.position + motion, aabb_A.size)).grow(rotation_bound);
+
+	const real_t tolerance = MAX(space->get_contact_max_allowed_penetration(), (real_t)CMP_EPSILON);
+
+	real_t t = 0.0;
+	real_t distance = 0.0;
+	bool hit = false;
+	for (int i = 0; i < CCD_MAX_ITERATIONS; i++) {
+		Transform3D xform_A = p_xform_A;
+		if (rotation_bound > 0.0) {
+			Basis rotation(rotation_axis, angle * t);
+			xform_A.basis = rotation * xform_A.basis;
+			xform_A.origin = pivot + rotation.xform(xform_A.origin - pivot);
+		}
+		xform_A.origin += motion * t;
+
+		Vector3 point_A, point_B;
+		bool measured = true;
+		if (!GodotCollisionSolver3D::solve_distance(shape_A_ptr, xform_A, shape_B_ptr, p_xform_B, point_A, point_B, concave_hint, nullptr, &measured)) {
+			// Already touching, possible at the start when within the margins of the discrete test.
+			distance = 0.0;
+			hit = true;
+			break;
+		}
+
+		if (!measured) {
+			break; // No faces of the concave shape along the whole sweep.
+		}
+
+		Vector3 gap = point_B - point_A;
+		distance = gap.length();
+		if (distance < tolerance) {
+			hit = true;
+			break;
+		}
+
+		// The fastest A can get closer to B along the gap, per unit of t.
+		real_t closing_bound = motion.dot(gap / distance) + rotation_bound;
+		if (closing_bound <= CMP_EPSILON) {
+			break; // Moving apart.
+		}
+
+		t += (distance - tolerance * 0.5) / closing_bound;
+		if (t > 1.0) {
+			break; // No contact within this step, we'll probably check again next frame once they're closer.
 		}
 	}
 
-	if (segment_support_idx == -1) {
-		// There was no hit. Since the segment is the length of per-frame motion, this means the bodies will not
-		// actually collide yet on next frame. We'll probably check again next frame once they're closer.
+	if (!hit) {
 		return false;
 	}
 
-	Vector3 hitpos = predicted_xform_B.xform(segment_hit_local);
-
-	real_t newlen = hitpos.distance_to(supports_A[segment_support_idx]);
-	// Adding 1% of body length to the distance between collision and support point
-	// should cause body A's support point to arrive just within B's collider next frame.
-	newlen += (max - min) * 0.01;
-	// FIXME: This doesn't always work well when colliding with a triangle face of a trimesh shape.
+	// Adding 1% of body length to the distance to the time of impact
+	// should cause body A to arrive just within B's collider next frame.
+	real_t newlen = mlen * t + distance + (max - min) * 0.01;
+	if (newlen >= mlen) {
+		return false;
+	}
 
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	p_A->set_linear_velocity(p_B->get_linear_velocity() + (mnormal * newlen) / p_step);
 
 	return true;
 }
 
+// Contacts are plain data, kept as is along with the separating axis used as a hint for the next test.
+uint32_t GodotBodyPair3D::get_snapshot_size() const {
+	return sizeof(Vector3) + sizeof(int) + sizeof(Contact) * MAX_CONTACTS;
+}
+
+void GodotBodyPair3D::save_snapshot(uint8_t *r_snapshot) const {
+	memcpy(r_snapshot, &sep_axis, sizeof(Vector3));
+	r_snapshot += sizeof(Vector3);
+	memcpy(r_snapshot, &contact_count, sizeof(int));
+	r_snapshot += sizeof(int);
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		// Copied field by field into zeroed storage, so that padding bytes don't end up in the snapshot.
+		const Contact &from = contacts[i];
+		Contact contact;
+		memset((void *)&contact, 0, sizeof(Contact));
+		contact.position = from.position;
+		contact.normal = from.normal;
+		contact.index_A = from.index_A;
+		contact.index_B = from.index_B;
+		contact.local_A = from.local_A;
+		contact.local_B = from.local_B;
+		contact.acc_impulse = from.acc_impulse;
+		contact.acc_normal_impulse = from.acc_normal_impulse;
+		contact.acc_tangent_impulse = from.acc_tangent_impulse;
+		contact.acc_bias_impulse = from.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = from.acc_bias_impulse_center_of_mass;
+		contact.mass_normal = from.mass_normal;
+		contact.bias = from.bias;
+		contact.bounce = from.bounce;
+		contact.depth = from.depth;
+		contact.active = from.active;
+		contact.used = from.used;
+		contact.rA = from.rA;
+		contact.rB = from.rB;
+		memcpy(r_snapshot, &contact, sizeof(Contact));
+		r_snapshot += sizeof(Contact);
+	}
+}
+
+void GodotBodyPair3D::restore_snapshot(const uint8_t *p_snapshot) {
+	memcpy(&sep_axis, p_snapshot, sizeof(Vector3));
+	p_snapshot += sizeof(Vector3);
+	memcpy(&contact_count, p_snapshot, sizeof(int));
+	p_snapshot += sizeof(int);
+	memcpy(contacts, p_snapshot, sizeof(Contact) * MAX_CONTACTS);
+}
+
+void GodotBodyPair3D::reset_snapshot() {
+	sep_axis = Vector3();
+	contact_count = 0;
+}
+
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -109,6 +109,13 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual uint64_t get_order_subindex() const override { return (uint64_t(shape_A) << 32) | uint32_t(shape_B); }
+
+	virtual uint32_t get_snapshot_size() const override;
+	virtual void save_snapshot(uint8_t *r_snapshot) const override;
+	virtual void restore_snapshot(const uint8_t *p_snapshot) override;
+	virtual void reset_snapshot() override;
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
@@ -140,6 +147,8 @@ public:
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const override { return soft_body; }
 	virtual int get_soft_body_count() const override { return 1; }
 
+	virtual uint64_t get_order_subindex() const override { return body_shape; }
+
 	GodotBodySoftBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotSoftBody3D *p_B);
 	~GodotBodySoftBodyPair3D();
 };
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  godot_body_states_3d.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_BODY_STATES_3D_H
+#define GODOT_BODY_STATES_3D_H
+
+#include "core/math/basis.h"
+#include "core/math/vector3.h"
+#include "core/templates/local_vector.h"
+
+// State of the bodies of a space that integration, solving and sleep tests go through for every body,
+// stored as one array per member and indexed by the slot each body gets when it enters the space.
+class GodotBodyStates3D {
+	LocalVector<uint32_t> free_slots;
+
+public:
+	LocalVector<Vector3> linear_velocity;
+	LocalVector<Vector3> angular_velocity;
+	LocalVector<Vector3> biased_linear_velocity;
+	LocalVector<Vector3> biased_angular_velocity;
+	LocalVector<real_t> inv_mass;
+	LocalVector<Basis> inv_inertia_tensor; // In world orientation with local origin.
+	LocalVector<Vector3> center_of_mass;
+	LocalVector<real_t> still_time;
+
+	uint32_t allocate() {
+		if (!free_slots.is_empty()) {
+			const uint32_t slot = free_slots[free_slots.size() - 1];
+			free_slots.remove_at(free_slots.size() - 1);
+			linear_velocity[slot] = Vector3();
+			angular_velocity[slot] = Vector3();
+			biased_linear_velocity[slot] = Vector3();
+			biased_angular_velocity[slot] = Vector3();
+			inv_mass[slot] = 1.0;
+			inv_inertia_tensor[slot] = Basis();
+			center_of_mass[slot] = Vector3();
+			still_time[slot] = 0.0;
+			return slot;
+		}
+
+		linear_velocity.push_back(Vector3());
+		angular_velocity.push_back(Vector3());
+		biased_linear_velocity.push_back(Vector3());
+		biased_angular_velocity.push_back(Vector3());
+		inv_mass.push_back(1.0);
+		inv_inertia_tensor.push_back(Basis());
+		center_of_mass.push_back(Vector3());
+		still_time.push_back(0.0);
+		return linear_velocity.size() - 1;
+	}
+
+	void free(uint32_t p_slot) {
+		free_slots.push_back(p_slot);
+		if (free_slots.size() == linear_velocity.size()) {
+			reset(); // Release the arrays once the last body is gone.
+		}
+	}
+
+	// Moves the state in a slot of another storage to a new slot of this one.
+	uint32_t move_from(GodotBodyStates3D &r_from, uint32_t p_from_slot) {
+		const uint32_t slot = allocate();
+		linear_velocity[slot] = r_from.linear_velocity[p_from_slot];
+		angular_velocity[slot] = r_from.angular_velocity[p_from_slot];
+		biased_linear_velocity[slot] = r_from.biased_linear_velocity[p_from_slot];
+		biased_angular_velocity[slot] = r_from.biased_angular_velocity[p_from_slot];
+		inv_mass[slot] = r_from.inv_mass[p_from_slot];
+		inv_inertia_tensor[slot] = r_from.inv_inertia_tensor[p_from_slot];
+		center_of_mass[slot] = r_from.center_of_mass[p_from_slot];
+		still_time[slot] = r_from.still_time[p_from_slot];
+		r_from.free(p_from_slot);
+		return slot;
+	}
+
+	void reset() {
+		free_slots.reset();
+		linear_velocity.reset();
+		angular_velocity.reset();
+		biased_linear_velocity.reset();
+		biased_angular_velocity.reset();
+		inv_mass.reset();
+		inv_inertia_tensor.reset();
+		center_of_mass.reset();
+		still_time.reset();
+	}
+};
+
+#endif // GODOT_BODY_STATES_3D_H
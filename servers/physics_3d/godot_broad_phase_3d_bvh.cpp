@@ -125,4 +125,6 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	// Below this many moved items per step, dispatching the pairing to other threads costs more than it saves.
+	bvh.params_set_pairing_thread_threshold(256);
 }
@@ -516,7 +516,7 @@ bool GodotCollisionSolver3D::solve_distance_world_boundary(const GodotShape3D *p
 	return collided;
 }
 
-bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis) {
+bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis, bool *r_measured) {
 	if (p_shape_B->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
 		Vector3 a, b;
 		bool col = solve_distance_world_boundary(p_shape_B, p_transform_B, p_shape_A, p_transform_A, a, b);
@@ -580,6 +580,10 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		if (!cinfo.collided) {
 			r_point_A = cinfo.close_A;
 			r_point_B = cinfo.close_B;
+			if (r_measured) {
+				// Without any face in range, the points don't tell the distance.
+				*r_measured = cinfo.tested;
+			}
 		}
 
 		return !cinfo.collided;
@@ -65,6 +65,15 @@ public:
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const { return nullptr; }
 	virtual int get_soft_body_count() const { return 0; }
 
+	// Tells apart constraints between the same bodies, such as contacts between different shapes.
+	virtual uint64_t get_order_subindex() const { return 0; }
+
+	// State carried over from one step to the next, such as contact caches, kept in space snapshots.
+	virtual uint32_t get_snapshot_size() const { return 0; }
+	virtual void save_snapshot(uint8_t *r_snapshot) const {}
+	virtual void restore_snapshot(const uint8_t *p_snapshot) {}
+	virtual void reset_snapshot() {}
+
 	_FORCE_INLINE_ void set_priority(int p_priority) { priority = p_priority; }
 	_FORCE_INLINE_ int get_priority() const { return priority; }
 
@@ -214,6 +214,18 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+void GodotPhysicsServer3D::space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	space->save_snapshot(r_snapshot);
+}
+
+bool GodotPhysicsServer3D::space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->restore_snapshot(p_snapshot);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
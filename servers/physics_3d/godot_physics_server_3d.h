@@ -117,6 +117,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual void space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) override;
+	virtual bool space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
@@ -378,6 +381,11 @@ public:
 
 	int get_process_info(ProcessInfo p_info) override;
 
+	// Splits each stage of a step into that many tasks, 1 steps the same as a single thread would.
+	void set_step_task_count(int p_task_count) { stepper->set_task_count(p_task_count); }
+
+	GodotSpace3D *get_space(RID p_space) const { return space_owner.get_or_null(p_space); }
+
 	GodotPhysicsServer3D(bool p_using_threads = false);
 	~GodotPhysicsServer3D() {}
 };
@@ -1345,44 +1345,6 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
-	}
-}
-
 bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
 	if (faces.size() == 0) {
 		return false;
@@ -1391,33 +1353,60 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
 
-	_SegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
+	const Vector3 dir = (p_end - p_begin).normalized();
 
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
+	real_t min_d = 1e20;
+	int collisions = 0;
 
-	params.face = &face;
+	int32_t *stack = (int32_t *)alloca(sizeof(int32_t) * _get_bvh_stack_size());
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-	// cull
-	_cull_segment(0, &params);
+	while (stack_size > 0) {
+		const BVH &node = bvh[stack[--stack_size]];
 
-	if (params.collisions > 0) {
-		r_result = params.result;
-		r_normal = params.normal;
-		r_face_index = params.face_index;
-		return true;
-	} else {
-		return false;
+		for (int i = 0; i < 4; i++) {
+			const int32_t child = node.children[i];
+			if (child == BVH_EMPTY) {
+				continue;
+			}
+
+			if (!_dequantize_child_aabb(node, i).intersects_segment(p_begin, p_end)) {
+				continue;
+			}
+
+			if (child >= 0) {
+				stack[stack_size++] = child;
+				continue;
+			}
+
+			int face_index = -1 - child;
+			const Face *f = &fr[face_index];
+			face.normal = f->normal;
+			face.vertex[0] = vr[f->indices[0]];
+			face.vertex[1] = vr[f->indices[1]];
+			face.vertex[2] = vr[f->indices[2]];
+
+			Vector3 res;
+			Vector3 normal;
+			if (face.intersect_segment(p_begin, p_end, res, normal, face_index, true)) {
+				real_t d = dir.dot(res) - dir.dot(p_begin);
+				if ((d > 0) && (d < min_d)) {
+					min_d = d;
+					r_result = res;
+					r_normal = normal;
+					r_face_index = face_index;
+					collisions++;
+				}
+			}
+		}
 	}
+
+	return collisions > 0;
 }
 
 bool GodotConcavePolygonShape3D::intersect_point(const Vector3 &p_point) const {
@@ -1428,68 +1417,65 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
-		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
-		}
-	}
-
-	return false;
-}
-
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	// make matrix local to concave
 	if (faces.size() == 0) {
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	// Quantizing clamps to the shape's bounds, which would let queries outside of it through.
+	if (!p_local_aabb.intersects(get_aabb())) {
+		return;
+	}
+
+	uint16_t query_min[3];
+	uint16_t query_max[3];
+	_quantize_aabb(p_local_aabb, query_min, query_max);
 
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	_CullParams params;
-	params.aabb = local_aabb;
-	params.face = &face;
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
-	params.callback = p_callback;
-	params.userdata = p_userdata;
+	int32_t *stack = (int32_t *)alloca(sizeof(int32_t) * _get_bvh_stack_size());
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const BVH &node = bvh[stack[--stack_size]];
+
+		// Test the four children at once, the bounds are laid out axis by axis for this.
+		bool overlaps[4];
+		for (int i = 0; i < 4; i++) {
+			overlaps[i] = node.child_min[0][i] <= query_max[0] && node.child_max[0][i] >= query_min[0] &&
+					node.child_min[1][i] <= query_max[1] && node.child_max[1][i] >= query_min[1] &&
+					node.child_min[2][i] <= query_max[2] && node.child_max[2][i] >= query_min[2];
+		}
 
-	// cull
-	_cull(0, &params);
+		for (int i = 0; i < 4; i++) {
+			const int32_t child = node.children[i];
+			if (!overlaps[i] || child == BVH_EMPTY) {
+				continue;
+			}
+
+			if (child >= 0) {
+				stack[stack_size++] = child;
+				continue;
+			}
+
+			const Face *f = &fr[-1 - child];
+			face.normal = f->normal;
+			face.vertex[0] = vr[f->indices[0]];
+			face.vertex[1] = vr[f->indices[1]];
+			face.vertex[2] = vr[f->indices[2]];
+			if (p_callback(p_userdata, &face)) {
+				return;
+			}
+		}
+	}
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1526,38 +1512,12 @@ struct _Volume_BVH_CompareZ {
 	}
 };
 
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
-
-	int face_index = 0;
-};
-
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+static void _volume_sort_bvh_elements(_Volume_BVH_Element *p_elements, int p_size) {
+	AABB aabb = p_elements[0].aabb;
+	for (int i = 1; i < p_size; i++) {
+		aabb.merge_with(p_elements[i].aabb);
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
-		}
-	}
-	bvh->aabb = aabb;
 	switch (aabb.get_longest_axis_index()) {
 		case 0: {
 			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
@@ -1573,40 +1533,62 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 			sort_z.sort(p_elements, p_size);
 		} break;
 	}
-
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
-
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
 }
 
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
-
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+void GodotConcavePolygonShape3D::_quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const {
+	for (int axis = 0; axis < 3; axis++) {
+		// Round outwards, one more step makes up for the precision lost in the scaling.
+		real_t min = Math::floor((p_aabb.position[axis] - bvh_quantize_offset[axis]) * bvh_quantize_scale[axis]) - 1;
+		real_t max = Math::ceil((p_aabb.position[axis] + p_aabb.size[axis] - bvh_quantize_offset[axis]) * bvh_quantize_scale[axis]) + 1;
+		r_min[axis] = (uint16_t)CLAMP(min, (real_t)0, (real_t)UINT16_MAX);
+		r_max[axis] = (uint16_t)CLAMP(max, (real_t)0, (real_t)UINT16_MAX);
+	}
+}
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+int32_t GodotConcavePolygonShape3D::_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int p_depth) {
+	int32_t node_index = bvh.size();
+	bvh.push_back(BVH());
+	bvh_depth = MAX(bvh_depth, p_depth);
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
+	// Split in up to four groups by halving twice along the longest axis.
+	int group_begin[5] = { 0, 1, 2, 3, 4 };
+	int group_count = MIN(p_size, 4);
+	if (p_size > 4) {
+		_volume_sort_bvh_elements(p_elements, p_size);
+		int half = p_size / 2;
+		_volume_sort_bvh_elements(p_elements, half);
+		_volume_sort_bvh_elements(&p_elements[half], p_size - half);
+		group_begin[1] = half / 2;
+		group_begin[2] = half;
+		group_begin[3] = half + (p_size - half) / 2;
+		group_begin[4] = p_size;
 	}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+	for (int i = 0; i < group_count; i++) {
+		_Volume_BVH_Element *group = &p_elements[group_begin[i]];
+		int group_size = group_begin[i + 1] - group_begin[i];
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
+		AABB aabb = group[0].aabb;
+		for (int j = 1; j < group_size; j++) {
+			aabb.merge_with(group[j].aabb);
+		}
+
+		// Faces are stored right in their parent.
+		int32_t child = group_size == 1 ? -1 - group[0].face_index : _build_bvh(group, group_size, p_depth + 1);
+
+		// Building children may have reallocated the nodes.
+		BVH &node = bvh[node_index];
+		uint16_t child_min[3];
+		uint16_t child_max[3];
+		_quantize_aabb(aabb, child_min, child_max);
+		for (int axis = 0; axis < 3; axis++) {
+			node.child_min[axis][i] = child_min[axis];
+			node.child_max[axis][i] = child_max[axis];
+		}
+		node.children[i] = child;
 	}
 
-	memdelete(p_bvh_tree);
+	return node_index;
 }
 
 void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
@@ -1654,15 +1636,16 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
-
-	bvh.resize(count + 1);
-
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	bvh_quantize_offset = _aabb.position;
+	for (int axis = 0; axis < 3; axis++) {
+		bvh_quantize_scale[axis] = _aabb.size[axis] > 0 ? UINT16_MAX / _aabb.size[axis] : 0;
+		bvh_dequantize_scale[axis] = _aabb.size[axis] / UINT16_MAX;
+	}
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	bvh.clear();
+	bvh.reserve(src_face_count / 3 + 1);
+	bvh_depth = 0;
+	_build_bvh(bvh_arrayw, src_face_count, 1);
 
 	backface_collision = p_backface_collision;
 
@@ -302,7 +302,7 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
+struct _Volume_BVH_Element;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
@@ -316,48 +316,36 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
-	};
+	// Children are node indices when positive, faces are stored as -1 - face_index.
+	static const int32_t BVH_EMPTY = INT32_MIN;
 
-	Vector<BVH> bvh;
-
-	struct _CullParams {
-		AABB aabb;
-		QueryCallback callback = nullptr;
-		void *userdata = nullptr;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
+	// Four-wide BVH node. The bounds of the children are quantized to 16 bits per axis relative
+	// to the shape's AABB and stored axis by axis, so a node fits in a single cache line.
+	struct BVH {
+		uint16_t child_min[3][4] = {};
+		uint16_t child_max[3][4] = {};
+		int32_t children[4] = { BVH_EMPTY, BVH_EMPTY, BVH_EMPTY, BVH_EMPTY };
 	};
 
-	struct _SegmentCullParams {
-		Vector3 from;
-		Vector3 to;
-		Vector3 dir;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
-
-		Vector3 result;
-		Vector3 normal;
-		int face_index = -1;
-		real_t min_d = 1e20;
-		int collisions = 0;
-	};
+	LocalVector<BVH> bvh;
+	int bvh_depth = 0;
+	Vector3 bvh_quantize_offset;
+	Vector3 bvh_quantize_scale;
+	Vector3 bvh_dequantize_scale;
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const;
+	_FORCE_INLINE_ AABB _dequantize_child_aabb(const BVH &p_node, int p_child) const {
+		Vector3 child_min(p_node.child_min[0][p_child], p_node.child_min[1][p_child], p_node.child_min[2][p_child]);
+		Vector3 child_max(p_node.child_max[0][p_child], p_node.child_max[1][p_child], p_node.child_max[2][p_child]);
+		return AABB(bvh_quantize_offset + child_min * bvh_dequantize_scale, (child_max - child_min) * bvh_dequantize_scale);
+	}
+
+	int32_t _build_bvh(_Volume_BVH_Element *p_elements, int p_size, int p_depth);
 
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	// Each node on the way down leaves at most three siblings on the traversal stack.
+	_FORCE_INLINE_ int _get_bvh_stack_size() const { return bvh_depth * 3 + 1; }
 
 	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
 
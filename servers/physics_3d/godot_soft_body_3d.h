@@ -110,6 +110,7 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	VSet<RID> exceptions;
 
 	uint64_t island_step = 0;
+	uint32_t island_node = 0;
 
 	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
 
@@ -134,6 +135,9 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ uint32_t get_island_node() const { return island_node; }
+	_FORCE_INLINE_ void set_island_node(uint32_t p_node) { island_node = p_node; }
+
 	_FORCE_INLINE_ void add_area(GodotArea3D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
 		if (index > -1) {
@@ -34,6 +34,8 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -105,17 +107,13 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -125,22 +123,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,41 +203,104 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+void GodotPhysicsDirectSpaceState3D::BatchCandidates::begin(int p_count) {
+	objects.clear();
+	subindices.clear();
+	offsets.resize(p_count + 1);
+	offsets[0] = 0;
+}
+
+void GodotPhysicsDirectSpaceState3D::BatchCandidates::add_query(int p_query, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount) {
+	const uint32_t from = objects.size();
+	objects.resize(from + p_amount);
+	subindices.resize(from + p_amount);
+	for (int i = 0; i < p_amount; i++) {
+		objects[from + i] = p_objects[i];
+		subindices[from + i] = p_subindices[i];
+	}
+	offsets[p_query + 1] = from + p_amount;
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_query(uint32_t p_index, RayBatch *p_batch) {
+	const BatchCandidates &candidates = *p_batch->candidates;
+	const uint32_t from = candidates.offsets[p_index];
+	const int amount = candidates.offsets[p_index + 1] - from;
+	p_batch->collided[p_index] = _intersect_ray(*p_batch->parameters, p_batch->from[p_index], p_batch->to[p_index], candidates.objects.ptr() + from, candidates.subindices.ptr() + from, amount, p_batch->results[p_index]);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
 		return 0;
 	}
 
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	// The broadphase uses scratch memory of its own while culling, so that part is done serially.
+	// Testing the candidates against the actual shapes is independent for each ray.
+	BatchCandidates candidates;
+	candidates.begin(p_count);
+	for (int i = 0; i < p_count; i++) {
+		int amount = space->broadphase->cull_segment(p_from[i], p_to[i], space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		candidates.add_query(i, space->intersection_query_results, space->intersection_query_subindex_results, amount);
+	}
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.candidates = &candidates;
+	batch.results = r_results;
+	batch.collided = r_collided;
+
+	if (p_count >= BATCH_QUERY_PARALLEL_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_query, &batch, p_count, -1, true, SNAME("GodotPhysicsRayBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_ray_batch_query(i, &batch);
+		}
+	}
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_collided[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
 
+int GodotPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, ShapeResult *r_results, int p_result_max) const {
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 		if (cc >= p_result_max) {
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -260,6 +321,71 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_shape(p_parameters, shape, p_parameters.transform, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_results, p_result_max);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_batch_query(uint32_t p_index, ShapeBatch *p_batch) {
+	const BatchCandidates &candidates = *p_batch->candidates;
+	const uint32_t from = candidates.offsets[p_index];
+	const int amount = candidates.offsets[p_index + 1] - from;
+	ShapeResult *results = p_batch->results ? p_batch->results + p_index * p_batch->result_max : nullptr;
+	p_batch->result_counts[p_index] = _intersect_shape(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], candidates.objects.ptr() + from, candidates.subindices.ptr() + from, amount, results, p_batch->result_max);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_shapes_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	if (p_count <= 0 || p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	// Same as rays, only the narrowphase runs in parallel.
+	const AABB shape_aabb = shape->get_aabb();
+	BatchCandidates candidates;
+	candidates.begin(p_count);
+	for (int i = 0; i < p_count; i++) {
+		int amount = space->broadphase->cull_aabb(p_transforms[i].xform(shape_aabb), space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		candidates.add_query(i, space->intersection_query_results, space->intersection_query_subindex_results, amount);
+	}
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.candidates = &candidates;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	if (p_count >= BATCH_QUERY_PARALLEL_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_batch_query, &batch, p_count, -1, true, SNAME("GodotPhysicsShapeBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_shape_batch_query(i, &batch);
+		}
+	}
+
+	int result_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		result_count += r_result_counts[i];
+	}
+	return result_count;
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
@@ -1039,6 +1165,12 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 
 	GodotSpace3D *self = static_cast<GodotSpace3D *>(p_self);
 
+	if (self->deterministic && type_A == type_B && B->get_self() < A->get_self()) {
+		// Which object is first in the pair shouldn't depend on which one the broadphase found first.
+		SWAP(A, B);
+		SWAP(p_subindex_A, p_subindex_B);
+	}
+
 	self->collision_pairs++;
 
 	if (type_A == GodotCollisionObject3D::TYPE_AREA) {
@@ -1186,6 +1318,178 @@ void GodotSpace3D::update() {
 	broadphase->update();
 }
 
+// Gathers the constraints with state to keep in snapshots, in an order that doesn't depend on when they were created.
+void GodotSpace3D::_gather_snapshot_constraints() {
+	snapshot_constraints.clear();
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+		for (const KeyValue<GodotConstraint3D *, int> &F : body->get_constraint_map()) {
+			GodotConstraint3D *constraint = F.key;
+			// Visit pairs from their first body only.
+			if (F.value == 0 && constraint->get_body_count() == 2 && constraint->get_snapshot_size() > 0) {
+				snapshot_constraints.push_back(constraint);
+			}
+		}
+	}
+
+	SortArray<GodotConstraint3D *, GodotConstraint3DOrder> sorter;
+	sorter.sort(snapshot_constraints.ptr(), snapshot_constraints.size());
+}
+
+// Layout: version, body count and constraint count, then for each body its RID and state in the order of the objects,
+// then for each constraint the RIDs of both bodies, its subindex, the size of its state and the state itself.
+void GodotSpace3D::save_snapshot(Vector<uint8_t> &r_snapshot) {
+	ERR_FAIL_COND(locked);
+
+	uint32_t body_count = 0;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			body_count++;
+		}
+	}
+
+	_gather_snapshot_constraints();
+
+	uint32_t size = sizeof(uint32_t) * 3 + body_count * (sizeof(uint64_t) + sizeof(GodotBody3D::Snapshot));
+	for (const GodotConstraint3D *constraint : snapshot_constraints) {
+		size += sizeof(uint64_t) * 3 + sizeof(uint32_t) + constraint->get_snapshot_size();
+	}
+
+	// Reuses the buffer of the previous snapshot when nothing was added or removed.
+	r_snapshot.resize(size);
+	uint8_t *w = r_snapshot.ptrw();
+
+	const uint32_t header[3] = { SNAPSHOT_VERSION, body_count, snapshot_constraints.size() };
+	memcpy(w, header, sizeof(header));
+	w += sizeof(header);
+
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		uint64_t id = E->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+
+		// Zeroed first, the fields are then set one by one and padding bytes are left out of the snapshot.
+		GodotBody3D::Snapshot state;
+		memset((void *)&state, 0, sizeof(GodotBody3D::Snapshot));
+		static_cast<const GodotBody3D *>(E)->save_snapshot(state);
+		memcpy(w, &state, sizeof(GodotBody3D::Snapshot));
+		w += sizeof(GodotBody3D::Snapshot);
+	}
+
+	for (const GodotConstraint3D *constraint : snapshot_constraints) {
+		const uint64_t key[3] = { constraint->get_body_ptr()[0]->get_self().get_id(), constraint->get_body_ptr()[1]->get_self().get_id(), constraint->get_order_subindex() };
+		memcpy(w, key, sizeof(key));
+		w += sizeof(key);
+
+		uint32_t state_size = constraint->get_snapshot_size();
+		memcpy(w, &state_size, sizeof(uint32_t));
+		w += sizeof(uint32_t);
+
+		constraint->save_snapshot(w);
+		w += state_size;
+	}
+}
+
+bool GodotSpace3D::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_V(locked, false);
+
+	const uint8_t *r = p_snapshot.ptr();
+	const uint8_t *end = r + p_snapshot.size();
+
+	uint32_t header[3];
+	ERR_FAIL_COND_V_MSG(p_snapshot.size() < (int)sizeof(header), false, "Invalid physics space snapshot.");
+	memcpy(header, r, sizeof(header));
+	r += sizeof(header);
+	ERR_FAIL_COND_V_MSG(header[0] != SNAPSHOT_VERSION, false, "Invalid physics space snapshot.");
+
+	// Check everything matches before changing anything.
+	const uint32_t body_record_size = sizeof(uint64_t) + sizeof(GodotBody3D::Snapshot);
+	ERR_FAIL_COND_V_MSG(end - r < (int64_t)header[1] * body_record_size, false, "Invalid physics space snapshot.");
+	const uint8_t *body_records = r;
+	uint32_t body_count = 0;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		ERR_FAIL_COND_V_MSG(body_count == header[1], false, "The physics space snapshot was saved with different bodies.");
+		uint64_t id;
+		memcpy(&id, body_records + body_count * body_record_size, sizeof(uint64_t));
+		ERR_FAIL_COND_V_MSG(id != E->get_self().get_id(), false, "The physics space snapshot was saved with different bodies.");
+		body_count++;
+	}
+	ERR_FAIL_COND_V_MSG(body_count != header[1], false, "The physics space snapshot was saved with different bodies.");
+
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody3D::Snapshot state;
+		memcpy(&state, r + sizeof(uint64_t), sizeof(GodotBody3D::Snapshot));
+		static_cast<GodotBody3D *>(E)->restore_snapshot(state);
+		r += body_record_size;
+	}
+
+	// Get the pairs for the restored positions, then match them with the saved ones.
+	// Both are sorted by the same keys, pairs that weren't saved start over.
+	update();
+	_gather_snapshot_constraints();
+
+	const uint32_t constraint_record_count = header[2];
+	uint32_t constraint_record_index = 0;
+	uint64_t record_key[3] = {};
+	uint32_t record_size = 0;
+	bool record_loaded = false;
+
+	for (GodotConstraint3D *constraint : snapshot_constraints) {
+		const uint64_t key[3] = { constraint->get_body_ptr()[0]->get_self().get_id(), constraint->get_body_ptr()[1]->get_self().get_id(), constraint->get_order_subindex() };
+
+		bool restored = false;
+		while (true) {
+			if (!record_loaded) {
+				if (constraint_record_index == constraint_record_count) {
+					break;
+				}
+				ERR_FAIL_COND_V_MSG(end - r < (int64_t)(sizeof(record_key) + sizeof(uint32_t)), false, "Invalid physics space snapshot.");
+				memcpy(record_key, r, sizeof(record_key));
+				memcpy(&record_size, r + sizeof(record_key), sizeof(uint32_t));
+				r += sizeof(record_key) + sizeof(uint32_t);
+				ERR_FAIL_COND_V_MSG(end - r < (int64_t)record_size, false, "Invalid physics space snapshot.");
+				record_loaded = true;
+			}
+
+			if (record_key[0] != key[0] || record_key[1] != key[1] || record_key[2] != key[2]) {
+				bool record_before = record_key[0] != key[0] ? record_key[0] < key[0] : (record_key[1] != key[1] ? record_key[1] < key[1] : record_key[2] < key[2]);
+				if (!record_before) {
+					break; // Not saved, this pair is new.
+				}
+			} else if (record_size == constraint->get_snapshot_size()) {
+				constraint->restore_snapshot(r);
+				restored = true;
+			}
+
+			// The pair that record belongs to is gone.
+			r += record_size;
+			constraint_record_index++;
+			record_loaded = false;
+			if (restored) {
+				break;
+			}
+		}
+
+		if (!restored) {
+			constraint->reset_snapshot();
+		}
+	}
+
+	return true;
+}
+
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -1258,6 +1562,8 @@ GodotSpace3D::GodotSpace3D() {
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/3d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/3d/solver/solver_iterations");
+	parallel_island_solve_threshold = GLOBAL_GET("physics/3d/solver/parallel_island_solve_threshold");
+	deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
 	contact_recycle_radius = GLOBAL_GET("physics/3d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
@@ -41,17 +41,89 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
+// Orders constraints by the objects they connect, rather than by when they were found.
+struct GodotConstraint3DOrder {
+	_FORCE_INLINE_ bool operator()(const GodotConstraint3D *p_a, const GodotConstraint3D *p_b) const {
+		if (p_a->get_body_count() != p_b->get_body_count()) {
+			return p_a->get_body_count() < p_b->get_body_count();
+		}
+		for (int i = 0; i < p_a->get_body_count(); i++) {
+			const RID &body_a = p_a->get_body_ptr()[i]->get_self();
+			const RID &body_b = p_b->get_body_ptr()[i]->get_self();
+			if (body_a != body_b) {
+				return body_a < body_b;
+			}
+		}
+		if (p_a->get_soft_body_count() != p_b->get_soft_body_count()) {
+			return p_a->get_soft_body_count() < p_b->get_soft_body_count();
+		}
+		for (int i = 0; i < p_a->get_soft_body_count(); i++) {
+			const RID &soft_body_a = p_a->get_soft_body_ptr(i)->get_self();
+			const RID &soft_body_b = p_b->get_soft_body_ptr(i)->get_self();
+			if (soft_body_a != soft_body_b) {
+				return soft_body_a < soft_body_b;
+			}
+		}
+		if (p_a->get_self() != p_b->get_self()) {
+			return p_a->get_self() < p_b->get_self(); // Joints between the same bodies.
+		}
+		return p_a->get_order_subindex() < p_b->get_order_subindex();
+	}
+};
+
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		BATCH_QUERY_PARALLEL_THRESHOLD = 64, // Smaller batches aren't worth dispatching to other threads.
+	};
+
+	// Broadphase candidates of every query in a batch, query i owns [offsets[i], offsets[i + 1]).
+	struct BatchCandidates {
+		LocalVector<GodotCollisionObject3D *> objects;
+		LocalVector<int> subindices;
+		LocalVector<uint32_t> offsets;
+
+		void begin(int p_count);
+		void add_query(int p_query, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount);
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		const BatchCandidates *candidates = nullptr;
+		RayResult *results = nullptr;
+		bool *collided = nullptr;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		const GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		const BatchCandidates *candidates = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const;
+	int _intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, ShapeResult *r_results, int p_result_max) const;
+
+	void _intersect_ray_batch_query(uint32_t p_index, RayBatch *p_batch);
+	void _intersect_shape_batch_query(uint32_t p_index, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual int intersect_shapes_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
@@ -85,6 +157,7 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	GodotBodyStates3D body_states;
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -94,6 +167,8 @@ private:
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
+	int parallel_island_solve_threshold = 0;
+	bool deterministic = false;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -118,12 +193,21 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int parallel_constraint_count = 0;
 
 	RID static_global_body;
 
 	Vector<Vector3> contact_debug;
 	int contact_debug_count = 0;
 
+	enum {
+		SNAPSHOT_VERSION = 1
+	};
+
+	LocalVector<GodotConstraint3D *> snapshot_constraints;
+
+	void _gather_snapshot_constraints();
+
 	friend class GodotPhysicsDirectSpaceState3D;
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
@@ -136,6 +220,7 @@ public:
 	GodotArea3D *get_default_area() const { return area; }
 
 	const SelfList<GodotBody3D>::List &get_active_body_list() const;
+	_FORCE_INLINE_ GodotBodyStates3D &get_body_states() { return body_states; }
 	void body_add_to_active_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
@@ -161,6 +246,8 @@ public:
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ int get_parallel_island_solve_threshold() const { return parallel_island_solve_threshold; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
@@ -173,6 +260,9 @@ public:
 	void setup();
 	void call_queries();
 
+	void save_snapshot(Vector<uint8_t> &r_snapshot);
+	bool restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	bool is_locked() const;
 	void lock();
 	void unlock();
@@ -191,6 +281,9 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	void set_parallel_constraint_count(int p_parallel_constraint_count) { parallel_constraint_count = p_parallel_constraint_count; }
+	int get_parallel_constraint_count() const { return parallel_constraint_count; }
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
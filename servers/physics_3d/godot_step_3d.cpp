@@ -34,36 +34,41 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/sort_array.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define BODY_INTEGRATION_CHUNK_SIZE 64
+#define CONSTRAINT_COLOR_MIN_PARALLEL_SIZE 32
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+void GodotStep3D::_add_island_body(GodotBody3D *p_body) {
 	p_body->set_island_step(_step);
+	p_body->set_island_node(island_node_count++);
+	island_bodies.push_back(p_body);
+}
 
-	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
-		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
-	}
+void GodotStep3D::_add_island_soft_body(GodotSoftBody3D *p_soft_body) {
+	p_soft_body->set_island_step(_step);
+	p_soft_body->set_island_node(island_node_count++);
+	island_soft_bodies.push_back(p_soft_body);
+}
 
+void GodotStep3D::_gather_island_constraints(GodotBody3D *p_body) {
 	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E.key);
 		if (constraint->get_island_step() == _step) {
 			continue; // Already processed.
 		}
 		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
 
 		all_constraints.push_back(constraint);
+		island_constraint_nodes.push_back(p_body->get_island_node());
 
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
-			if (i == E.value) {
-				continue;
-			}
 			GodotBody3D *other_body = constraint->get_body_ptr()[i];
 			if (other_body->get_island_step() == _step) {
 				continue; // Already processed.
@@ -71,7 +76,7 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			_add_island_body(other_body);
 		}
 
 		// Find connected soft bodies.
@@ -80,23 +85,21 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (soft_body->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			_add_island_soft_body(soft_body);
 		}
 	}
 }
 
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_soft_body->set_island_step(_step);
-
+void GodotStep3D::_gather_island_constraints_soft_body(GodotSoftBody3D *p_soft_body) {
 	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
 		if (constraint->get_island_step() == _step) {
 			continue; // Already processed.
 		}
 		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
 
 		all_constraints.push_back(constraint);
+		island_constraint_nodes.push_back(p_soft_body->get_island_node());
 
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
@@ -107,11 +110,44 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(body, p_body_island, p_constraint_island);
+			_add_island_body(body);
 		}
 	}
 }
 
+void GodotStep3D::_unite_island_constraint(uint32_t p_constraint_index, void *p_userdata) {
+	GodotConstraint3D *constraint = all_constraints[island_constraint_offset + p_constraint_index];
+	uint32_t node = island_constraint_nodes[p_constraint_index];
+
+	for (int i = 0; i < constraint->get_body_count(); i++) {
+		GodotBody3D *body = constraint->get_body_ptr()[i];
+		if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
+		}
+		island_sets.create_union(node, body->get_island_node());
+	}
+
+	for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+		island_sets.create_union(node, constraint->get_soft_body_ptr(i)->get_island_node());
+	}
+}
+
+void GodotStep3D::_integrate_forces_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	uint32_t body_begin = p_chunk_index * BODY_INTEGRATION_CHUNK_SIZE;
+	uint32_t body_end = MIN(body_begin + BODY_INTEGRATION_CHUNK_SIZE, active_bodies.size());
+	for (uint32_t body_index = body_begin; body_index < body_end; ++body_index) {
+		active_bodies[body_index]->integrate_forces_local(delta);
+	}
+}
+
+void GodotStep3D::_integrate_velocities_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	uint32_t body_begin = p_chunk_index * BODY_INTEGRATION_CHUNK_SIZE;
+	uint32_t body_end = MIN(body_begin + BODY_INTEGRATION_CHUNK_SIZE, active_bodies.size());
+	for (uint32_t body_index = body_begin; body_index < body_end; ++body_index) {
+		active_bodies[body_index]->integrate_velocities_local(delta);
+	}
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -131,7 +167,7 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 }
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[single_task_islands[p_island_index]];
 
 	int current_priority = 1;
 
@@ -158,14 +194,140 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+void GodotStep3D::_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	for (LocalVector<GodotConstraint3D *> &constraint_color : constraint_colors) {
+		constraint_color.clear();
+	}
+	constraint_color_count = 0;
+	uncolored_constraints.clear();
+
+	// Greedy coloring in island order, so the same island is always colored the same way.
+	// Static and kinematic bodies are only read while solving and don't need to be colored.
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		uint64_t used_colors = 0;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			const GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				used_colors |= island_node_colors[body->get_island_node()];
+			}
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			used_colors |= island_node_colors[constraint->get_soft_body_ptr(i)->get_island_node()];
+		}
+
+		if (used_colors == UINT64_MAX) {
+			// Out of colors, solved on the calling thread after the colored constraints.
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		uint32_t color = 0;
+		while (used_colors & (uint64_t(1) << color)) {
+			++color;
+		}
+
+		const uint64_t color_bit = uint64_t(1) << color;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			const GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				island_node_colors[body->get_island_node()] |= color_bit;
+			}
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			island_node_colors[constraint->get_soft_body_ptr(i)->get_island_node()] |= color_bit;
+		}
+
+		if (constraint_color_count <= color) {
+			constraint_color_count = color + 1;
+			if (constraint_colors.size() < constraint_color_count) {
+				constraint_colors.resize(constraint_color_count);
+			}
+		}
+		constraint_colors[color].push_back(constraint);
+	}
+}
+
+void GodotStep3D::_solve_color_constraint(uint32_t p_constraint_index, void *p_userdata) {
+	constraint_colors[solving_color][p_constraint_index]->solve(delta);
+}
+
+void GodotStep3D::_solve_island_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	_color_island(p_constraint_island);
+
+	for (uint32_t color = 0; color < constraint_color_count; ++color) {
+		if (constraint_colors[color].size() >= CONSTRAINT_COLOR_MIN_PARALLEL_SIZE) {
+			parallel_constraint_count += constraint_colors[color].size();
+		}
+	}
+
+	int current_priority = 1;
+
+	uint32_t constraint_count = p_constraint_island.size();
+	while (constraint_count > 0) {
+		for (int i = 0; i < iterations; i++) {
+			// Go through all iterations, one color after the other.
+			for (solving_color = 0; solving_color < constraint_color_count; ++solving_color) {
+				LocalVector<GodotConstraint3D *> &constraint_color = constraint_colors[solving_color];
+				if (constraint_color.size() < CONSTRAINT_COLOR_MIN_PARALLEL_SIZE) {
+					for (GodotConstraint3D *constraint : constraint_color) {
+						constraint->solve(delta);
+					}
+					continue;
+				}
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_color_constraint, nullptr, constraint_color.size(), task_count, true, SNAME("Physics3DConstraintSolveColor"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			}
+
+			for (GodotConstraint3D *constraint : uncolored_constraints) {
+				constraint->solve(delta);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		++current_priority;
+		constraint_count = 0;
+		for (uint32_t color = 0; color <= constraint_color_count; ++color) {
+			LocalVector<GodotConstraint3D *> &constraints = color < constraint_color_count ? constraint_colors[color] : uncolored_constraints;
+			uint32_t priority_constraint_count = 0;
+			for (uint32_t constraint_index = 0; constraint_index < constraints.size(); ++constraint_index) {
+				GodotConstraint3D *constraint = constraints[constraint_index];
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					constraints[priority_constraint_count++] = constraint;
+				}
+			}
+			constraints.resize(priority_constraint_count);
+			constraint_count += priority_constraint_count;
+		}
+	}
+}
+
+void GodotStep3D::_check_suspend(GodotSpace3D *p_space, const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
+	// Islands only hold rigid bodies, their sleep time is updated from the velocities in the space arrays.
+	GodotBodyStates3D &states = p_space->get_body_states();
+	const real_t linear_threshold_squared = p_space->get_body_linear_velocity_sleep_threshold() * p_space->get_body_linear_velocity_sleep_threshold();
+	const real_t angular_threshold = p_space->get_body_angular_velocity_sleep_threshold();
+	const real_t time_to_sleep = p_space->get_body_time_to_sleep();
+
 	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody3D *body = p_body_island[body_index];
+		if (!body->is_sleep_allowed()) {
+			can_sleep = false;
+			continue;
+		}
 
-		if (!body->sleep_test(delta)) {
+		const uint32_t slot = body->get_state_slot();
+		real_t &still_time = states.still_time[slot];
+		if (states.angular_velocity[slot].length() < angular_threshold && states.linear_velocity[slot].length_squared() < linear_threshold_squared) {
+			still_time += delta;
+			if (still_time <= time_to_sleep) {
+				can_sleep = false;
+			}
+		} else {
+			still_time = 0;
 			can_sleep = false;
 		}
 	}
@@ -201,13 +363,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
+	active_bodies.clear();
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
+	}
+
+	int active_count = active_bodies.size();
+
+	uint32_t body_chunk_count = (active_bodies.size() + BODY_INTEGRATION_CHUNK_SIZE - 1) / BODY_INTEGRATION_CHUNK_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces_chunk, nullptr, body_chunk_count, task_count, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Extending shapes with their motion moves them in the broadphase, which isn't thread-safe.
+	for (GodotBody3D *body : active_bodies) {
+		body->integrate_forces_finish();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
@@ -258,79 +429,94 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID AND SOFT BODIES */
 
-	uint32_t body_island_count = 0;
+	island_bodies.clear();
+	island_soft_bodies.clear();
+	island_constraint_nodes.clear();
+	island_node_count = 0;
+	island_constraint_offset = all_constraints.size();
 
+	b = body_list->first();
 	while (b) {
-		GodotBody3D *body = b->self();
+		_add_island_body(b->self());
+		b = b->next();
+	}
 
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+	sb = soft_body_list->first();
+	while (sb) {
+		_add_island_soft_body(sb->self());
+		sb = sb->next();
+	}
 
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+	// Gather everything connected to the active bodies breadth-first, the lists grow while being walked.
+	uint32_t island_body_index = 0;
+	uint32_t island_soft_body_index = 0;
+	while (island_body_index < island_bodies.size() || island_soft_body_index < island_soft_bodies.size()) {
+		while (island_body_index < island_bodies.size()) {
+			_gather_island_constraints(island_bodies[island_body_index++]);
+		}
+		while (island_soft_body_index < island_soft_bodies.size()) {
+			_gather_island_constraints_soft_body(island_soft_bodies[island_soft_body_index++]);
+		}
+	}
 
-			_populate_island(body, body_island, constraint_island);
+	island_sets.reset(island_node_count);
 
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
+	uint32_t island_constraint_count = island_constraint_nodes.size();
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_unite_island_constraint, nullptr, island_constraint_count, task_count, true, SNAME("Physics3DUniteIslands"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
+	// Each set is represented by its smallest node, so numbering islands by their first member
+	// gives the same islands in the same order no matter how the unions were scheduled.
+	island_root_body_islands.resize(island_node_count);
+	island_root_constraint_islands.resize(island_node_count);
+	for (uint32_t node = 0; node < island_node_count; ++node) {
+		island_root_body_islands[node] = UINT32_MAX;
+		island_root_constraint_islands[node] = UINT32_MAX;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
+	const uint32_t area_island_count = island_count;
+	uint32_t body_island_count = 0;
 
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
+	for (GodotBody3D *body : island_bodies) {
+		if (body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			continue; // Only rigid bodies are tested for activation.
+		}
 
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
+		uint32_t &body_island_index = island_root_body_islands[island_sets.find(body->get_island_node())];
+		if (body_island_index == UINT32_MAX) {
+			body_island_index = body_island_count++;
 			if (body_islands.size() < body_island_count) {
 				body_islands.resize(body_island_count);
 			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+			body_islands[body_island_index].clear();
+			body_islands[body_island_index].reserve(BODY_ISLAND_SIZE_RESERVE);
+		}
+		body_islands[body_island_index].push_back(body);
+	}
 
-			++island_count;
+	for (uint32_t constraint_index = 0; constraint_index < island_constraint_count; ++constraint_index) {
+		uint32_t &island_index = island_root_constraint_islands[island_sets.find(island_constraint_nodes[constraint_index])];
+		if (island_index == UINT32_MAX) {
+			island_index = island_count++;
 			if (constraint_islands.size() < island_count) {
 				constraint_islands.resize(island_count);
 			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
+			constraint_islands[island_index].clear();
+			constraint_islands[island_index].reserve(ISLAND_SIZE_RESERVE);
+		}
+		constraint_islands[island_index].push_back(all_constraints[island_constraint_offset + constraint_index]);
+	}
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+	if (p_space->is_deterministic()) {
+		// The order constraints were found in depends on the broadphase and on which bodies woke up first,
+		// solve them in an order that only depends on the objects they connect instead.
+		SortArray<GodotConstraint3D *, GodotConstraint3DOrder> sorter;
+		for (uint32_t island_index = area_island_count; island_index < island_count; ++island_index) {
+			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+			sorter.sort(constraint_island.ptr(), constraint_island.size());
 		}
-		sb = sb->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -344,7 +530,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, task_count, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -362,10 +548,35 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	const uint32_t parallel_island_threshold = p_space->get_parallel_island_solve_threshold();
+	single_task_islands.clear();
+	parallel_islands.clear();
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (parallel_island_threshold > 0 && constraint_islands[island_index].size() >= parallel_island_threshold) {
+			parallel_islands.push_back(island_index);
+		} else {
+			single_task_islands.push_back(island_index);
+		}
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, single_task_islands.size(), task_count, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	// Big islands are solved meanwhile, each one spread over the workers.
+	parallel_constraint_count = 0;
+	if (!parallel_islands.is_empty()) {
+		island_node_colors.resize(island_node_count);
+		for (uint32_t node = 0; node < island_node_count; ++node) {
+			island_node_colors[node] = 0;
+		}
+		for (uint32_t island_index : parallel_islands) {
+			_solve_island_parallel(constraint_islands[island_index]);
+		}
+	}
+
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	p_space->set_parallel_constraint_count((int)parallel_constraint_count);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -375,17 +586,28 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
+	// Solving may have woken up more bodies.
+	active_bodies.clear();
 	b = body_list->first();
 	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	body_chunk_count = (active_bodies.size() + BODY_INTEGRATION_CHUNK_SIZE - 1) / BODY_INTEGRATION_CHUNK_SIZE;
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities_chunk, nullptr, body_chunk_count, task_count, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Moving shapes in the broadphase, queuing state queries and deactivating kinematic bodies
+	// aren't thread-safe, do them in list order.
+	for (GodotBody3D *body : active_bodies) {
+		body->integrate_velocities_finish();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(p_space, body_islands[island_index]);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
@@ -33,6 +33,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/math/disjoint_set.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -45,14 +46,52 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
-	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	LocalVector<GodotBody3D *> active_bodies;
+
+	// Islands are built from the bodies reached from the active ones, each constraint is
+	// attached to the node of the body it was found from and united with its other bodies.
+	LocalVector<GodotBody3D *> island_bodies;
+	LocalVector<GodotSoftBody3D *> island_soft_bodies;
+	LocalVector<uint32_t> island_constraint_nodes;
+	uint32_t island_constraint_offset = 0;
+	uint32_t island_node_count = 0;
+	ConcurrentDisjointSet island_sets;
+	LocalVector<uint32_t> island_root_body_islands;
+	LocalVector<uint32_t> island_root_constraint_islands;
+
+	// Islands too big for a single task have their constraints colored so that no two constraints
+	// of the same color move the same body, then each color is solved across the worker threads.
+	LocalVector<uint32_t> single_task_islands;
+	LocalVector<uint32_t> parallel_islands;
+	LocalVector<uint64_t> island_node_colors;
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_colors;
+	uint32_t constraint_color_count = 0;
+	LocalVector<GodotConstraint3D *> uncolored_constraints;
+	uint32_t solving_color = 0;
+	uint32_t parallel_constraint_count = 0;
+
+	// How many tasks each stage is split into, -1 for one per worker thread.
+	int task_count = -1;
+
+	void _add_island_body(GodotBody3D *p_body);
+	void _add_island_soft_body(GodotSoftBody3D *p_soft_body);
+	void _gather_island_constraints(GodotBody3D *p_body);
+	void _gather_island_constraints_soft_body(GodotSoftBody3D *p_soft_body);
+	void _unite_island_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _integrate_forces_chunk(uint32_t p_chunk_index, void *p_userdata = nullptr);
+	void _integrate_velocities_chunk(uint32_t p_chunk_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_color_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _solve_island_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _check_suspend(GodotSpace3D *p_space, const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
+	void set_task_count(int p_task_count) { task_count = p_task_count; }
+	int get_task_count() const { return task_count; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
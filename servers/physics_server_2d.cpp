@@ -617,6 +617,12 @@ bool PhysicsServer2D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+PackedByteArray PhysicsServer2D::_space_save_snapshot(RID p_space) {
+	PackedByteArray snapshot;
+	space_save_snapshot(p_space, snapshot);
+	return snapshot;
+}
+
 void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("world_boundary_shape_create"), &PhysicsServer2D::world_boundary_shape_create);
 	ClassDB::bind_method(D_METHOD("separation_ray_shape_create"), &PhysicsServer2D::separation_ray_shape_create);
@@ -638,6 +644,8 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_snapshot", "space"), &PhysicsServer2D::_space_save_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore_snapshot", "space", "snapshot"), &PhysicsServer2D::space_restore_snapshot);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
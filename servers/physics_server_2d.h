@@ -211,6 +211,8 @@ class PhysicsServer2D : public Object {
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters2D> &p_parameters, const Ref<PhysicsTestMotionResult2D> &p_result = Ref<PhysicsTestMotionResult2D>());
 
+	PackedByteArray _space_save_snapshot(RID p_space);
+
 protected:
 	static void _bind_methods();
 
@@ -276,6 +278,11 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Snapshots hold what stepping changes, to rewind a space that still has the same bodies.
+	// Saving into the same buffer again reuses its memory.
+	virtual void space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) = 0;
+	virtual bool space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -36,6 +36,10 @@ void PhysicsServer2DWrapMT::thread_exit() {
 	exit.set();
 }
 
+void PhysicsServer2DWrapMT::thread_space_save_snapshot(RID p_space, Vector<uint8_t> *r_snapshot) {
+	physics_server_2d->space_save_snapshot(p_space, *r_snapshot);
+}
+
 void PhysicsServer2DWrapMT::thread_step(real_t p_delta) {
 	physics_server_2d->step(p_delta);
 	step_sem.post();
@@ -62,6 +62,7 @@ class PhysicsServer2DWrapMT : public PhysicsServer2D {
 	void thread_step(real_t p_delta);
 
 	void thread_exit();
+	void thread_space_save_snapshot(RID p_space, Vector<uint8_t> *r_snapshot);
 
 	bool first_frame = true;
 
@@ -125,6 +126,18 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	// Saved on the server thread, after the commands pushed before it.
+	virtual void space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) override {
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push_and_sync(this, &PhysicsServer2DWrapMT::thread_space_save_snapshot, p_space, &r_snapshot);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_2d->space_save_snapshot(p_space, r_snapshot);
+		}
+	}
+
+	FUNC2R(bool, space_restore_snapshot, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
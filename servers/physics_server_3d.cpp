@@ -375,6 +375,58 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<RayResult> results;
+	LocalVector<bool> collided;
+	results.resize(count);
+	collided.resize(count);
+
+	intersect_rays_batch(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr(), collided.ptr());
+
+	PackedByteArray collided_out;
+	PackedVector3Array position;
+	PackedVector3Array normal;
+	PackedInt32Array face_index;
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+	collided_out.resize(count);
+	position.resize(count);
+	normal.resize(count);
+	face_index.resize(count);
+	collider_id.resize(count);
+	shape.resize(count);
+
+	uint8_t *collided_w = collided_out.ptrw();
+	Vector3 *position_w = position.ptrw();
+	Vector3 *normal_w = normal.ptrw();
+	int32_t *face_index_w = face_index.ptrw();
+	int64_t *collider_id_w = collider_id.ptrw();
+	int32_t *shape_w = shape.ptrw();
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		collided_w[i] = collided[i] ? 1 : 0;
+		position_w[i] = collided[i] ? result.position : Vector3();
+		normal_w[i] = collided[i] ? result.normal : Vector3();
+		face_index_w[i] = collided[i] ? result.face_index : -1;
+		collider_id_w[i] = collided[i] ? int64_t(result.collider_id) : 0;
+		shape_w[i] = collided[i] ? result.shape : 0;
+	}
+
+	Dictionary d;
+	d["collided"] = collided_out;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["face_index"] = face_index;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+
+	return d;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -420,6 +472,50 @@ TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_shape(const Ref<Phy
 	return ret;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, int p_max_results) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results <= 0, Dictionary());
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	const int count = p_origins.size();
+	LocalVector<Transform3D> transforms;
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		transforms[i] = Transform3D(parameters.transform.basis, p_origins[i]);
+	}
+
+	LocalVector<ShapeResult> results;
+	results.resize(count * p_max_results);
+	PackedInt32Array result_count;
+	result_count.resize(count);
+	int32_t *result_count_w = result_count.ptrw();
+
+	const int total = intersect_shapes_batch(parameters, transforms.ptr(), count, results.ptr(), p_max_results, result_count_w);
+
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+	collider_id.resize(total);
+	shape.resize(total);
+	int64_t *collider_id_w = collider_id.ptrw();
+	int32_t *shape_w = shape.ptrw();
+	int idx = 0;
+	for (int i = 0; i < count; i++) {
+		const ShapeResult *query_results = &results[i * p_max_results];
+		for (int j = 0; j < result_count_w[i]; j++) {
+			collider_id_w[idx] = int64_t(query_results[j].collider_id);
+			shape_w[idx] = query_results[j].shape;
+			idx++;
+		}
+	}
+
+	Dictionary d;
+	d["result_count"] = result_count;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+
+	return d;
+}
+
 Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<real_t>());
 
@@ -474,13 +570,40 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+int PhysicsDirectSpaceState3D::intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_collided[i] = intersect_ray(parameters, r_results[i]);
+		if (r_collided[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState3D::intersect_shapes_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	int result_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+		result_count += r_result_counts[i];
+	}
+	return result_count;
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays_batch);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("intersect_shapes_batch", "parameters", "origins", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shapes_batch, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
@@ -660,6 +783,12 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+PackedByteArray PhysicsServer3D::_space_save_snapshot(RID p_space) {
+	PackedByteArray snapshot;
+	space_save_snapshot(p_space, snapshot);
+	return snapshot;
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -712,6 +841,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_snapshot", "space"), &PhysicsServer3D::_space_save_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore_snapshot", "space", "snapshot"), &PhysicsServer3D::space_restore_snapshot);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -1067,6 +1198,8 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF("physics/3d/sleep_threshold_angular", Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 0.5);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
+	GLOBAL_DEF("physics/3d/solver/deterministic", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/parallel_island_solve_threshold", PROPERTY_HINT_RANGE, "0,8192,1,or_greater"), 1024);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
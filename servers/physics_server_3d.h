@@ -122,8 +122,10 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	Dictionary _intersect_rays_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
+	Dictionary _intersect_shapes_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
@@ -158,6 +160,9 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Casts p_count rays from p_from[i] to p_to[i], all filtered by p_parameters (whose own from and to are ignored).
+	// Fills r_results[i] and r_collided[i] for every ray and returns the amount of rays that hit something.
+	virtual int intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided);
 
 	struct ShapeResult {
 		RID rid;
@@ -199,6 +204,9 @@ public:
 	};
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
+	// Runs intersect_shape() with p_parameters at each of the p_count transforms. The results of query i are written
+	// to r_results[i * p_result_max] onwards, and their amount to r_result_counts[i]. Returns the total amount of results.
+	virtual int intersect_shapes_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts);
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) = 0;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
@@ -235,6 +243,8 @@ class PhysicsServer3D : public Object {
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters3D> &p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
 
+	PackedByteArray _space_save_snapshot(RID p_space);
+
 protected:
 	static void _bind_methods();
 
@@ -306,6 +316,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Snapshots hold what stepping changes, to rewind a space that still has the same bodies.
+	// Saving into the same buffer again reuses its memory.
+	virtual void space_save_snapshot(RID p_space, Vector<uint8_t> &r_snapshot) = 0;
+	virtual bool space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
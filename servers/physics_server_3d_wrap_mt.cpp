@@ -36,6 +36,10 @@ void PhysicsServer3DWrapMT::thread_exit() {
 	exit = true;
 }
 
+void PhysicsServer3DWrapMT::thread_space_save_snapshot(RID p_space, Vector<uint8_t> *r_snapshot) {
+	physics_server_3d->space_save_snapshot(p_space, *r_snapshot);
+}
+
 void PhysicsServer3DWrapMT::thread_step(real_t p_delta) {
 	physics_server_3d->step(p_delta);
 	step_sem.post();
@@ -1387,7 +1387,7 @@ void RenderingServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_p
 	mesh_add_surface(p_mesh, sd);
 }
 
-Array RenderingServer::_get_array_from_surface(uint64_t p_format, Vector<uint8_t> p_vertex_data, Vector<uint8_t> p_attrib_data, Vector<uint8_t> p_skin_data, int p_vertex_len, Vector<uint8_t> p_index_data, int p_index_len, const AABB &p_aabb, const Vector4 &p_uv_scale) const {
+Array RenderingServer::_get_array_from_surface(uint64_t p_format, Span<uint8_t> p_vertex_data, Span<uint8_t> p_attrib_data, Span<uint8_t> p_skin_data, int p_vertex_len, Span<uint8_t> p_index_data, int p_index_len, const AABB &p_aabb, const Vector4 &p_uv_scale) const {
 	uint32_t offsets[RS::ARRAY_MAX];
 
 	uint32_t vertex_elem_size;
@@ -1767,9 +1767,8 @@ TypedArray<Array> RenderingServer::mesh_surface_get_blend_shape_arrays(RID p_mes
 		TypedArray<Array> blend_shape_array;
 		blend_shape_array.resize(mesh_get_blend_shape_count(p_mesh));
 		for (uint32_t i = 0; i < blend_shape_count; i++) {
-			Vector<uint8_t> bs_data = blend_shape_data.slice(i * divisor, (i + 1) * divisor);
-			Vector<uint8_t> unused;
-			blend_shape_array.set(i, _get_array_from_surface(bs_format, bs_data, unused, unused, sd.vertex_count, unused, 0, sd.aabb, sd.uv_scale));
+			Span<uint8_t> bs_data = blend_shape_data.span(i * divisor, (i + 1) * divisor);
+			blend_shape_array.set(i, _get_array_from_surface(bs_format, bs_data, Span<uint8_t>(), Span<uint8_t>(), sd.vertex_count, Span<uint8_t>(), 0, sd.aabb, sd.uv_scale));
 		}
 
 		return blend_shape_array;
@@ -1791,7 +1790,7 @@ Array RenderingServer::mesh_create_arrays_from_surface_data(const SurfaceData &p
 
 	uint64_t format = p_data.format;
 
-	return _get_array_from_surface(format, vertex_data, attrib_data, skin_data, vertex_len, index_data, index_len, p_data.aabb, p_data.uv_scale);
+	return _get_array_from_surface(format, vertex_data.span(), attrib_data.span(), skin_data.span(), vertex_len, index_data.span(), index_len, p_data.aabb, p_data.uv_scale);
 }
 #if 0
 Array RenderingServer::_mesh_surface_get_skeleton_aabb_bind(RID p_mesh, int p_surface) const {
@@ -2069,7 +2068,7 @@ void RenderingServer::_particles_set_trail_bind_poses(RID p_particles, const Typ
 	particles_set_trail_bind_poses(p_particles, tbposes);
 }
 
-Vector<uint8_t> _convert_surface_version_1_to_surface_version_2(uint64_t p_format, Vector<uint8_t> p_vertex_data, uint32_t p_vertex_count, uint32_t p_old_stride, uint32_t p_vertex_size, uint32_t p_normal_size, uint32_t p_position_stride, uint32_t p_normal_tangent_stride) {
+Vector<uint8_t> _convert_surface_version_1_to_surface_version_2(uint64_t p_format, Span<uint8_t> p_vertex_data, uint32_t p_vertex_count, uint32_t p_old_stride, uint32_t p_vertex_size, uint32_t p_normal_size, uint32_t p_position_stride, uint32_t p_normal_tangent_stride) {
 	Vector<uint8_t> new_vertex_data;
 	new_vertex_data.resize(p_vertex_data.size());
 	uint8_t *dst_vertex_ptr = new_vertex_data.ptrw();
@@ -2179,7 +2178,7 @@ void RenderingServer::fix_surface_compatibility(SurfaceData &p_surface, const St
 			int position_stride = vertex_size;
 			int normal_tangent_stride = normal_size + tangent_size;
 
-			p_surface.vertex_data = _convert_surface_version_1_to_surface_version_2(p_surface.format, p_surface.vertex_data, p_surface.vertex_count, stride, vertex_size, normal_size, position_stride, normal_tangent_stride);
+			p_surface.vertex_data = _convert_surface_version_1_to_surface_version_2(p_surface.format, p_surface.vertex_data.span(), p_surface.vertex_count, stride, vertex_size, normal_size, position_stride, normal_tangent_stride);
 
 			if (p_surface.blend_shape_data.size() > 0) {
 				// The size of one blend shape.
@@ -2190,7 +2189,7 @@ void RenderingServer::fix_surface_compatibility(SurfaceData &p_surface, const St
 
 				Vector<uint8_t> new_blend_shape_data;
 				for (uint32_t i = 0; i < blend_shape_count; i++) {
-					Vector<uint8_t> bs_data = p_surface.blend_shape_data.slice(i * divisor, (i + 1) * divisor);
+					Span<uint8_t> bs_data = p_surface.blend_shape_data.span(i * divisor, (i + 1) * divisor);
 					Vector<uint8_t> blend_shape = _convert_surface_version_1_to_surface_version_2(p_surface.format, bs_data, p_surface.vertex_count, stride, vertex_size, normal_size, position_stride, normal_tangent_stride);
 					new_blend_shape_data.append_array(blend_shape);
 				}
@@ -0,0 +1,292 @@
+/**************************************************************************/
+/*  test_astar_grid_2d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ASTAR_GRID_2D_H
+#define TEST_ASTAR_GRID_2D_H
+
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAStarGrid2D {
+
+// Checks that every segment of the path is a straight or diagonal line over walkable points.
+static bool is_walkable_path(const Ref<AStarGrid2D> &p_astar_grid, const TypedArray<Vector2i> &p_path) {
+	for (int i = 1; i < p_path.size(); i++) {
+		const Vector2i from = p_path[i - 1];
+		const Vector2i to = p_path[i];
+		const Vector2i delta = to - from;
+		if (delta.x != 0 && delta.y != 0 && ABS(delta.x) != ABS(delta.y)) {
+			return false;
+		}
+		const Vector2i step = delta.sign();
+		for (Vector2i id = from; id != to; id += step) {
+			if (p_astar_grid->is_point_solid(id)) {
+				return false;
+			}
+		}
+		if (p_astar_grid->is_point_solid(to)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Length of the path, with the jump points of a jumping search spanning several points.
+static real_t get_path_cost(const TypedArray<Vector2i> &p_path) {
+	real_t cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += Vector2(Vector2i(p_path[i]) - Vector2i(p_path[i - 1])).length();
+	}
+	return cost;
+}
+
+// Grid with solid points scattered over it and its own random number generator, so batches and single queries can be compared.
+static Ref<AStarGrid2D> build_random_grid(int p_size, int p_solid_percent, RandomPCG &r_rng) {
+	Ref<AStarGrid2D> astar_grid;
+	astar_grid.instantiate();
+	astar_grid->set_region(Rect2i(0, 0, p_size, p_size));
+	astar_grid->update();
+	for (int y = 0; y < p_size; y++) {
+		for (int x = 0; x < p_size; x++) {
+			if ((int)(r_rng.rand() % 100) < p_solid_percent) {
+				astar_grid->set_point_solid(Vector2i(x, y));
+			}
+		}
+	}
+	return astar_grid;
+}
+
+TEST_CASE("[AStarGrid2D] Paths should go around solid points") {
+	Ref<AStarGrid2D> astar_grid;
+	astar_grid.instantiate();
+	astar_grid->set_region(Rect2i(-2, -2, 10, 10));
+	astar_grid->set_cell_size(Size2(16, 16));
+	astar_grid->update();
+	astar_grid->fill_solid_region(Rect2i(3, -2, 1, 9)); // Wall with an opening in the last row.
+
+	for (int diagonal_mode = 0; diagonal_mode < AStarGrid2D::DIAGONAL_MODE_MAX; diagonal_mode++) {
+		for (int jumping = 0; jumping < 2; jumping++) {
+			astar_grid->set_diagonal_mode(AStarGrid2D::DiagonalMode(diagonal_mode));
+			astar_grid->set_jumping_enabled(jumping);
+
+			const TypedArray<Vector2i> path = astar_grid->get_id_path(Vector2i(-2, -2), Vector2i(7, -2));
+			REQUIRE(path.size() >= 2);
+			CHECK(Vector2i(path[0]) == Vector2i(-2, -2));
+			CHECK(Vector2i(path[path.size() - 1]) == Vector2i(7, -2));
+			CHECK(is_walkable_path(astar_grid, path));
+
+			const Vector<Vector2> point_path = astar_grid->get_point_path(Vector2i(-2, -2), Vector2i(7, -2));
+			REQUIRE(point_path.size() == path.size());
+			CHECK(point_path[0] == Vector2(-32, -32));
+			CHECK(point_path[point_path.size() - 1] == Vector2(112, -32));
+		}
+	}
+
+	astar_grid->set_point_solid(Vector2i(3, 7));
+	CHECK(astar_grid->get_id_path(Vector2i(-2, -2), Vector2i(7, -2)).is_empty());
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should follow changes of solid points") {
+	Ref<AStarGrid2D> astar_grid;
+	astar_grid.instantiate();
+	astar_grid->set_region(Rect2i(0, 0, 16, 16));
+	astar_grid->set_jumping_enabled(true);
+	astar_grid->update();
+
+	TypedArray<Vector2i> path = astar_grid->get_id_path(Vector2i(0, 8), Vector2i(15, 8));
+	CHECK(path.size() == 2);
+
+	astar_grid->fill_solid_region(Rect2i(8, 0, 1, 15));
+	path = astar_grid->get_id_path(Vector2i(0, 8), Vector2i(15, 8));
+	CHECK(path.size() > 2);
+	CHECK(is_walkable_path(astar_grid, path));
+
+	astar_grid->set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	path = astar_grid->get_id_path(Vector2i(0, 8), Vector2i(15, 8));
+	CHECK(path.size() > 2);
+	CHECK(is_walkable_path(astar_grid, path));
+	for (int i = 1; i < path.size(); i++) {
+		const Vector2i delta = Vector2i(path[i]) - Vector2i(path[i - 1]);
+		CHECK((delta.x == 0 || delta.y == 0));
+	}
+
+	astar_grid->fill_solid_region(Rect2i(8, 0, 1, 15), false);
+	path = astar_grid->get_id_path(Vector2i(0, 8), Vector2i(15, 8));
+	CHECK(path.size() == 2);
+}
+
+TEST_CASE("[AStarGrid2D] Weight scales should be kept per point") {
+	Ref<AStarGrid2D> astar_grid;
+	astar_grid.instantiate();
+	astar_grid->set_region(Rect2i(0, 0, 8, 8));
+	astar_grid->set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	astar_grid->update();
+
+	CHECK(astar_grid->get_point_weight_scale(Vector2i(4, 4)) == 1.0);
+	astar_grid->fill_weight_scale_region(Rect2i(1, 0, 6, 7), 10.0);
+	CHECK(astar_grid->get_point_weight_scale(Vector2i(4, 4)) == 10.0);
+	CHECK(astar_grid->get_point_weight_scale(Vector2i(4, 7)) == 1.0);
+
+	// Going around the heavy points is cheaper than going through them.
+	const TypedArray<Vector2i> path = astar_grid->get_id_path(Vector2i(0, 0), Vector2i(7, 0));
+	bool around = false;
+	for (int i = 0; i < path.size(); i++) {
+		around |= Vector2i(path[i]).y == 7;
+	}
+	CHECK(around);
+
+	astar_grid->update();
+	CHECK(astar_grid->get_point_weight_scale(Vector2i(4, 4)) == 1.0);
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should find paths as short as the full search") {
+	RandomPCG rng(9);
+
+	for (int grid = 0; grid < 8; grid++) {
+		Ref<AStarGrid2D> astar_grid = build_random_grid(32 + grid * 4, 10 + grid * 3, rng);
+
+		for (int diagonal_mode = 0; diagonal_mode < AStarGrid2D::DIAGONAL_MODE_MAX; diagonal_mode++) {
+			astar_grid->set_diagonal_mode(AStarGrid2D::DiagonalMode(diagonal_mode));
+			const int size = astar_grid->get_region().size.x;
+
+			int mismatches = 0;
+			for (int i = 0; i < 50; i++) {
+				const Vector2i from_id = Vector2i(rng.rand() % size, rng.rand() % size);
+				const Vector2i to_id = Vector2i(rng.rand() % size, rng.rand() % size);
+
+				astar_grid->set_jumping_enabled(false);
+				const TypedArray<Vector2i> path = astar_grid->get_id_path(from_id, to_id);
+				astar_grid->set_jumping_enabled(true);
+				const TypedArray<Vector2i> jump_path = astar_grid->get_id_path(from_id, to_id);
+
+				if (path.is_empty() != jump_path.is_empty() || Math::abs(get_path_cost(path) - get_path_cost(jump_path)) > 0.001) {
+					mismatches++;
+				}
+			}
+			CHECK_MESSAGE(mismatches == 0, vformat("Paths found with jumping should cost the same as without it in diagonal mode %d.", diagonal_mode));
+		}
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Batched paths should match single paths") {
+	RandomPCG rng(3);
+	Ref<AStarGrid2D> astar_grid = build_random_grid(64, 25, rng);
+
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < 100; i++) {
+		from_ids.push_back(Vector2i(rng.rand() % 64, rng.rand() % 64));
+		to_ids.push_back(Vector2i(rng.rand() % 64, rng.rand() % 64));
+	}
+	from_ids.push_back(Vector2i(5, 5));
+	to_ids.push_back(Vector2i(5, 5));
+
+	for (int jumping = 0; jumping < 2; jumping++) {
+		astar_grid->set_jumping_enabled(jumping);
+
+		const TypedArray<Array> paths = astar_grid->get_id_paths_batch(from_ids, to_ids);
+		REQUIRE(paths.size() == from_ids.size());
+		int mismatches = 0;
+		for (int i = 0; i < from_ids.size(); i++) {
+			if (Array(paths[i]) != Array(astar_grid->get_id_path(from_ids[i], to_ids[i]))) {
+				mismatches++;
+			}
+		}
+		CHECK_MESSAGE(mismatches == 0, "Paths found in a batch should be the same as the ones found one by one.");
+	}
+
+	ERR_PRINT_OFF;
+	to_ids.pop_back();
+	CHECK(astar_grid->get_id_paths_batch(from_ids, to_ids).is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Find paths on a 2048x2048 grid") {
+	const int size = 2048;
+	RandomPCG rng(7);
+	Ref<AStarGrid2D> astar_grid;
+	astar_grid.instantiate();
+	astar_grid->set_region(Rect2i(0, 0, size, size));
+	astar_grid->set_default_compute_heuristic(AStarGrid2D::HEURISTIC_OCTILE);
+	astar_grid->set_default_estimate_heuristic(AStarGrid2D::HEURISTIC_OCTILE);
+	astar_grid->update();
+	for (int i = 0; i < 4000; i++) {
+		astar_grid->fill_solid_region(Rect2i(rng.rand() % size, rng.rand() % size, 1 + rng.rand() % 64, 1 + rng.rand() % 64));
+	}
+
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	const int query_count = 64;
+	for (int i = 0; i < query_count; i++) {
+		Vector2i from_id;
+		Vector2i to_id;
+		do {
+			from_id = Vector2i(rng.rand() % size, rng.rand() % size);
+		} while (astar_grid->is_point_solid(from_id));
+		do {
+			to_id = Vector2i(rng.rand() % size, rng.rand() % size);
+		} while (astar_grid->is_point_solid(to_id));
+		from_ids.push_back(from_id);
+		to_ids.push_back(to_id);
+	}
+
+	for (int jumping = 0; jumping < 2; jumping++) {
+		astar_grid->set_jumping_enabled(jumping);
+		astar_grid->get_id_path(from_ids[0], to_ids[0]); // Builds the jump distances.
+
+		int path_count = 0;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			path_count += astar_grid->get_id_path(from_ids[i], to_ids[i]).is_empty() ? 0 : 1;
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE("Average path query time with jumping ", jumping ? "enabled" : "disabled", ": ", elapsed / query_count, " usec.");
+
+		const uint64_t batch_begin = OS::get_singleton()->get_ticks_usec();
+		const TypedArray<Array> paths = astar_grid->get_id_paths_batch(from_ids, to_ids);
+		const uint64_t batch_elapsed = OS::get_singleton()->get_ticks_usec() - batch_begin;
+
+		MESSAGE("Average path query time in a batch of ", query_count, " with jumping ", jumping ? "enabled" : "disabled", ": ", batch_elapsed / query_count, " usec.");
+
+		int batch_path_count = 0;
+		for (int i = 0; i < paths.size(); i++) {
+			batch_path_count += Array(paths[i]).is_empty() ? 0 : 1;
+		}
+		CHECK(batch_path_count == path_count);
+	}
+}
+
+} // namespace TestAStarGrid2D
+
+#endif // TEST_ASTAR_GRID_2D_H
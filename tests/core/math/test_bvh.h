@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairingItem {
+	uint32_t id = 0;
+};
+
+template <class T>
+class PairingItemPairTest {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <class T>
+class PairingItemCullTest {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<PairingItem, 2, true, 32, PairingItemPairTest<PairingItem>, PairingItemCullTest<PairingItem>> PairingBVH;
+
+// Records every pair and unpair callback, in order.
+struct PairingLog {
+	LocalVector<uint64_t> events;
+	uint32_t pair_count = 0;
+	uint32_t unpair_count = 0;
+
+	static void *pair(void *p_self, uint32_t p_id_a, PairingItem *p_a, int p_subindex_a, uint32_t p_id_b, PairingItem *p_b, int p_subindex_b) {
+		PairingLog *self = static_cast<PairingLog *>(p_self);
+		self->events.push_back((uint64_t(p_a->id) << 32) | p_b->id);
+		self->pair_count++;
+		return nullptr;
+	}
+
+	static void unpair(void *p_self, uint32_t p_id_a, PairingItem *p_a, int p_subindex_a, uint32_t p_id_b, PairingItem *p_b, int p_subindex_b, void *p_pair_data) {
+		PairingLog *self = static_cast<PairingLog *>(p_self);
+		self->events.push_back((uint64_t(1) << 63) | (uint64_t(p_a->id) << 32) | p_b->id);
+		self->unpair_count++;
+	}
+};
+
+static void run_pairing_simulation(uint32_t p_pairing_thread_threshold, PairingLog &r_log) {
+	const uint32_t item_count = 600;
+
+	PairingBVH bvh;
+	bvh.params_set_pairing_thread_threshold(p_pairing_thread_threshold);
+	bvh.set_pair_callback(&PairingLog::pair, &r_log);
+	bvh.set_unpair_callback(&PairingLog::unpair, &r_log);
+
+	RandomPCG rng(12345);
+	PairingItem items[item_count];
+	LocalVector<BVHHandle> handles;
+	LocalVector<Vector3> positions;
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].id = i;
+		const Vector3 position(rng.randf() * 40.0f, rng.randf() * 40.0f, rng.randf() * 40.0f);
+		// Items in tree 0 are static and only pair with dynamic items in tree 1.
+		const uint32_t tree_id = i % 4 == 0 ? 0 : 1;
+		const uint32_t tree_collision_mask = tree_id == 0 ? 2 : 3;
+		handles.push_back(bvh.create(&items[i], true, tree_id, tree_collision_mask, AABB(position, Vector3(2, 2, 2))));
+		positions.push_back(position);
+	}
+	bvh.update();
+
+	for (int step = 0; step < 10; step++) {
+		for (uint32_t i = 0; i < item_count; i++) {
+			if (i % 4 == 0) {
+				continue;
+			}
+			positions[i] += Vector3(rng.randf() - 0.5f, rng.randf() - 0.5f, rng.randf() - 0.5f) * 4.0f;
+			bvh.move(handles[i], AABB(positions[i], Vector3(2, 2, 2)));
+		}
+		bvh.update();
+	}
+
+	for (const BVHHandle &handle : handles) {
+		bvh.erase(handle);
+	}
+}
+
+TEST_CASE("[BVH] Pairing on several threads matches pairing on a single thread") {
+	PairingLog serial_log;
+	run_pairing_simulation(0, serial_log);
+
+	PairingLog threaded_log;
+	run_pairing_simulation(64, threaded_log);
+
+	CHECK(serial_log.pair_count > 0);
+	CHECK(serial_log.unpair_count > 0);
+	CHECK_MESSAGE(serial_log.pair_count == serial_log.unpair_count, "Every pair should be unpaired once all items are erased.");
+
+	CHECK(threaded_log.pair_count == serial_log.pair_count);
+	CHECK(threaded_log.unpair_count == serial_log.unpair_count);
+	bool same_events = threaded_log.events.size() == serial_log.events.size();
+	for (uint32_t i = 0; same_events && i < serial_log.events.size(); i++) {
+		same_events = threaded_log.events[i] == serial_log.events[i];
+	}
+	CHECK_MESSAGE(same_events, "Pair and unpair callbacks should happen in the same order.");
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  test_disjoint_set.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_DISJOINT_SET_H
+#define TEST_DISJOINT_SET_H
+
+#include "core/math/disjoint_set.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDisjointSet {
+
+TEST_CASE("[DisjointSet] Concurrent disjoint set is represented by the smallest index") {
+	ConcurrentDisjointSet set;
+	set.reset(8);
+	CHECK(set.size() == 8);
+
+	set.create_union(5, 3);
+	set.create_union(7, 5);
+	set.create_union(6, 1);
+	set.create_union(1, 6);
+
+	CHECK(set.find(0) == 0);
+	CHECK(set.find(3) == 3);
+	CHECK(set.find(5) == 3);
+	CHECK(set.find(7) == 3);
+	CHECK(set.find(1) == 1);
+	CHECK(set.find(6) == 1);
+
+	set.create_union(7, 0);
+	CHECK(set.find(3) == 0);
+	CHECK(set.find(5) == 0);
+
+	set.reset(8);
+	CHECK(set.find(5) == 5);
+}
+
+static const uint32_t CHAIN_NODE_COUNT = 4096;
+
+static void _unite_chain_link(void *p_userdata, uint32_t p_index) {
+	ConcurrentDisjointSet *set = static_cast<ConcurrentDisjointSet *>(p_userdata);
+	// Visit the links out of order so threads keep racing on the same roots.
+	uint32_t node = (p_index * 7919) % (CHAIN_NODE_COUNT - 2);
+	set->create_union(node + 2, node);
+}
+
+TEST_CASE("[DisjointSet] Concurrent disjoint set united from several threads") {
+	// Linking every node to the one two places before gives one set for even and one for odd nodes.
+	ConcurrentDisjointSet set;
+	set.reset(CHAIN_NODE_COUNT);
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_unite_chain_link, &set, CHAIN_NODE_COUNT - 2, -1, true, "UniteChainLinks");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	bool all_found = true;
+	for (uint32_t node = 0; node < CHAIN_NODE_COUNT; node++) {
+		if (set.find(node) != node % 2) {
+			all_found = false;
+		}
+	}
+	CHECK_MESSAGE(all_found, "Every node should be represented by the first node of its chain.");
+}
+
+} // namespace TestDisjointSet
+
+#endif // TEST_DISJOINT_SET_H
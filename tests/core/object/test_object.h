@@ -33,8 +33,13 @@
 
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
+#include "core/object/message_queue.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -426,6 +431,88 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalReceiverObject : public Object {
+public:
+	int calls = 0;
+
+	void receive() {
+		calls++;
+	}
+};
+
+TEST_CASE("[Object] Signal emission") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+
+	SUBCASE("Emitting to few and many connections should call every connection once") {
+		// Covers both the stack-allocated and heap-allocated slot snapshots.
+		for (int receiver_count : { 3, 64 }) {
+			const int emit_count = 10000;
+			SignalReceiverObject receivers[64];
+			for (int i = 0; i < receiver_count; i++) {
+				object.connect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiverObject::receive));
+			}
+
+			for (int i = 0; i < emit_count; i++) {
+				object.emit_signal("my_custom_signal");
+			}
+
+			bool all_called = true;
+			for (int i = 0; i < receiver_count; i++) {
+				all_called &= receivers[i].calls == emit_count;
+				object.disconnect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiverObject::receive));
+			}
+			CHECK_MESSAGE(all_called, "Every connection should be called once per emission.");
+		}
+	}
+
+	SUBCASE("One-shot connections should only be called once") {
+		SignalReceiverObject receiver;
+		object.connect("my_custom_signal", callable_mp(&receiver, &SignalReceiverObject::receive), Object::CONNECT_ONE_SHOT);
+		object.emit_signal("my_custom_signal");
+		object.emit_signal("my_custom_signal");
+		CHECK(receiver.calls == 1);
+		CHECK_FALSE(object.is_connected("my_custom_signal", callable_mp(&receiver, &SignalReceiverObject::receive)));
+	}
+
+	SUBCASE("Emitting a signal whose connections were all removed should succeed") {
+		SignalReceiverObject receiver;
+		object.connect("my_custom_signal", callable_mp(&receiver, &SignalReceiverObject::receive));
+		object.disconnect("my_custom_signal", callable_mp(&receiver, &SignalReceiverObject::receive));
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+		CHECK(receiver.calls == 0);
+	}
+}
+
+TEST_CASE("[Stress][Object] Signal emission") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+
+	// Few connections use the stack-allocated slot snapshot, many use the heap-allocated one.
+	for (int receiver_count : { 3, 64 }) {
+		const int emit_count = 100000;
+		SignalReceiverObject receivers[64];
+		for (int i = 0; i < receiver_count; i++) {
+			object.connect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiverObject::receive));
+		}
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emit_count; i++) {
+			object.emit_signal("my_custom_signal");
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE("Average emission time to ", receiver_count, " receivers: ", elapsed * 1000 / emit_count, " nsec.");
+
+		int calls = 0;
+		for (int i = 0; i < receiver_count; i++) {
+			calls += receivers[i].calls;
+			object.disconnect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiverObject::receive));
+		}
+		CHECK(calls == receiver_count * emit_count);
+	}
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
@@ -470,6 +557,107 @@ public:
 	}
 };
 
+class DeferredReceiverObject : public Object {
+public:
+	int calls = 0;
+	int64_t sum = 0;
+	LocalVector<int> values;
+
+	void receive(int p_value) {
+		calls++;
+		sum += p_value;
+		values.push_back(p_value);
+	}
+};
+
+static void _push_deferred_calls(void *p_userdata, uint32_t p_index) {
+	DeferredReceiverObject *receiver = (DeferredReceiverObject *)p_userdata;
+	for (int i = 0; i < 16; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(receiver, &DeferredReceiverObject::receive), int(p_index));
+	}
+}
+
+TEST_CASE("[Object] Deferred calls pushed from worker threads") {
+	MessageQueue *message_queue = memnew(MessageQueue);
+	DeferredReceiverObject receiver;
+
+	const int task_count = 256;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_push_deferred_calls, &receiver, task_count);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	message_queue->push_callable(callable_mp(&receiver, &DeferredReceiverObject::receive), task_count);
+
+	CHECK_MESSAGE(receiver.calls == 0, "Deferred calls should not run before the queue is flushed.");
+	message_queue->flush();
+
+	CHECK_MESSAGE(receiver.calls == task_count * 16 + 1, "Calls pushed from every thread should run on flush.");
+	CHECK(receiver.sum == int64_t(task_count - 1) * task_count / 2 * 16 + task_count);
+	CHECK(message_queue->get_last_flush_message_count() == uint32_t(receiver.calls));
+	CHECK(message_queue->get_last_flush_bytes() > 0);
+
+	message_queue->flush();
+	CHECK_MESSAGE(receiver.calls == task_count * 16 + 1, "Flushing again should not run any call twice.");
+	CHECK(message_queue->get_last_flush_message_count() == 0);
+
+	memdelete(message_queue);
+}
+
+struct DeferredPushThreadData {
+	DeferredReceiverObject *receiver = nullptr;
+	int index = 0;
+	Semaphore start;
+};
+
+static void _push_ordered_deferred_calls(void *p_userdata) {
+	DeferredPushThreadData *data = (DeferredPushThreadData *)p_userdata;
+	data->start.wait();
+	for (int i = 0; i < 8; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(data->receiver, &DeferredReceiverObject::receive), data->index * 100 + i);
+	}
+}
+
+TEST_CASE("[Object] Deferred calls pushed from threads are flushed in thread order") {
+	MessageQueue *message_queue = memnew(MessageQueue);
+	DeferredReceiverObject receiver;
+
+	// Threads get increasing IDs as they are started.
+	const int thread_count = 4;
+	DeferredPushThreadData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].receiver = &receiver;
+		data[i].index = i + 1;
+		threads[i].start(&_push_ordered_deferred_calls, &data[i]);
+	}
+
+	// The last started thread pushes first, so the threads don't start pushing in ID order.
+	message_queue->push_callable(callable_mp(&receiver, &DeferredReceiverObject::receive), 0);
+	for (int i = thread_count - 1; i >= 0; i--) {
+		data[i].start.post();
+		threads[i].wait_to_finish();
+	}
+	message_queue->push_callable(callable_mp(&receiver, &DeferredReceiverObject::receive), 1);
+
+	message_queue->flush();
+
+	// Calls pushed on the main thread come first, then those of each thread in ID order.
+	LocalVector<int> expected;
+	expected.push_back(0);
+	expected.push_back(1);
+	for (int i = 0; i < thread_count; i++) {
+		for (int j = 0; j < 8; j++) {
+			expected.push_back((i + 1) * 100 + j);
+		}
+	}
+	REQUIRE(receiver.values.size() == expected.size());
+	bool ordered = true;
+	for (uint32_t i = 0; i < expected.size(); i++) {
+		ordered &= receiver.values[i] == expected[i];
+	}
+	CHECK_MESSAGE(ordered, "Calls should be flushed by thread ID, in push order within each thread.");
+
+	memdelete(message_queue);
+}
+
 TEST_CASE("[Object] Notification order") { // GH-52325
 	NotificationObject2 *test_notification_object = memnew(NotificationObject2);
 
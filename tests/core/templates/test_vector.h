@@ -295,6 +295,52 @@ TEST_CASE("[Vector] Slice") {
 	Vector<int> slice7 = vector.slice(5, 1);
 	CHECK(slice7.size() == 0); // Expected to fail.
 	ERR_PRINT_ON;
+
+	// Slicing the full range shares the data, writing to either side must not affect the other.
+	Vector<int> slice8 = vector.slice(0);
+	CHECK(slice8.size() == 5);
+	CHECK(slice8.ptr() == vector.ptr());
+	slice8.write[0] = 42;
+	CHECK(slice8[0] == 42);
+	CHECK(vector[0] == 0);
+}
+
+TEST_CASE("[Vector] Span") {
+	Vector<int> vector;
+	vector.push_back(0);
+	vector.push_back(1);
+	vector.push_back(2);
+	vector.push_back(3);
+	vector.push_back(4);
+
+	Span<int> span0 = vector.span();
+	CHECK(span0.size() == 5);
+	CHECK(span0.ptr() == vector.ptr());
+
+	Span<int> span1 = vector.span(1, -1);
+	CHECK(span1.size() == 3);
+	CHECK(span1.ptr() == vector.ptr() + 1);
+	CHECK(span1[0] == 1);
+	CHECK(span1[2] == 3);
+
+	int sum = 0;
+	for (const int &value : span1) {
+		sum += value;
+	}
+	CHECK(sum == 6);
+
+	Span<int> span2 = span1.subspan(1);
+	CHECK(span2.size() == 2);
+	CHECK(span2[0] == 2);
+	CHECK(span2[1] == 3);
+
+	CHECK(vector.span(-2).size() == 2);
+	CHECK(vector.span(2, 2).is_empty());
+	CHECK(Vector<int>().span().is_empty());
+
+	ERR_PRINT_OFF;
+	CHECK(vector.span(4, 1).is_empty()); // Expected to fail.
+	ERR_PRINT_ON;
 }
 
 TEST_CASE("[Vector] Find, has") {
@@ -329,6 +329,20 @@ TEST_CASE("[Array] slice()") {
 
 	Array slice14 = array.slice(6);
 	CHECK(slice14.size() == 0);
+
+	// Shallow slices of the full range share the data until written to.
+	Array slice15 = array.slice(0);
+	CHECK(slice15.size() == 6);
+	slice15[0] = 42;
+	CHECK(slice15[0] == Variant(42));
+	CHECK(array[0] == Variant(0));
+
+	Array nested;
+	nested.push_back(array);
+	Array slice16 = nested.slice(0, 1, 1, true);
+	CHECK(slice16.size() == 1);
+	CHECK(Array(slice16[0]).id() != array.id());
+	CHECK(Array(nested.slice(0)[0]).id() == array.id());
 }
 
 TEST_CASE("[Array] Duplicate array") {
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  test_callable.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CALLABLE_H
+#define TEST_CALLABLE_H
+
+#include "core/object/callable_method_pointer.h"
+#include "core/object/object.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCallable {
+
+class NativeCallTarget : public Object {
+public:
+	int64_t total = 0;
+	String last_name;
+
+	void add(int64_t p_value) {
+		total += p_value;
+	}
+
+	void set_name(const String &p_name, int64_t p_value) {
+		last_name = p_name;
+		total = p_value;
+	}
+
+	int64_t get_total() const {
+		return total;
+	}
+};
+
+static uint32_t static_native_call_index = 0;
+
+static void static_native_call(uint32_t p_index) {
+	static_native_call_index = p_index;
+}
+
+TEST_CASE("[Callable] Native calls") {
+	NativeCallTarget target;
+
+	SUBCASE("Matching signatures should call the method without Variant arguments") {
+		Callable add = callable_mp(&target, &NativeCallTarget::add);
+		CHECK(add.try_native_call(int64_t(5)));
+		CHECK(target.total == 5);
+
+		Callable set_name = callable_mp(&target, &NativeCallTarget::set_name);
+		CHECK(set_name.try_native_call(String("native"), int64_t(7)));
+		CHECK(target.last_name == "native");
+		CHECK(target.total == 7);
+
+		CHECK(callable_mp(&target, &NativeCallTarget::get_total).try_native_call());
+
+		CHECK(callable_mp_static(static_native_call).try_native_call(uint32_t(42)));
+		CHECK(static_native_call_index == 42);
+	}
+
+	SUBCASE("Mismatching signatures should not call anything") {
+		Callable add = callable_mp(&target, &NativeCallTarget::add);
+		CHECK_FALSE(add.try_native_call(int32_t(5)));
+		CHECK_FALSE(add.try_native_call(int64_t(5), int64_t(6)));
+		CHECK_FALSE(add.try_native_call());
+		CHECK(target.total == 0);
+
+		// The regular call path still works as a fallback.
+		add.call(5);
+		CHECK(target.total == 5);
+	}
+
+	SUBCASE("Standard callables should not be called natively") {
+		Callable standard = Callable(&target, "notify_property_list_changed");
+		CHECK_FALSE(standard.try_native_call());
+	}
+
+	SUBCASE("Freed objects should not be called natively") {
+		NativeCallTarget *freed = memnew(NativeCallTarget);
+		Callable add = callable_mp(freed, &NativeCallTarget::add);
+		memdelete(freed);
+		CHECK_FALSE(add.try_native_call(int64_t(1)));
+	}
+}
+
+} // namespace TestCallable
+
+#endif // TEST_CALLABLE_H
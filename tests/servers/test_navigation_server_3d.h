@@ -31,6 +31,9 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "modules/navigation/nav_map.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -63,6 +66,53 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// Square grid of unit quads split in two halves by a wall, which only has an opening at the far end.
+static Ref<NavigationMesh> build_walled_grid_navigation_mesh(int p_size, real_t p_height_scale = 0.0) {
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, Math::sin(x * 0.3) * Math::cos(z * 0.2) * p_height_scale, z));
+		}
+	}
+
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	navigation_mesh->set_vertices(vertices);
+	const int wall = p_size / 2;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			if (x == wall && z < p_size - 4) {
+				continue;
+			}
+			Vector<int> polygon;
+			polygon.push_back(z * (p_size + 1) + x);
+			polygon.push_back((z + 1) * (p_size + 1) + x);
+			polygon.push_back((z + 1) * (p_size + 1) + x + 1);
+			polygon.push_back(z * (p_size + 1) + x + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// Single square polygon, used as a chunk of tiled maps.
+static Ref<NavigationMesh> build_quad_navigation_mesh(real_t p_size) {
+	Vector<Vector3> vertices;
+	vertices.push_back(Vector3(0, 0, 0));
+	vertices.push_back(Vector3(0, 0, p_size));
+	vertices.push_back(Vector3(p_size, 0, p_size));
+	vertices.push_back(Vector3(p_size, 0, 0));
+	Vector<int> polygon;
+	polygon.push_back(0);
+	polygon.push_back(1);
+	polygon.push_back(2);
+	polygon.push_back(3);
+
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	navigation_mesh->set_vertices(vertices);
+	navigation_mesh->add_polygon(polygon);
+	return navigation_mesh;
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -629,6 +679,58 @@ TEST_SUITE("[Navigation]") {
 		memdelete(node_3d);
 	}
 
+	TEST_CASE("[NavigationServer3D][SceneTree] Server should parse shared meshes correctly") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Several instances of the same mesh.
+		Node3D *node_3d = memnew(Node3D);
+		SceneTree::get_singleton()->get_root()->add_child(node_3d);
+		Ref<BoxMesh> box_mesh = memnew(BoxMesh);
+		LocalVector<MeshInstance3D *> mesh_instances;
+		for (int i = 0; i < 4; i++) {
+			MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+			mesh_instance->set_mesh(box_mesh);
+			mesh_instance->set_position(Vector3(i * 2.0, 0.0, 0.0));
+			node_3d->add_child(mesh_instance);
+			mesh_instances.push_back(mesh_instance);
+		}
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		Ref<NavigationMeshSourceGeometryData3D> expected_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		for (int i = 0; i < 4; i++) {
+			expected_source_geometry->add_mesh(box_mesh, mesh_instances[i]->get_global_transform());
+		}
+
+		navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+		CHECK_EQ(source_geometry->get_vertices(), expected_source_geometry->get_vertices());
+		CHECK_EQ(source_geometry->get_indices(), expected_source_geometry->get_indices());
+
+		SUBCASE("Parsing again should give the same geometry") {
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+			CHECK_EQ(source_geometry->get_vertices(), expected_source_geometry->get_vertices());
+			CHECK_EQ(source_geometry->get_indices(), expected_source_geometry->get_indices());
+		}
+
+		SUBCASE("Parsing should use the new faces of a changed mesh") {
+			box_mesh->set_size(Vector3(2.0, 0.5, 2.0));
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+			CHECK_NE(source_geometry->get_vertices(), expected_source_geometry->get_vertices());
+
+			expected_source_geometry->clear();
+			for (int i = 0; i < 4; i++) {
+				expected_source_geometry->add_mesh(box_mesh, mesh_instances[i]->get_global_transform());
+			}
+			CHECK_EQ(source_geometry->get_vertices(), expected_source_geometry->get_vertices());
+			CHECK_EQ(source_geometry->get_indices(), expected_source_geometry->get_indices());
+		}
+
+		for (MeshInstance3D *mesh_instance : mesh_instances) {
+			memdelete(mesh_instance);
+		}
+		memdelete(node_3d);
+	}
+
 	// This test case does not check precise values on purpose - to not be too sensitivte.
 	TEST_CASE("[NavigationServer3D] Server should respond to queries against valid map properly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -720,6 +822,612 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake navigation mesh tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+
+		// A 2x2 grid of tiles covering the box.
+		TypedArray<NavigationMesh> tiles;
+		for (int i = 0; i < 4; i++) {
+			Ref<NavigationMesh> tile = memnew(NavigationMesh);
+			tile->set_border_size(1.0);
+			tile->set_filter_baking_aabb(AABB(Vector3(-10.0 + (i % 2) * 10.0, -1.0, -10.0 + (i / 2) * 10.0), Vector3(10.0, 2.0, 10.0)));
+			tiles.push_back(tile);
+		}
+
+		CHECK_EQ(navigation_server->bake_tiles_from_source_geometry_data(tiles, source_geometry), 4);
+
+		const real_t cell_size = Ref<NavigationMesh>(tiles[0])->get_cell_size();
+		for (int i = 0; i < 4; i++) {
+			Ref<NavigationMesh> tile = tiles[i];
+			CHECK_NE(tile->get_polygon_count(), 0);
+
+			// The tile is only shrunk by the agent radius on the outer edges of the box.
+			const AABB bounds = tile->get_filter_baking_aabb();
+			real_t min_x = bounds.get_end().x;
+			real_t max_x = bounds.position.x;
+			for (const Vector3 &vertex : tile->get_vertices()) {
+				CHECK(vertex.x >= bounds.position.x - CMP_EPSILON);
+				CHECK(vertex.x <= bounds.get_end().x + CMP_EPSILON);
+				CHECK(vertex.z >= bounds.position.z - CMP_EPSILON);
+				CHECK(vertex.z <= bounds.get_end().z + CMP_EPSILON);
+				min_x = MIN(min_x, vertex.x);
+				max_x = MAX(max_x, vertex.x);
+			}
+			if (i % 2 == 0) {
+				CHECK(max_x > bounds.get_end().x - cell_size);
+			} else {
+				CHECK(min_x < bounds.position.x + cell_size);
+			}
+		}
+
+		SUBCASE("Unchanged tiles should not be baked again") {
+			CHECK_EQ(navigation_server->bake_tiles_from_source_geometry_data(tiles, source_geometry), 0);
+
+			// Geometry away from the other tiles and their borders only rebakes its own tile.
+			Array obstacle;
+			obstacle.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(obstacle, Vector3(1.0, 1.0, 1.0));
+			source_geometry->add_mesh_array(obstacle, Transform3D(Basis(), Vector3(-5.0, 0.5, -5.0)));
+			CHECK_EQ(navigation_server->bake_tiles_from_source_geometry_data(tiles, source_geometry), 1);
+
+			Ref<NavigationMesh>(tiles[3])->set_agent_radius(0.25);
+			CHECK_EQ(navigation_server->bake_tiles_from_source_geometry_data(tiles, source_geometry), 1);
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths around walls on a large map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_walled_grid_navigation_mesh(64);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(10.5, 0, 10.5);
+		const Vector3 target = Vector3(54.5, 0, 10.5);
+
+		SUBCASE("Optimized path should go through the opening") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+			REQUIRE(path.size() > 2);
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+			bool through_opening = false;
+			real_t length = 0.0;
+			for (int i = 1; i < path.size(); i++) {
+				through_opening |= path[i].z >= 60.0;
+				length += path[i - 1].distance_to(path[i]);
+			}
+			CHECK(through_opening);
+			CHECK(length > 2.0 * 50.0);
+			CHECK(length < 2.0 * 60.0);
+
+			// Querying again walks the same polygons in the same order.
+			CHECK_EQ(navigation_server->map_get_path(map, start, target, true), path);
+		}
+
+		SUBCASE("Unoptimized path should cross each polygon it goes through") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, target, false);
+			REQUIRE(path.size() > 2);
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+			for (int i = 1; i < path.size(); i++) {
+				CHECK(path[i - 1].distance_to(path[i]) <= Math_SQRT2);
+			}
+		}
+
+		SUBCASE("Path to a point off the map should end at the closest reachable point") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, Vector3(80, 0, 10.5), true);
+			REQUIRE(path.size() > 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(64, 0, 10.5)));
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should only rebuild the regions that changed") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_quad_navigation_mesh(8);
+
+		// A 4x4 grid of chunks sharing their edges.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		Vector<RID> regions;
+		for (int z = 0; z < 4; z++) {
+			for (int x = 0; x < 4; x++) {
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x * 8, 0, z * 8)));
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				regions.push_back(region);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_SYNC_COUNT), 16);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 24);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 40);
+
+		const Vector3 start = Vector3(1, 0, 4);
+		const Vector3 target = Vector3(23, 0, 4);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+		REQUIRE_EQ(path.size(), 2);
+		CHECK(path[1].is_equal_approx(target));
+
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_SYNC_COUNT), 0);
+
+		SUBCASE("Moving a chunk away should disconnect only that chunk") {
+			navigation_server->region_set_transform(regions[1], Transform3D(Basis(), Vector3(100, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_SYNC_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 21);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 43);
+
+			// The path has to go around the missing chunk.
+			path = navigation_server->map_get_path(map, start, target, true);
+			REQUIRE(path.size() > 2);
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+			for (int i = 0; i < path.size(); i++) {
+				CHECK_FALSE((path[i].x > 8.0 && path[i].x < 16.0 && path[i].z < 8.0));
+			}
+
+			// Moving it back reconnects it with its neighbors.
+			navigation_server->region_set_transform(regions[1], Transform3D(Basis(), Vector3(8, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_SYNC_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 24);
+			path = navigation_server->map_get_path(map, start, target, true);
+			CHECK_EQ(path.size(), 2);
+		}
+
+		SUBCASE("Removing a chunk should disconnect its neighbors from it") {
+			navigation_server->free(regions[1]);
+			regions.remove_at(1);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_COUNT), 15);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 21);
+			path = navigation_server->map_get_path(map, start, target, true);
+			REQUIRE(path.size() > 2);
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical path queries should route across many regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_quad_navigation_mesh(4);
+
+		// A 16x16 grid of chunks with a wall of missing chunks, which only has an opening at the far end.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		Vector<RID> regions;
+		for (int z = 0; z < 16; z++) {
+			for (int x = 0; x < 16; x++) {
+				if (x == 8 && z < 14) {
+					continue;
+				}
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x * 4, 0, z * 4)));
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				regions.push_back(region);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(2, 0, 2);
+		const Vector3 target = Vector3(62, 0, 2);
+		const Vector<Vector3> full_path = navigation_server->map_get_path(map, start, target, true);
+		REQUIRE(full_path.size() > 2);
+		const uint32_t full_polygon_count = NavMap::get_last_path_query_polygon_count();
+
+		CHECK_FALSE(navigation_server->map_get_use_hierarchical_pathfinding(map));
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+
+		SUBCASE("Path should go through the opening") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+			const uint32_t corridor_polygon_count = NavMap::get_last_path_query_polygon_count();
+			REQUIRE(path.size() > 2);
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+
+			real_t length = 0.0;
+			real_t full_length = 0.0;
+			bool through_opening = false;
+			for (int i = 1; i < path.size(); i++) {
+				length += path[i - 1].distance_to(path[i]);
+				through_opening |= path[i].z >= 56.0;
+			}
+			for (int i = 1; i < full_path.size(); i++) {
+				full_length += full_path[i - 1].distance_to(full_path[i]);
+			}
+			CHECK(through_opening);
+			CHECK(length < full_length * 1.25);
+			// The polygons outside of the regions found through the portals are not searched.
+			CHECK(corridor_polygon_count > 0);
+			CHECK_MESSAGE(corridor_polygon_count < full_polygon_count, "The corridor should have restricted the search.");
+			CHECK(corridor_polygon_count < (uint32_t)regions.size() / 2);
+		}
+
+		SUBCASE("Path should follow new connections after the map changes") {
+			// Filling the wall opens a direct way through.
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(32, 0, 0)));
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			regions.push_back(region);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+			REQUIRE_EQ(path.size(), 2);
+			CHECK(path[1].is_equal_approx(target));
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Batched path queries should match single path queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_walled_grid_navigation_mesh(64);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		RandomPCG rng(3);
+		TypedArray<NavigationPathQueryParameters3D> parameters;
+		TypedArray<NavigationPathQueryResult3D> results;
+		for (int i = 0; i < 64; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(rng.random(0.0f, 64.0f), 0, rng.random(0.0f, 64.0f)));
+			query_parameters->set_target_position(Vector3(rng.random(0.0f, 64.0f), 0, rng.random(0.0f, 64.0f)));
+			if (i % 2) {
+				query_parameters->set_path_postprocessing(NavigationPathQueryParameters3D::PATH_POSTPROCESSING_EDGECENTERED);
+			}
+			parameters.push_back(query_parameters);
+			results.push_back(Ref<NavigationPathQueryResult3D>(memnew(NavigationPathQueryResult3D)));
+		}
+
+		navigation_server->query_paths(parameters, results);
+
+		int mismatches = 0;
+		for (int i = 0; i < parameters.size(); i++) {
+			Ref<NavigationPathQueryResult3D> batch_result = results[i];
+			Ref<NavigationPathQueryResult3D> single_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(parameters[i], single_result);
+			CHECK_NE(batch_result->get_path().size(), 0);
+			if (batch_result->get_path() != single_result->get_path() || batch_result->get_path_rids() != single_result->get_path_rids() || batch_result->get_path_types() != single_result->get_path_types()) {
+				mismatches++;
+			}
+		}
+		CHECK(mismatches == 0);
+
+		SUBCASE("Mismatched parameters and results should be rejected") {
+			results.pop_back();
+			ERR_PRINT_OFF;
+			navigation_server->query_paths(parameters, results);
+			ERR_PRINT_ON;
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Closest point queries should match a search over all faces") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_walled_grid_navigation_mesh(48, 2.0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		LocalVector<Face3> faces;
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+			const Vector<int> polygon = navigation_mesh->get_polygon(i);
+			for (int j = 2; j < polygon.size(); j++) {
+				faces.push_back(Face3(vertices[polygon[0]], vertices[polygon[j - 1]], vertices[polygon[j]]));
+			}
+		}
+
+		RandomPCG rng(5);
+		int mismatches = 0;
+		for (int i = 0; i < 200; i++) {
+			const Vector3 point = Vector3(rng.random(-8.0f, 56.0f), rng.random(-6.0f, 6.0f), rng.random(-8.0f, 56.0f));
+			real_t closest_distance = FLT_MAX;
+			for (const Face3 &face : faces) {
+				closest_distance = MIN(closest_distance, face.get_closest_point_to(point).distance_to(point));
+			}
+			const Vector3 closest_point = navigation_server->map_get_closest_point(map, point);
+			if (!Math::is_equal_approx(closest_point.distance_to(point), closest_distance)) {
+				mismatches++;
+			}
+		}
+		CHECK_MESSAGE(mismatches == 0, "Closest points should be as close as the closest point on any face.");
+
+		mismatches = 0;
+		for (int i = 0; i < 200; i++) {
+			const Vector3 from = Vector3(rng.random(0.0f, 48.0f), 5.0, rng.random(0.0f, 48.0f));
+			const Vector3 to = Vector3(rng.random(0.0f, 48.0f), -5.0, rng.random(0.0f, 48.0f));
+			real_t closest_distance = FLT_MAX;
+			for (const Face3 &face : faces) {
+				Vector3 intersection;
+				if (face.intersects_segment(from, to, &intersection)) {
+					closest_distance = MIN(closest_distance, intersection.distance_to(from));
+				}
+			}
+			const Vector3 closest_point = navigation_server->map_get_closest_point_to_segment(map, from, to, true);
+			if (closest_distance != FLT_MAX && !Math::is_equal_approx(closest_point.distance_to(from), closest_distance)) {
+				mismatches++;
+			}
+		}
+		CHECK_MESSAGE(mismatches == 0, "Segments crossing the surface should stop at the first crossing.");
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Flow fields should lead to their target") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_walled_grid_navigation_mesh(32);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		RID flow_field = navigation_server->flow_field_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->flow_field_set_map(flow_field, map);
+		navigation_server->flow_field_set_target_position(flow_field, Vector3(26.5, 0, 5.5));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->flow_field_get_map(flow_field), map);
+		CHECK_EQ(navigation_server->flow_field_get_target_position(flow_field), Vector3(26.5, 0, 5.5));
+		CHECK_EQ(navigation_server->flow_field_get_navigation_layers(flow_field), 1);
+
+		SUBCASE("Following the directions should go through the opening") {
+			const Vector3 start = Vector3(5.5, 0, 5.5);
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, Vector3(26.5, 0, 5.5), true);
+			REQUIRE(path.size() > 2);
+			const Vector3 direction = navigation_server->flow_field_get_direction(flow_field, start);
+			CHECK(direction.is_normalized());
+			CHECK(direction.dot(path[1] - path[0]) > 0.0);
+
+			Vector3 position = start;
+			bool through_opening = false;
+			for (int i = 0; i < 400 && position.distance_to(Vector3(26.5, 0, 5.5)) > 0.5; i++) {
+				position += navigation_server->flow_field_get_direction(flow_field, position) * 0.5;
+				through_opening |= position.z >= 28.0;
+			}
+			CHECK(through_opening);
+			CHECK(position.distance_to(Vector3(26.5, 0, 5.5)) <= 0.5);
+		}
+
+		SUBCASE("Moving the target should update the directions") {
+			navigation_server->flow_field_set_target_position(flow_field, Vector3(5.5, 0, 26.5));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->flow_field_get_direction(flow_field, Vector3(5.5, 0, 5.5)).z > 0.9);
+
+			navigation_server->flow_field_set_target_position(flow_field, Vector3(5.5, 0, 26.2));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->flow_field_get_direction(flow_field, Vector3(5.2, 0, 26.2)).is_equal_approx(Vector3(1, 0, 0)));
+		}
+
+		SUBCASE("Flow field without matching navigation layers should not lead anywhere") {
+			navigation_server->flow_field_set_navigation_layers(flow_field, 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->flow_field_get_direction(flow_field, Vector3(5.5, 0, 5.5)), Vector3());
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Freeing the map leaves the flow field without one.
+		CHECK_FALSE(navigation_server->flow_field_get_map(flow_field).is_valid());
+		CHECK_EQ(navigation_server->flow_field_get_direction(flow_field, Vector3(5.5, 0, 5.5)), Vector3());
+		navigation_server->free(flow_field);
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Find paths on a large map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 400;
+		Ref<NavigationMesh> navigation_mesh = build_walled_grid_navigation_mesh(size);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Paths between both halves have to search most of the map.
+		RandomPCG rng(11);
+		const int query_count = 20;
+		int path_points = 0;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			const Vector3 start = Vector3(rng.random(0.0f, size * 0.4f), 0, rng.random(0.0f, (float)size));
+			const Vector3 target = Vector3(rng.random(size * 0.6f, (float)size), 0, rng.random(0.0f, (float)size));
+			path_points += navigation_server->map_get_path(map, start, target, true).size();
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE("Average path query time on ", navigation_mesh->get_polygon_count(), " polygons: ", elapsed / query_count, " usec.");
+		CHECK(path_points >= query_count * 3);
+
+		TypedArray<NavigationPathQueryParameters3D> parameters;
+		TypedArray<NavigationPathQueryResult3D> results;
+		for (int i = 0; i < query_count * 10; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(rng.random(0.0f, size * 0.4f), 0, rng.random(0.0f, (float)size)));
+			query_parameters->set_target_position(Vector3(rng.random(size * 0.6f, (float)size), 0, rng.random(0.0f, (float)size)));
+			parameters.push_back(query_parameters);
+			results.push_back(Ref<NavigationPathQueryResult3D>(memnew(NavigationPathQueryResult3D)));
+		}
+		const uint64_t batch_begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->query_paths(parameters, results);
+		const uint64_t batch_elapsed = OS::get_singleton()->get_ticks_usec() - batch_begin;
+
+		MESSAGE("Average path query time in a batch of ", parameters.size(), ": ", batch_elapsed / parameters.size(), " usec.");
+
+		const int point_query_count = 10000;
+		Vector3 point_sum;
+		const uint64_t point_begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < point_query_count; i++) {
+			point_sum += navigation_server->map_get_closest_point(map, Vector3(rng.random(0.0f, (float)size), 1.0, rng.random(0.0f, (float)size)));
+		}
+		const uint64_t point_elapsed = OS::get_singleton()->get_ticks_usec() - point_begin;
+
+		MESSAGE("Average closest point query time: ", point_elapsed * 1000 / point_query_count, " nsec.");
+		CHECK(point_sum.y == 0.0);
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Hierarchical path queries on a tiled map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = build_quad_navigation_mesh(4);
+
+		// A 64x64 grid of chunks with some missing, so that paths have to find their way around.
+		const int size = 64;
+		RandomPCG rng(5);
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		Vector<RID> regions;
+		for (int z = 0; z < size; z++) {
+			for (int x = 0; x < size; x++) {
+				if (x > 0 && z > 0 && rng.randf() < 0.2f) {
+					continue;
+				}
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x * 4, 0, z * 4)));
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				regions.push_back(region);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// From the left quarter of the map to the right one.
+		const int query_count = 50;
+		LocalVector<Vector3> starts;
+		LocalVector<Vector3> targets;
+		for (int i = 0; i < query_count; i++) {
+			starts.push_back(Vector3(rng.random(0.0f, size * 1.0f), 0, rng.random(0.0f, size * 4.0f)));
+			targets.push_back(Vector3(rng.random(size * 3.0f, size * 4.0f), 0, rng.random(0.0f, size * 4.0f)));
+		}
+
+		uint64_t elapsed[2] = {};
+		uint64_t polygon_counts[2] = {};
+		int path_points[2] = {};
+		for (int hierarchical = 0; hierarchical < 2; hierarchical++) {
+			navigation_server->map_set_use_hierarchical_pathfinding(map, hierarchical == 1);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				path_points[hierarchical] += navigation_server->map_get_path(map, starts[i], targets[i], true).size();
+				polygon_counts[hierarchical] += NavMap::get_last_path_query_polygon_count();
+			}
+			elapsed[hierarchical] = OS::get_singleton()->get_ticks_usec() - begin;
+		}
+
+		MESSAGE("Average path query time on ", regions.size(), " regions: ", elapsed[0] / query_count, " usec, ", polygon_counts[0] / query_count, " polygons searched.");
+		MESSAGE("Average hierarchical path query time: ", elapsed[1] / query_count, " usec, ", polygon_counts[1] / query_count, " polygons searched.");
+		CHECK(path_points[0] >= query_count * 2);
+		CHECK(path_points[1] >= query_count * 2);
+		CHECK_MESSAGE(polygon_counts[1] < polygon_counts[0], "The corridors should have restricted the searches.");
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Avoidance with a large crowd") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 100;
+		const int step_count = 10;
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// Agents packed in a square, all heading to its center.
+		RandomPCG rng(13);
+		CallableMock avoidance_callback_mock;
+		LocalVector<RID> agents;
+		LocalVector<Vector3> positions;
+		for (int i = 0; i < size * size; i++) {
+			RID agent = navigation_server->agent_create();
+			const Vector3 position = Vector3(i % size + rng.random(-0.1f, 0.1f), 0, i / size + rng.random(-0.1f, 0.1f));
+			navigation_server->agent_set_map(agent, map);
+			navigation_server->agent_set_avoidance_enabled(agent, true);
+			navigation_server->agent_set_use_3d_avoidance(agent, i % 2 == 0);
+			navigation_server->agent_set_radius(agent, 0.4);
+			navigation_server->agent_set_max_speed(agent, 2.0);
+			navigation_server->agent_set_avoidance_callback(agent, callable_mp(&avoidance_callback_mock, &CallableMock::function1));
+			agents.push_back(agent);
+			positions.push_back(position);
+		}
+
+		uint64_t elapsed = 0;
+		for (int step = 0; step < step_count; step++) {
+			// Moving the agents rebuilds their neighbor grids in each step.
+			for (uint32_t i = 0; i < agents.size(); i++) {
+				const Vector3 velocity = (Vector3(size * 0.5, 0, size * 0.5) - positions[i]).limit_length(2.0);
+				positions[i] += velocity / 60.0;
+				navigation_server->agent_set_position(agents[i], positions[i]);
+				navigation_server->agent_set_velocity(agents[i], velocity);
+			}
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			navigation_server->process(1.0 / 60.0);
+			elapsed += OS::get_singleton()->get_ticks_usec() - begin;
+		}
+
+		MESSAGE("Average avoidance step time with ", agents.size(), " agents: ", elapsed / step_count, " usec.");
+		CHECK_EQ(avoidance_callback_mock.function1_calls, agents.size() * step_count);
+
+		for (const RID &agent : agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer3D
 
@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/math/random_pcg.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Restoring a space snapshot resimulates the same steps") {
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape, Transform2D(0, Vector2(0, 10)));
+	physics_server->body_set_space(floor, space);
+
+	RID box = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(box, Vector2(10, 10));
+
+	// Separate columns of boxes falling on the floor, so that each pile is its own island.
+	RandomPCG rng(7);
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 24; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_add_shape(body, box);
+		physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+		Vector2 position((i % 6) * 60 + rng.random((real_t)-4.0, (real_t)4.0), -10 - (i / 6) * 30);
+		physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(rng.random((real_t)-0.2, (real_t)0.2), position));
+		physics_server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	physics_server->set_active(true);
+	for (int i = 0; i < 40; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	Vector<uint8_t> snapshot;
+	physics_server->space_save_snapshot(space, snapshot);
+	CHECK(snapshot.size() > 0);
+
+	LocalVector<Transform2D> first_run;
+	for (int i = 0; i < 40; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	for (const RID &body : bodies) {
+		first_run.push_back(physics_server->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM));
+	}
+
+	REQUIRE(physics_server->space_restore_snapshot(space, snapshot));
+
+	// Saving again right away gives the same bytes, padding included.
+	Vector<uint8_t> restored_snapshot;
+	physics_server->space_save_snapshot(space, restored_snapshot);
+	CHECK_MESSAGE(restored_snapshot == snapshot, "Saving right after restoring should give the exact same snapshot.");
+
+	for (int i = 0; i < 40; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	// Pairs found again after restoring may be solved in another order, which is only allowed to change rounding.
+	bool same = true;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		const Transform2D transform = physics_server->body_get_state(bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		same &= transform.get_origin().distance_to(first_run[i].get_origin()) < 0.01;
+		same &= Math::abs(Math::angle_difference(transform.get_rotation(), first_run[i].get_rotation())) < 0.001;
+	}
+	CHECK_MESSAGE(same, "Resimulating from the snapshot should give the same transforms.");
+
+	// A snapshot doesn't apply anymore once bodies are added.
+	RID extra_body = physics_server->body_create();
+	physics_server->body_add_shape(extra_body, box);
+	physics_server->body_set_space(extra_body, space);
+	ERR_PRINT_OFF;
+	CHECK_FALSE(physics_server->space_restore_snapshot(space, snapshot));
+	ERR_PRINT_ON;
+
+	physics_server->free(extra_body);
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
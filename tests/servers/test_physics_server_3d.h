@@ -0,0 +1,1049 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/math/geometry_3d.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box = physics_server->box_shape_create();
+	physics_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+
+	// A grid of static boxes, every other one on a different collision layer.
+	LocalVector<RID> bodies;
+	for (int x = 0; x < 8; x++) {
+		for (int z = 0; z < 8; z++) {
+			RID body = physics_server->body_create();
+			physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			physics_server->body_add_shape(body, box);
+			physics_server->body_set_collision_layer(body, (x + z) % 2 ? 1 : 2);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2, 0, z * 2)));
+			physics_server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	physics_server->set_active(true);
+	physics_server->step(1.0 / 60.0);
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	SUBCASE("Batched rays should match single rays") {
+		const int ray_count = 256; // Large enough to be processed in parallel.
+		LocalVector<Vector3> from;
+		LocalVector<Vector3> to;
+		for (int i = 0; i < ray_count; i++) {
+			const real_t offset = (i % 64) * 0.25;
+			from.push_back(Vector3(offset, 5, (i / 64) * 4.1));
+			to.push_back(Vector3(offset, -5, (i / 64) * 4.1));
+		}
+
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		parameters.collision_mask = 1;
+
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		LocalVector<bool> collided;
+		results.resize(ray_count);
+		collided.resize(ray_count);
+		int hit_count = space_state->intersect_rays_batch(parameters, from.ptr(), to.ptr(), ray_count, results.ptr(), collided.ptr());
+		CHECK(hit_count > 0);
+		CHECK(hit_count < ray_count);
+
+		bool all_match = true;
+		for (int i = 0; i < ray_count; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult result;
+			bool hit = space_state->intersect_ray(parameters, result);
+			all_match &= hit == collided[i];
+			if (hit && collided[i]) {
+				all_match &= result.rid == results[i].rid;
+				all_match &= result.position.is_equal_approx(results[i].position);
+				all_match &= result.normal.is_equal_approx(results[i].normal);
+			}
+		}
+		CHECK_MESSAGE(all_match, "Every ray of the batch should hit the same as when cast on its own.");
+	}
+
+	SUBCASE("Batched shape queries should match single shape queries") {
+		const int query_count = 128;
+		const int result_max = 4;
+		LocalVector<Transform3D> transforms;
+		for (int i = 0; i < query_count; i++) {
+			transforms.push_back(Transform3D(Basis(), Vector3((i % 16) * 1.0, 0, (i / 16) * 2.0)));
+		}
+
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = box;
+
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		LocalVector<int> result_counts;
+		results.resize(query_count * result_max);
+		result_counts.resize(query_count);
+		int total = space_state->intersect_shapes_batch(parameters, transforms.ptr(), query_count, results.ptr(), result_max, result_counts.ptr());
+		CHECK(total > 0);
+
+		bool all_match = true;
+		int single_total = 0;
+		for (int i = 0; i < query_count; i++) {
+			parameters.transform = transforms[i];
+			PhysicsDirectSpaceState3D::ShapeResult single_results[result_max];
+			int count = space_state->intersect_shape(parameters, single_results, result_max);
+			single_total += count;
+			all_match &= count == result_counts[i];
+			for (int j = 0; j < MIN(count, result_counts[i]); j++) {
+				all_match &= single_results[j].rid == results[i * result_max + j].rid;
+			}
+		}
+		CHECK(total == single_total);
+		CHECK_MESSAGE(all_match, "Every query of the batch should find the same as when run on its own.");
+	}
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+// Benchmark driver: drops a block of spheres with random velocities into a box and steps the simulation.
+// Returns the average step time in microseconds, and the process info of the last step.
+static uint64_t simulate_falling_spheres(int p_side, int p_steps, int &r_active_objects, int &r_collision_pairs, int &r_island_count) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID sphere = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere, 0.5);
+
+	// Floor and walls keeping the spheres together.
+	RID box = physics_server->box_shape_create();
+	const real_t extent = p_side * 0.75 + 2.0;
+	physics_server->shape_set_data(box, Vector3(extent, 1, extent));
+	RID walls = physics_server->body_create();
+	physics_server->body_set_mode(walls, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(walls, box, Transform3D(Basis(), Vector3(0, -1, 0)));
+	physics_server->body_add_shape(walls, box, Transform3D(Basis(Vector3(0, 0, 1), Math_PI / 2), Vector3(-extent, extent, 0)));
+	physics_server->body_add_shape(walls, box, Transform3D(Basis(Vector3(0, 0, 1), Math_PI / 2), Vector3(extent, extent, 0)));
+	physics_server->body_add_shape(walls, box, Transform3D(Basis(Vector3(1, 0, 0), Math_PI / 2), Vector3(0, extent, -extent)));
+	physics_server->body_add_shape(walls, box, Transform3D(Basis(Vector3(1, 0, 0), Math_PI / 2), Vector3(0, extent, extent)));
+	physics_server->body_set_space(walls, space);
+
+	RandomPCG rng(0);
+	LocalVector<RID> bodies;
+	for (int x = 0; x < p_side; x++) {
+		for (int y = 0; y < p_side; y++) {
+			for (int z = 0; z < p_side; z++) {
+				RID body = physics_server->body_create();
+				physics_server->body_add_shape(body, sphere);
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((x - p_side / 2) * 1.5, 1 + y * 1.5, (z - p_side / 2) * 1.5)));
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(rng.randf() - 0.5f, rng.randf() - 0.5f, rng.randf() - 0.5f) * 4.0f);
+				physics_server->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+	}
+
+	physics_server->set_active(true);
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_steps; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	r_active_objects = physics_server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS);
+	r_collision_pairs = physics_server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS);
+	r_island_count = physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(walls);
+	physics_server->free(box);
+	physics_server->free(sphere);
+	physics_server->free(space);
+	physics_server->set_active(false);
+
+	return elapsed / MAX(p_steps, 1);
+}
+
+TEST_CASE("[Stress][SceneTree][PhysicsServer3D] Step many moving bodies") {
+	int active_objects = 0;
+	int collision_pairs = 0;
+	int island_count = 0;
+	const uint64_t step_usec = simulate_falling_spheres(10, 60, active_objects, collision_pairs, island_count);
+
+	MESSAGE("Average step time with 1000 spheres: ", step_usec, " usec, ", collision_pairs, " collision pairs, ", island_count, " islands.");
+	CHECK(active_objects > 0);
+	CHECK(collision_pairs > 0);
+}
+
+// Stacks boxes on a static floor and lets them settle, returns where each box ends up.
+static void simulate_box_stack(int p_height, int p_steps, int p_parallel_island_threshold, LocalVector<Vector3> &r_positions) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	// Only read when the space is created.
+	const Variant threshold = GLOBAL_GET("physics/3d/solver/parallel_island_solve_threshold");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_solve_threshold", p_parallel_island_threshold);
+	RID space = physics_server->space_create();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_solve_threshold", threshold);
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(10, 1, 10));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape, Transform3D(Basis(), Vector3(0, -1, 0)));
+	physics_server->body_set_space(floor, space);
+
+	RID box = physics_server->box_shape_create();
+	physics_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+
+	LocalVector<RID> bodies;
+	for (int i = 0; i < p_height; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_add_shape(body, box);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.5 + i, 0)));
+		physics_server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	physics_server->set_active(true);
+	for (int i = 0; i < p_steps; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	r_positions.clear();
+	for (const RID &body : bodies) {
+		r_positions.push_back(Transform3D(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin);
+		physics_server->free(body);
+	}
+	physics_server->free(box);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Stacked boxes stay at rest when their island is colored") {
+	const int height = 10;
+
+	// A threshold of 0 solves the stack on a single thread, the smaller one colors its island.
+	for (int threshold : { 0, 4 }) {
+		LocalVector<Vector3> positions;
+		simulate_box_stack(height, 120, threshold, positions);
+		REQUIRE(positions.size() == height);
+
+		bool stable = true;
+		for (int i = 0; i < height; i++) {
+			stable &= Vector2(positions[i].x, positions[i].z).length() < 0.1;
+			// Some penetration is allowed at every contact of the stack.
+			stable &= Math::abs(positions[i].y - (0.5 + i)) < 0.25;
+		}
+		CHECK_MESSAGE(stable, vformat("The stack should neither topple nor sink with a threshold of %d.", threshold));
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Large jointed island is solved on several threads") {
+	GodotPhysicsServer3D *physics_server = Object::cast_to<GodotPhysicsServer3D>(PhysicsServer3D::get_singleton());
+	REQUIRE(physics_server);
+
+	// Only read when the space is created.
+	const Variant threshold = GLOBAL_GET("physics/3d/solver/parallel_island_solve_threshold");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_solve_threshold", 16);
+	RID space = physics_server->space_create();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_solve_threshold", threshold);
+	physics_server->space_set_active(space, true);
+
+	// A net of spheres pinned to their neighbors, with enough joints for each color to be spread over the threads.
+	const int side = 12;
+	RID sphere = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere, 0.25);
+	LocalVector<RID> bodies;
+	for (int x = 0; x < side; x++) {
+		for (int z = 0; z < side; z++) {
+			RID body = physics_server->body_create();
+			physics_server->body_add_shape(body, sphere);
+			physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x, 0, z)));
+			physics_server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	LocalVector<RID> joints;
+	for (int x = 0; x < side; x++) {
+		for (int z = 0; z < side; z++) {
+			if (x + 1 < side) {
+				RID joint = physics_server->joint_create();
+				physics_server->joint_make_pin(joint, bodies[x * side + z], Vector3(0.5, 0, 0), bodies[(x + 1) * side + z], Vector3(-0.5, 0, 0));
+				joints.push_back(joint);
+			}
+			if (z + 1 < side) {
+				RID joint = physics_server->joint_create();
+				physics_server->joint_make_pin(joint, bodies[x * side + z], Vector3(0, 0, 0.5), bodies[x * side + z + 1], Vector3(0, 0, -0.5));
+				joints.push_back(joint);
+			}
+		}
+	}
+
+	// Pulling one corner has to be passed along the whole net.
+	physics_server->body_set_state(bodies[0], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(0, 5, 0));
+
+	physics_server->set_active(true);
+	for (int i = 0; i < 30; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	CHECK_MESSAGE(physics_server->get_space(space)->get_parallel_constraint_count() > 32, "Some joint colors should have been solved across the worker threads.");
+
+	real_t max_stretch = 0.0;
+	for (int x = 0; x < side; x++) {
+		for (int z = 0; z < side; z++) {
+			const Vector3 origin = Transform3D(physics_server->body_get_state(bodies[x * side + z], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+			if (x + 1 < side) {
+				const Vector3 next = Transform3D(physics_server->body_get_state(bodies[(x + 1) * side + z], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+				max_stretch = MAX(max_stretch, Math::abs(origin.distance_to(next) - 1.0));
+			}
+			if (z + 1 < side) {
+				const Vector3 next = Transform3D(physics_server->body_get_state(bodies[x * side + z + 1], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+				max_stretch = MAX(max_stretch, Math::abs(origin.distance_to(next) - 1.0));
+			}
+		}
+	}
+	CHECK_MESSAGE(max_stretch < 0.1, "The joints should keep the spheres at the same distance from each other.");
+	CHECK(Transform3D(physics_server->body_get_state(bodies[side * side - 1], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.y > 0.0);
+
+	for (const RID &joint : joints) {
+		physics_server->free(joint);
+	}
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(sphere);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Box resting on a concave floor keeps contacts spread under it") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	// A floor made of many small triangles, so the box gets far more contacts than a pair can keep.
+	PackedVector3Array faces;
+	for (int x = -4; x < 4; x++) {
+		for (int z = -4; z < 4; z++) {
+			const real_t cell = 0.25;
+			Vector3 corner(x * cell, 0, z * cell);
+			faces.push_back(corner);
+			faces.push_back(corner + Vector3(cell, 0, 0));
+			faces.push_back(corner + Vector3(cell, 0, cell));
+			faces.push_back(corner);
+			faces.push_back(corner + Vector3(cell, 0, cell));
+			faces.push_back(corner + Vector3(0, 0, cell));
+		}
+	}
+	Dictionary floor_data;
+	floor_data["faces"] = faces;
+	floor_data["backface_collision"] = true;
+	RID floor_shape = physics_server->concave_polygon_shape_create();
+	physics_server->shape_set_data(floor_shape, floor_data);
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID box = physics_server->box_shape_create();
+	physics_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID body = physics_server->body_create();
+	physics_server->body_add_shape(body, box);
+	physics_server->body_set_max_contacts_reported(body, 8);
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.1, 0.5, 0.1)));
+	physics_server->body_set_space(body, space);
+
+	physics_server->set_active(true);
+	for (int i = 0; i < 60; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	PhysicsDirectBodyState3D *state = physics_server->body_get_direct_state(body);
+	REQUIRE(state);
+
+	const Transform3D transform = state->get_transform();
+	CHECK_MESSAGE(Vector2(transform.origin.x - 0.1, transform.origin.z - 0.1).length() < 0.01, "The box shouldn't slide.");
+	CHECK(Math::abs(transform.origin.y - 0.5) < 0.05);
+	CHECK(transform.basis.get_column(1).dot(Vector3(0, 1, 0)) > 0.999);
+
+	const int contact_count = state->get_contact_count();
+	CHECK(contact_count >= 3);
+	CHECK(contact_count <= 4);
+
+	// The kept contacts should reach out to the corners of the box rather than bunch up under it.
+	AABB contact_bounds;
+	for (int i = 0; i < contact_count; i++) {
+		if (i == 0) {
+			contact_bounds.position = state->get_contact_local_position(i);
+		} else {
+			contact_bounds.expand_to(state->get_contact_local_position(i));
+		}
+	}
+	CHECK(contact_bounds.size.x > 0.8);
+	CHECK(contact_bounds.size.z > 0.8);
+
+	physics_server->free(body);
+	physics_server->free(box);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Rays against a concave mesh find the closest face") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	// Uneven terrain, large enough for the tree to be several levels deep.
+	RandomPCG rng(1234);
+	const int side = 48;
+	LocalVector<real_t> heights;
+	for (int i = 0; i < (side + 1) * (side + 1); i++) {
+		heights.push_back(rng.random((real_t)-1.0, (real_t)1.0));
+	}
+	PackedVector3Array faces;
+	for (int x = 0; x < side; x++) {
+		for (int z = 0; z < side; z++) {
+			Vector3 v00(x, heights[z * (side + 1) + x], z);
+			Vector3 v10(x + 1, heights[z * (side + 1) + x + 1], z);
+			Vector3 v01(x, heights[(z + 1) * (side + 1) + x], z + 1);
+			Vector3 v11(x + 1, heights[(z + 1) * (side + 1) + x + 1], z + 1);
+			faces.push_back(v00);
+			faces.push_back(v10);
+			faces.push_back(v11);
+			faces.push_back(v00);
+			faces.push_back(v11);
+			faces.push_back(v01);
+		}
+	}
+	Dictionary terrain_data;
+	terrain_data["faces"] = faces;
+	terrain_data["backface_collision"] = false;
+	RID terrain_shape = physics_server->concave_polygon_shape_create();
+	physics_server->shape_set_data(terrain_shape, terrain_data);
+	RID terrain = physics_server->body_create();
+	physics_server->body_set_mode(terrain, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(terrain, terrain_shape);
+	physics_server->body_set_space(terrain, space);
+
+	physics_server->set_active(true);
+	physics_server->step(1.0 / 60.0);
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	bool all_match = true;
+	int hit_count = 0;
+	for (int i = 0; i < 200; i++) {
+		// Slanted rays, some of which start or end outside of the terrain.
+		parameters.from = Vector3(rng.random((real_t)-4, (real_t)(side + 4)), 3, rng.random((real_t)-4, (real_t)(side + 4)));
+		parameters.to = Vector3(rng.random((real_t)-4, (real_t)(side + 4)), -3, rng.random((real_t)-4, (real_t)(side + 4)));
+
+		bool expected_hit = false;
+		real_t expected_distance = 1e20;
+		for (int j = 0; j < faces.size(); j += 3) {
+			Vector3 point;
+			if (Geometry3D::segment_intersects_triangle(parameters.from, parameters.to, faces[j], faces[j + 1], faces[j + 2], &point)) {
+				expected_hit = true;
+				expected_distance = MIN(expected_distance, parameters.from.distance_to(point));
+			}
+		}
+
+		PhysicsDirectSpaceState3D::RayResult result;
+		bool hit = space_state->intersect_ray(parameters, result);
+		all_match &= hit == expected_hit;
+		if (hit && expected_hit) {
+			all_match &= Math::abs(parameters.from.distance_to(result.position) - expected_distance) < 0.001;
+			hit_count++;
+		}
+	}
+	CHECK(hit_count > 0);
+	CHECK_MESSAGE(all_match, "Every ray should hit the same face as a brute force search.");
+
+	// Shapes hovering over the terrain only touch it when they reach down to it.
+	PhysicsDirectSpaceState3D::ShapeParameters shape_parameters;
+	RID sphere = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere, 0.25);
+	shape_parameters.shape_rid = sphere;
+	PhysicsDirectSpaceState3D::ShapeResult shape_result;
+	shape_parameters.transform = Transform3D(Basis(), Vector3(side / 2, 2, side / 2));
+	CHECK(space_state->intersect_shape(shape_parameters, &shape_result, 1) == 0);
+	shape_parameters.transform = Transform3D(Basis(), Vector3(side / 2, heights[(side / 2) * (side + 1) + side / 2], side / 2));
+	CHECK(space_state->intersect_shape(shape_parameters, &shape_result, 1) == 1);
+	shape_parameters.transform = Transform3D(Basis(), Vector3(side + 2, 0, side / 2));
+	CHECK(space_state->intersect_shape(shape_parameters, &shape_result, 1) == 0);
+
+	physics_server->free(sphere);
+	physics_server->free(terrain);
+	physics_server->free(terrain_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+// Binary tree of full precision bounds, the way concave polygon shapes were culled before they used a quantized four-wide tree.
+struct ReferenceBVH {
+	struct Node {
+		AABB aabb;
+		int left = -1;
+		int right = -1;
+		int face_index = -1;
+	};
+
+	struct Element {
+		AABB aabb;
+		Vector3 center;
+		int face_index = 0;
+	};
+
+	struct CompareAxis {
+		int axis = 0;
+		_FORCE_INLINE_ bool operator()(const Element &p_a, const Element &p_b) const {
+			return p_a.center[axis] < p_b.center[axis];
+		}
+	};
+
+	LocalVector<Node> nodes;
+
+	int build(Element *p_elements, int p_size) {
+		const int index = nodes.size();
+		nodes.push_back(Node());
+		if (p_size == 1) {
+			nodes[index].aabb = p_elements[0].aabb;
+			nodes[index].face_index = p_elements[0].face_index;
+			return index;
+		}
+
+		AABB aabb = p_elements[0].aabb;
+		for (int i = 1; i < p_size; i++) {
+			aabb.merge_with(p_elements[i].aabb);
+		}
+		nodes[index].aabb = aabb;
+
+		SortArray<Element, CompareAxis> sorter;
+		sorter.compare.axis = aabb.get_longest_axis_index();
+		sorter.sort(p_elements, p_size);
+
+		const int split = p_size / 2;
+		const int left = build(p_elements, split);
+		const int right = build(p_elements + split, p_size - split);
+		nodes[index].left = left;
+		nodes[index].right = right;
+		return index;
+	}
+
+	int cull(int p_index, const AABB &p_aabb) const {
+		const Node &node = nodes[p_index];
+		if (!p_aabb.intersects(node.aabb)) {
+			return 0;
+		}
+		if (node.face_index >= 0) {
+			return 1;
+		}
+		return cull(node.left, p_aabb) + cull(node.right, p_aabb);
+	}
+};
+
+static bool count_culled_face(void *p_userdata, GodotShape3D *p_convex) {
+	(*static_cast<int *>(p_userdata))++;
+	return false;
+}
+
+TEST_CASE("[Stress][PhysicsServer3D] Cull a large concave mesh") {
+	// Uneven terrain of 2 x 256 x 256 triangles.
+	RandomPCG rng(99);
+	const int side = 256;
+	LocalVector<real_t> heights;
+	for (int i = 0; i < (side + 1) * (side + 1); i++) {
+		heights.push_back(rng.random((real_t)-2.0, (real_t)2.0));
+	}
+	PackedVector3Array faces;
+	for (int x = 0; x < side; x++) {
+		for (int z = 0; z < side; z++) {
+			Vector3 v00(x, heights[z * (side + 1) + x], z);
+			Vector3 v10(x + 1, heights[z * (side + 1) + x + 1], z);
+			Vector3 v01(x, heights[(z + 1) * (side + 1) + x], z + 1);
+			Vector3 v11(x + 1, heights[(z + 1) * (side + 1) + x + 1], z + 1);
+			faces.push_back(v00);
+			faces.push_back(v10);
+			faces.push_back(v11);
+			faces.push_back(v00);
+			faces.push_back(v11);
+			faces.push_back(v01);
+		}
+	}
+	const int face_count = faces.size() / 3;
+
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+	GodotConcavePolygonShape3D shape;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	shape.set_data(data);
+	const uint64_t build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	LocalVector<ReferenceBVH::Element> elements;
+	elements.resize(face_count);
+	for (int i = 0; i < face_count; i++) {
+		elements[i].aabb = Face3(faces[i * 3 + 0], faces[i * 3 + 1], faces[i * 3 + 2]).get_aabb();
+		elements[i].center = elements[i].aabb.get_center();
+		elements[i].face_index = i;
+	}
+	ReferenceBVH reference;
+	begin = OS::get_singleton()->get_ticks_usec();
+	reference.build(elements.ptr(), face_count);
+	const uint64_t reference_build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Boxes from the size of a character to a few meters wide, as bodies and shape queries would use.
+	LocalVector<AABB> queries;
+	for (int i = 0; i < 100000; i++) {
+		Vector3 size(rng.random((real_t)0.5, (real_t)4.0), rng.random((real_t)0.5, (real_t)4.0), rng.random((real_t)0.5, (real_t)4.0));
+		Vector3 position(rng.random((real_t)-2.0, (real_t)side), rng.random((real_t)-3.0, (real_t)2.0), rng.random((real_t)-2.0, (real_t)side));
+		queries.push_back(AABB(position, size));
+	}
+
+	int culled = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (const AABB &query : queries) {
+		shape.cull(query, count_culled_face, &culled, false);
+	}
+	const uint64_t cull_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int reference_culled = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (const AABB &query : queries) {
+		reference_culled += reference.cull(0, query);
+	}
+	const uint64_t reference_cull_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const uint64_t memory = shape.bvh.size() * sizeof(GodotConcavePolygonShape3D::BVH);
+	const uint64_t reference_memory = reference.nodes.size() * sizeof(ReferenceBVH::Node);
+	MESSAGE("Quantized four-wide tree over ", face_count, " faces: ", shape.bvh.size(), " nodes, ", memory / 1024, " KiB, built in ", build_usec, " usec, 100000 culls in ", cull_usec, " usec.");
+	MESSAGE("Binary tree over ", face_count, " faces: ", reference.nodes.size(), " nodes, ", reference_memory / 1024, " KiB, built in ", reference_build_usec, " usec, 100000 culls in ", reference_cull_usec, " usec.");
+
+	CHECK(memory < reference_memory);
+	// Quantized bounds are rounded outwards, they can only let more faces through.
+	CHECK(reference_culled > 0);
+	CHECK(culled >= reference_culled);
+}
+
+// Shoots a small, fast box at a thin wall and returns where it ends up along the shot.
+static real_t shoot_through_thin_wall(bool p_continuous_cd) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID wall_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(wall_shape, Vector3(0.05, 2, 2));
+	RID wall = physics_server->body_create();
+	physics_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(wall, wall_shape);
+	physics_server->body_set_space(wall, space);
+
+	// Spinning and off center, so a ray from its center wouldn't be enough.
+	RID bullet_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(bullet_shape, Vector3(0.1, 0.02, 0.02));
+	RID bullet = physics_server->body_create();
+	physics_server->body_add_shape(bullet, bullet_shape);
+	physics_server->body_set_param(bullet, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	physics_server->body_set_enable_continuous_collision_detection(bullet, p_continuous_cd);
+	physics_server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(-3, 0.5, 0.3)));
+	physics_server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(150, 0, 0));
+	physics_server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0, 5, 0));
+	physics_server->body_set_space(bullet, space);
+
+	physics_server->set_active(true);
+	for (int i = 0; i < 30; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	PhysicsDirectBodyState3D *state = physics_server->body_get_direct_state(bullet);
+	real_t x = state ? state->get_transform().origin.x : 0.0;
+
+	physics_server->free(bullet);
+	physics_server->free(bullet_shape);
+	physics_server->free(wall);
+	physics_server->free(wall_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+
+	return x;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Continuous collision detection stops fast bodies at thin walls") {
+	// Each step moves the bullet 2.5 units, it would skip right over the wall.
+	CHECK(shoot_through_thin_wall(false) > 1.0);
+	CHECK_MESSAGE(shoot_through_thin_wall(true) < 0.0, "The bullet should stay in front of the wall.");
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Continuous collision detection against concave walls") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	// Two parallel walls, with nothing between them for bodies to hit.
+	PackedVector3Array faces;
+	for (real_t x : { (real_t)-6.0, (real_t)0.0 }) {
+		faces.push_back(Vector3(x, -2, -2));
+		faces.push_back(Vector3(x, 2, -2));
+		faces.push_back(Vector3(x, 2, 2));
+		faces.push_back(Vector3(x, -2, -2));
+		faces.push_back(Vector3(x, 2, 2));
+		faces.push_back(Vector3(x, -2, 2));
+	}
+	Dictionary wall_data;
+	wall_data["faces"] = faces;
+	wall_data["backface_collision"] = true;
+	RID wall_shape = physics_server->concave_polygon_shape_create();
+	physics_server->shape_set_data(wall_shape, wall_data);
+	RID wall = physics_server->body_create();
+	physics_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(wall, wall_shape);
+	physics_server->body_set_space(wall, space);
+
+	RID bullet_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(bullet_shape, Vector3(0.1, 0.02, 0.02));
+	LocalVector<RID> bullets;
+	// The first one is shot through a wall, the second one runs between the walls without hitting any face.
+	for (const Vector3 &start : { Vector3(-3, 0.5, 0.3), Vector3(-3, 0.5, -1.5) }) {
+		RID bullet = physics_server->body_create();
+		physics_server->body_add_shape(bullet, bullet_shape);
+		physics_server->body_set_param(bullet, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+		physics_server->body_set_enable_continuous_collision_detection(bullet, true);
+		physics_server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), start));
+		physics_server->body_set_space(bullet, space);
+		bullets.push_back(bullet);
+	}
+	physics_server->body_set_state(bullets[0], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(150, 0, 0));
+	physics_server->body_set_state(bullets[1], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(0, 0, 30));
+
+	physics_server->set_active(true);
+	for (int i = 0; i < 4; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	const Vector3 shot = Transform3D(physics_server->body_get_state(bullets[0], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+	const Vector3 run = Transform3D(physics_server->body_get_state(bullets[1], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+	CHECK_MESSAGE(shot.x < 0.0, "The bullet should stay in front of the wall.");
+	// 4 steps at 0.5 units per step, any slowdown would come from a hit found where there are no faces.
+	CHECK_MESSAGE(run.z > 0.4, "The bullet running between the walls shouldn't be slowed down.");
+
+	for (const RID &bullet : bullets) {
+		physics_server->free(bullet);
+	}
+	physics_server->free(bullet_shape);
+	physics_server->free(wall);
+	physics_server->free(wall_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+// Drops a pile of boxes and spheres, some of them pinned together, in deterministic mode.
+// The bodies are always created in the same order, but can be added to the space in reverse order.
+static void simulate_deterministic_pile(int p_task_count, bool p_reverse_order, int p_steps, LocalVector<Transform3D> &r_transforms) {
+	GodotPhysicsServer3D *physics_server = Object::cast_to<GodotPhysicsServer3D>(PhysicsServer3D::get_singleton());
+	REQUIRE(physics_server);
+	physics_server->set_step_task_count(p_task_count);
+
+	// Only read when the space is created. A low threshold gets the pile solved on several threads.
+	const Variant deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
+	const Variant threshold = GLOBAL_GET("physics/3d/solver/parallel_island_solve_threshold");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_solve_threshold", 16);
+	RID space = physics_server->space_create();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", deterministic);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_solve_threshold", threshold);
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(20, 1, 20));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape, Transform3D(Basis(), Vector3(0, -1, 0)));
+	physics_server->body_set_space(floor, space);
+
+	RID box = physics_server->box_shape_create();
+	physics_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID sphere = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere, 0.5);
+
+	RandomPCG rng(42);
+	LocalVector<RID> bodies;
+	for (int y = 0; y < 6; y++) {
+		for (int x = 0; x < 4; x++) {
+			for (int z = 0; z < 4; z++) {
+				RID body = physics_server->body_create();
+				physics_server->body_add_shape(body, (x + y + z) % 3 ? box : sphere);
+				Vector3 position(x * 1.2 + rng.random((real_t)-0.2, (real_t)0.2), 0.5 + y * 1.2, z * 1.2 + rng.random((real_t)-0.2, (real_t)0.2));
+				Basis rotation(Vector3(0, 1, 0), rng.random((real_t)0.0, (real_t)Math_TAU));
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(rotation, position));
+				bodies.push_back(body);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		physics_server->body_set_space(bodies[p_reverse_order ? bodies.size() - 1 - i : i], space);
+	}
+
+	// A few chains along the bottom rows.
+	LocalVector<RID> joints;
+	for (uint32_t i = 0; i + 1 < 16; i += 2) {
+		RID joint = physics_server->joint_create();
+		physics_server->joint_make_pin(joint, bodies[i], Vector3(0, 0, 0.6), bodies[i + 1], Vector3(0, 0, -0.6));
+		joints.push_back(joint);
+	}
+
+	physics_server->set_active(true);
+	for (int i = 0; i < p_steps; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	r_transforms.clear();
+	for (const RID &joint : joints) {
+		physics_server->free(joint);
+	}
+	for (const RID &body : bodies) {
+		r_transforms.push_back(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		physics_server->free(body);
+	}
+	physics_server->free(box);
+	physics_server->free(sphere);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+	physics_server->set_step_task_count(-1);
+}
+
+TEST_CASE("[PhysicsServer3D] Body state follows bodies between spaces") {
+	GodotPhysicsServer3D *physics_server = Object::cast_to<GodotPhysicsServer3D>(PhysicsServer3D::get_singleton());
+	REQUIRE(physics_server);
+
+	RID space_a = physics_server->space_create();
+	RID space_b = physics_server->space_create();
+	// Each space starts with its static global body.
+	GodotBodyStates3D &states_a = physics_server->get_space(space_a)->get_body_states();
+	GodotBodyStates3D &states_b = physics_server->get_space(space_b)->get_body_states();
+	REQUIRE(states_a.linear_velocity.size() == 1);
+
+	RID body = physics_server->body_create();
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 2, 3));
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0, 1, 0));
+
+	physics_server->body_set_space(body, space_a);
+	CHECK(states_a.linear_velocity.size() == 2);
+	CHECK(Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3(1, 2, 3));
+
+	physics_server->body_set_space(body, space_b);
+	CHECK(states_b.linear_velocity.size() == 2);
+	CHECK(Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3(1, 2, 3));
+	CHECK(Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)) == Vector3(0, 1, 0));
+
+	physics_server->body_set_space(body, RID());
+	CHECK(Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3(1, 2, 3));
+
+	// Slots freed by other bodies are reused.
+	RID other_body = physics_server->body_create();
+	physics_server->body_set_space(body, space_a);
+	physics_server->body_set_space(other_body, space_a);
+	physics_server->body_set_state(other_body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(4, 5, 6));
+	physics_server->free(other_body);
+	RID new_body = physics_server->body_create();
+	physics_server->body_set_space(new_body, space_a);
+	CHECK(states_a.linear_velocity.size() == 3);
+	CHECK(Vector3(physics_server->body_get_state(new_body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3());
+	CHECK(Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3(1, 2, 3));
+
+	physics_server->free(new_body);
+	physics_server->free(body);
+	physics_server->free(space_b);
+	physics_server->free(space_a);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Deterministic mode steps to bit-identical transforms") {
+	// A single task per stage steps everything in order on one thread.
+	LocalVector<Transform3D> reference;
+	simulate_deterministic_pile(1, false, 90, reference);
+
+	// Spread across all the worker threads, which pick up the work in a different order.
+	LocalVector<Transform3D> threaded;
+	simulate_deterministic_pile(-1, false, 90, threaded);
+
+	LocalVector<Transform3D> reversed;
+	simulate_deterministic_pile(-1, true, 90, reversed);
+
+	REQUIRE(threaded.size() == reference.size());
+	REQUIRE(reversed.size() == reference.size());
+	bool moved = false;
+	bool threaded_identical = true;
+	bool reversed_identical = true;
+	for (uint32_t i = 0; i < reference.size(); i++) {
+		// Exact comparison on purpose, not even rounding errors are expected.
+		threaded_identical &= threaded[i] == reference[i];
+		reversed_identical &= reversed[i] == reference[i];
+		moved |= reference[i].origin.y < 0.5 + (i / 16) * 1.2 - 0.1;
+	}
+	CHECK_MESSAGE(moved, "The pile should have settled.");
+	CHECK_MESSAGE(threaded_identical, "Stepping on all the worker threads should give the same results as on a single one.");
+	CHECK_MESSAGE(reversed_identical, "Adding the bodies in a different order should give the same results.");
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Restoring a space snapshot resimulates the same steps") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	// Pairs found again after restoring aren't in the same order, solving has to not depend on it.
+	const Variant deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+	RID space = physics_server->space_create();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", deterministic);
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(10, 1, 10));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape, Transform3D(Basis(), Vector3(0, -1, 0)));
+	physics_server->body_set_space(floor, space);
+
+	RID box = physics_server->box_shape_create();
+	physics_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+
+	RandomPCG rng(7);
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 24; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_add_shape(body, box);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+		Basis rotation(Vector3(0, 1, 0), rng.random((real_t)0.0, (real_t)Math_TAU));
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(rotation, Vector3(rng.random((real_t)-2.0, (real_t)2.0), 0.5 + i * 0.8, rng.random((real_t)-2.0, (real_t)2.0))));
+		physics_server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	physics_server->set_active(true);
+	for (int i = 0; i < 40; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	PackedByteArray snapshot;
+	physics_server->space_save_snapshot(space, snapshot);
+	CHECK(snapshot.size() > 0);
+
+	LocalVector<Transform3D> first_run;
+	for (int i = 0; i < 40; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	for (const RID &body : bodies) {
+		first_run.push_back(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+	}
+
+	REQUIRE(physics_server->space_restore_snapshot(space, snapshot));
+	for (int i = 0; i < 40; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	bool identical = true;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		identical &= Transform3D(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM)) == first_run[i];
+	}
+	CHECK_MESSAGE(identical, "Resimulating from the snapshot should give the exact same transforms.");
+
+	// Saving after resimulating works the same way.
+	PackedByteArray second_snapshot;
+	physics_server->space_save_snapshot(space, second_snapshot);
+	CHECK(second_snapshot.size() > 0);
+
+	// A snapshot doesn't apply anymore once bodies are added.
+	RID extra_body = physics_server->body_create();
+	physics_server->body_add_shape(extra_body, box);
+	physics_server->body_set_space(extra_body, space);
+	ERR_PRINT_OFF;
+	CHECK_FALSE(physics_server->space_restore_snapshot(space, snapshot));
+	ERR_PRINT_ON;
+
+	physics_server->free(extra_body);
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->set_active(false);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
@@ -48,8 +48,11 @@
 #include "tests/core/io/test_xml_parser.h"
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
+#include "tests/core/math/test_astar_grid_2d.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
+#include "tests/core/math/test_disjoint_set.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
 #include "tests/core/math/test_geometry_3d.h"
@@ -89,6 +92,7 @@
 #include "tests/core/test_time.h"
 #include "tests/core/threads/test_worker_thread_pool.h"
 #include "tests/core/variant/test_array.h"
+#include "tests/core/variant/test_callable.h"
 #include "tests/core/variant/test_dictionary.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
@@ -110,6 +114,7 @@
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
+#include "tests/servers/test_physics_server_2d.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
@@ -134,6 +139,7 @@
 #include "tests/scene/test_arraymesh.h"
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_primitives.h"
+#include "tests/servers/test_physics_server_3d.h"
 #endif // _3D_DISABLED
 
 #include "modules/modules_tests.gen.h"